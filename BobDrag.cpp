@@ -0,0 +1,58 @@
+#include "BobDrag.h"
+
+// Начало перетаскивания из текущего положения груза
+void BobDrag::start(double coordinate, quint64 timestampMs)
+{
+    samples.clear();
+    active = true;
+    addSample(coordinate, timestampMs);
+}
+
+// Новое положение; отсчеты старше окна оценки скорости отбрасываются
+void BobDrag::addSample(double coordinate, quint64 timestampMs)
+{
+    if (!active) {
+        return;
+    }
+    samples.push_back({timestampMs, coordinate});
+    while (samples.front().time + VELOCITY_WINDOW_MS < timestampMs) {
+        samples.pop_front();
+    }
+}
+
+void BobDrag::stop()
+{
+    active = false;
+    samples.clear();
+}
+
+bool BobDrag::isActive() const
+{
+    return active;
+}
+
+// Наклон прямой наименьших квадратов через отсчеты окна. Время
+// отсчитывается от последнего события, чтобы суммы не теряли точность.
+double BobDrag::velocity() const
+{
+    if (samples.size() < 2) {
+        return 0.0;
+    }
+
+    const quint64 last = samples.back().time;
+    double sumT = 0.0, sumX = 0.0, sumTT = 0.0, sumTX = 0.0;
+    for (const Sample &sample : samples) {
+        double t = -static_cast<double>(last - sample.time) * 1e-3;
+        sumT += t;
+        sumX += sample.coordinate;
+        sumTT += t * t;
+        sumTX += t * sample.coordinate;
+    }
+    const double n = static_cast<double>(samples.size());
+    const double denominator = n * sumTT - sumT * sumT;
+    // Все события с одной меткой времени: скорость не определена
+    if (denominator <= 0.0) {
+        return 0.0;
+    }
+    return (n * sumTX - sumT * sumX) / denominator;
+}
@@ -0,0 +1,47 @@
+#ifndef BOBDRAG_H
+#define BOBDRAG_H
+
+#include <QMouseEvent>
+#include <QtGlobal>
+#include <deque>
+
+// Перетаскивание груза указателем (мышь или касание). Экран сам переводит
+// положение указателя в координату груза (угол, смещение) и передает ее
+// сюда вместе с временем события. Скорость оценивается наклоном прямой,
+// проведенной методом наименьших квадратов через положения за последние
+// VELOCITY_WINDOW_MS: дрожание руки не дает выброса скорости, а остановка
+// перед отпусканием дает нулевую скорость.
+class BobDrag
+{
+public:
+    void start(double coordinate, quint64 timestampMs);
+    void addSample(double coordinate, quint64 timestampMs);
+    void stop();
+    bool isActive() const;
+
+    // Скорость координаты (единиц в секунду) на момент последнего события
+    double velocity() const;
+
+private:
+    struct Sample {
+        quint64 time;
+        double coordinate;
+    };
+
+    static constexpr quint64 VELOCITY_WINDOW_MS = 50;
+
+    std::deque<Sample> samples;
+    bool active = false;
+};
+
+// Положение указателя в координатах виджета с дробной частью (Qt 5 и 6)
+inline QPointF pointerPosition(const QMouseEvent *event)
+{
+#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
+    return event->position();
+#else
+    return event->localPos();
+#endif
+}
+
+#endif
@@ -0,0 +1,82 @@
+#include "ComparisonModel.h"
+#include <algorithm>
+#include <cmath>
+
+const ComparisonVariant COMPARISON_VARIANTS[COMPARISON_VARIANT_COUNT] = {
+    {"Nonlinear", false, false},
+    {"Linearised", true, false},
+    {"Linear drag", false, true},
+    {"Runge-Kutta 4", false, false},
+    {"Explicit Euler", false, false},
+};
+
+// Все варианты стартуют из одного состояния; масса единичная, поэтому
+// энергии — удельные
+ComparisonModel::ComparisonModel(double gravity, double length, double angle, double dragCoeff)
+{
+    std::apply([&](auto &... kernel) {
+        ((kernel.gravity = gravity, kernel.length = length, kernel.mass = 1.0), ...);
+    }, kernels);
+    std::get<DAMPED_VARIANT>(kernels).damping.template term<LinearDrag>().coeff = dragCoeff;
+
+    for (int i = 0; i < COMPARISON_VARIANT_COUNT; ++i) {
+        states[i].angle = angle;
+        previousStates[i] = states[i];
+    }
+}
+
+void ComparisonModel::advance(long steps, double dt)
+{
+    if (dt != stepSize) {
+        analyzer.reset(dt);
+        stepSize = dt;
+    }
+    for (long i = 0; i < steps; ++i) {
+        if (i + 1 == steps) {
+            std::copy(states, states + COMPARISON_VARIANT_COUNT, previousStates);
+        }
+        step(dt, std::make_index_sequence<COMPARISON_VARIANT_COUNT>());
+        analyzer.addSample(stateCoordinate(states[0]));
+    }
+    stepCount += steps;
+}
+
+// Один шаг всех вариантов
+template <std::size_t... Index>
+void ComparisonModel::step(double dt, std::index_sequence<Index...>)
+{
+    (std::get<Index>(kernels).step(states[Index], dt), ...);
+}
+
+void ComparisonModel::writeSnapshot(PhysicsSnapshot &snapshot) const
+{
+    snapshot.step = stepCount;
+    snapshot.simulatedTime = stepCount * stepSize;
+    snapshot.stepSize = stepSize;
+    for (int i = 0; i < COMPARISON_VARIANT_COUNT; ++i) {
+        writeState(states[i], snapshot.state + 2 * i);
+        writeState(previousStates[i], snapshot.previousState + 2 * i);
+    }
+    snapshot.dissipatedEnergy = states[DAMPED_VARIANT].dissipatedEnergy;
+    snapshot.stuckByFriction = false;
+    snapshot.spectrum = analyzer.estimate();
+}
+
+std::unique_ptr<PhysicsModel> ComparisonModel::clone() const
+{
+    return std::make_unique<ComparisonModel>(*this);
+}
+
+// Энергия в единицах снимка (градусы); у линеаризованного варианта
+// потенциальная энергия тоже квадратичная
+double ComparisonModel::variantEnergy(int variant, double gravity, double length,
+                                      double angle, double angularVelocity)
+{
+    const double degToRad = PhysicsConstants<double>::degToRad();
+    const double angleRad = angle * degToRad;
+    const double speed = angularVelocity * degToRad * length;
+    const double height = COMPARISON_VARIANTS[variant].linearised
+        ? 0.5 * length * angleRad * angleRad
+        : length * (1.0 - std::cos(angleRad));
+    return 0.5 * speed * speed + gravity * height;
+}
@@ -0,0 +1,71 @@
+#ifndef COMPARISONMODEL_H
+#define COMPARISONMODEL_H
+
+#include <tuple>
+#include <utility>
+#include "PhysicsModel.h"
+
+// Вариант одного и того же математического маятника. Описание нужно
+// интерфейсу; сами варианты — ядра ComparisonModel::Kernels.
+struct ComparisonVariant {
+    const char *name;
+    bool linearised;      // sin θ ≈ θ
+    bool damped;          // линейное сопротивление
+};
+
+// Первый вариант — эталон, с которым сравниваются остальные
+constexpr int COMPARISON_VARIANT_COUNT = 5;
+extern const ComparisonVariant COMPARISON_VARIANTS[COMPARISON_VARIANT_COUNT];
+
+static_assert(2 * COMPARISON_VARIANT_COUNT <= PHYSICS_STATE_SIZE,
+              "Snapshot must hold angle and velocity of every variant");
+
+// Каждый вариант — ядро MathPendulumKernel со своими методом
+// интегрирования, сопротивлением и линеаризацией, поэтому уравнения,
+// единицы и ограничение угла ±90° у всех те же, что в приложении.
+// Варианты шагают вместе, с общим шагом и общим счетчиком шагов; их
+// состояния лежат подряд в одном массиве. В снимке вариант i занимает
+// компоненты 2i (угол, градусы) и 2i + 1 (угловая скорость, градусы/с).
+// dissipatedEnergy снимка — энергия, рассеянная вариантом с
+// сопротивлением (Дж/кг); остальные варианты консервативны.
+class ComparisonModel : public PhysicsModel
+{
+public:
+    ComparisonModel(double gravity, double length, double angle, double dragCoeff);
+
+    void advance(long steps, double dt) override;
+    void writeSnapshot(PhysicsSnapshot &snapshot) const override;
+    std::unique_ptr<PhysicsModel> clone() const override;
+
+    // Удельная энергия варианта в его собственной модели (Дж/кг), для
+    // оценки дрейфа энергии методом интегрирования
+    static double variantEnergy(int variant, double gravity, double length,
+                                double angle, double angularVelocity);
+
+private:
+    using State = MathPendulumState<DoublePrecision>;
+    using Conservative = DampingModel<double>;
+    // Ядра в порядке COMPARISON_VARIANTS
+    using Kernels = std::tuple<
+        MathPendulumKernel<DoublePrecision, Conservative>,
+        MathPendulumKernel<DoublePrecision, Conservative, SemiImplicitEuler, true>,
+        MathPendulumKernel<DoublePrecision, DampingModel<double, LinearDrag>>,
+        MathPendulumKernel<DoublePrecision, Conservative, RungeKutta4>,
+        MathPendulumKernel<DoublePrecision, Conservative, ExplicitEuler>>;
+    static_assert(std::tuple_size_v<Kernels> == COMPARISON_VARIANT_COUNT,
+                  "Every variant needs a kernel");
+    static constexpr int DAMPED_VARIANT = 2;
+
+    template <std::size_t... Index>
+    void step(double dt, std::index_sequence<Index...>);
+
+    Kernels kernels;
+    State states[COMPARISON_VARIANT_COUNT];
+    State previousStates[COMPARISON_VARIANT_COUNT];
+
+    long long stepCount = 0;
+    double stepSize = 0.0;
+    SpectralAnalyzer analyzer;
+};
+
+#endif
@@ -0,0 +1,269 @@
+#include "ComparisonView.h"
+#include "ui_ComparisonView.h"
+#include "FrameScheduler.h"
+#include "PhysicsWorker.h"
+#include "SimulationControlBar.h"
+#include <QMenu>
+#include <QPainter>
+#include <QVBoxLayout>
+#include <cmath>
+#include <QMessageBox>
+
+namespace {
+
+// Цвета вариантов; эталон — синий, как в MathPendulum
+const QColor VARIANT_COLORS[COMPARISON_VARIANT_COUNT] = {
+    QColor(Qt::blue),
+    QColor(230, 120, 20),
+    QColor(40, 160, 60),
+    QColor(150, 60, 200),
+    QColor(210, 40, 40),
+};
+
+}
+
+// Конструктор: параметры маятника передаются с экрана MathPendulum
+ComparisonView::ComparisonView(double length, double angle, double dragCoeff, QWidget *parent) :
+    QWidget(parent), ui(new Ui::ComparisonView),
+    lengthForCalculations(length), initialAngle(angle), dragCoeff(dragCoeff)
+{
+    ui->setupUi(this);
+    this->showFullScreen();
+
+    // Настройка меню
+    menuBar = new QMenuBar(this);
+    QMenu *fileMenu = menuBar->addMenu("Functions");
+    QAction *startAction = new QAction("Start", this);
+    startAction->setObjectName("actionStart");
+    QAction *pauseAction = new QAction("Pause", this);
+    pauseAction->setObjectName("actionPause");
+    QAction *resetAction = new QAction("Reset", this);
+    resetAction->setObjectName("actionReset");
+    QAction *exitAction = new QAction("Exit", this);
+    exitAction->setObjectName("actionExit");
+    fileMenu->addAction(startAction);
+    fileMenu->addAction(pauseAction);
+    fileMenu->addAction(resetAction);
+    fileMenu->addSeparator();
+    fileMenu->addAction(exitAction);
+
+    connect(startAction, &QAction::triggered, this, &ComparisonView::on_actionStart_triggered);
+    connect(pauseAction, &QAction::triggered, this, &ComparisonView::on_actionPause_triggered);
+    connect(resetAction, &QAction::triggered, this, &ComparisonView::on_actionReset_triggered);
+    connect(exitAction, &QAction::triggered, this, &ComparisonView::on_actionExit_triggered);
+
+    variantNames[0] = ui->VariantName_1;
+    variantNames[1] = ui->VariantName_2;
+    variantNames[2] = ui->VariantName_3;
+    variantNames[3] = ui->VariantName_4;
+    variantNames[4] = ui->VariantName_5;
+    divergenceOutputs[0] = ui->OutputDivergenceValue_1;
+    divergenceOutputs[1] = ui->OutputDivergenceValue_2;
+    divergenceOutputs[2] = ui->OutputDivergenceValue_3;
+    divergenceOutputs[3] = ui->OutputDivergenceValue_4;
+    divergenceOutputs[4] = ui->OutputDivergenceValue_5;
+    energyDriftOutputs[0] = ui->OutputEnergyDriftValue_1;
+    energyDriftOutputs[1] = ui->OutputEnergyDriftValue_2;
+    energyDriftOutputs[2] = ui->OutputEnergyDriftValue_3;
+    energyDriftOutputs[3] = ui->OutputEnergyDriftValue_4;
+    energyDriftOutputs[4] = ui->OutputEnergyDriftValue_5;
+
+    // Видимость вариантов; считаются все, скрытые только не рисуются
+    QMenu *variantsMenu = menuBar->addMenu("Variants");
+    for (int i = 0; i < COMPARISON_VARIANT_COUNT; ++i) {
+        variantVisible[i] = true;
+        variantNames[i]->setText(COMPARISON_VARIANTS[i].name);
+        variantNames[i]->setStyleSheet(QString("color: %1").arg(VARIANT_COLORS[i].name()));
+
+        QAction *variantAction = new QAction(COMPARISON_VARIANTS[i].name, this);
+        variantAction->setObjectName(QString("actionVariant%1").arg(i + 1));
+        variantAction->setCheckable(true);
+        variantAction->setChecked(true);
+        variantsMenu->addAction(variantAction);
+        connect(variantAction, &QAction::toggled, this, [this, i](bool checked) {
+            variantVisible[i] = checked;
+            update();
+        });
+    }
+
+    QVBoxLayout *layout = new QVBoxLayout(this);
+    layout->setMenuBar(menuBar);
+
+    frameScheduler = new FrameScheduler(this);
+    connect(frameScheduler, &FrameScheduler::frame, this, &ComparisonView::updateAnimation);
+    physicsWorker = new PhysicsWorker(this);
+    connect(physicsWorker, &PhysicsWorker::seekFinished, this, &ComparisonView::on_physicsWorker_seekFinished);
+
+    controlBar = new SimulationControlBar(this);
+    menuBar->setCornerWidget(controlBar);
+    connect(controlBar, &SimulationControlBar::timeScaleChanged, this, &ComparisonView::on_controlBar_timeScaleChanged);
+    connect(controlBar, &SimulationControlBar::seekRequested, this, &ComparisonView::on_controlBar_seekRequested);
+    labelClock.start();
+
+    resetState();
+}
+
+// Деструктор класса
+ComparisonView::~ComparisonView() {
+    delete ui;
+}
+
+// Все варианты в начальном положении
+void ComparisonView::resetState() {
+    for (int i = 0; i < COMPARISON_VARIANT_COUNT; ++i) {
+        angles[i] = initialAngle;
+        angularVelocities[i] = 0.0;
+        initialEnergies[i] = ComparisonModel::variantEnergy(i, gravity, lengthForCalculations, initialAngle, 0.0);
+        divergenceOutputs[i]->clear();
+        energyDriftOutputs[i]->clear();
+    }
+}
+
+// Все варианты рисуются за один проход от общего подвеса; эталон — поверх
+void ComparisonView::paintEvent(QPaintEvent *pEvent) {
+    QWidget::paintEvent(pEvent);
+    QPainter painter(this);
+    painter.setRenderHint(QPainter::Antialiasing);
+
+    QPointF pivot(width() / 2.0, height() / 6.0);
+    const double pendulumLength = height() * 0.55;
+    const double bobRadius = 16.0;
+
+    painter.setPen(Qt::blue);
+    painter.drawLine(pivot - QPointF(10, 0), pivot + QPointF(10, 0));
+
+    for (int i = COMPARISON_VARIANT_COUNT - 1; i >= 0; --i) {
+        if (!variantVisible[i]) {
+            continue;
+        }
+        double angleRad = angles[i] * M_PI / 180.0;
+        QPointF bob(pivot.x() + pendulumLength * sin(angleRad), pivot.y() + pendulumLength * cos(angleRad));
+        QColor color = VARIANT_COLORS[i];
+        painter.setPen(color);
+        color.setAlpha(60);
+        painter.setBrush(color);
+        painter.drawLine(pivot, bob);
+        painter.drawEllipse(bob, bobRadius, bobRadius);
+    }
+}
+
+// Запуск анимации
+void ComparisonView::startAnimation() {
+    if (frameScheduler->isActive()) {
+        return;
+    }
+
+    if (isPaused) {
+        physicsWorker->resumeSimulation();
+        frameScheduler->start();
+        isPaused = false;
+        return;
+    }
+
+    if (qFuzzyIsNull(initialAngle)) {
+        QMessageBox::warning(this, "Error", "Please enter angle value on the mathematical pendulum screen first!");
+        return;
+    }
+
+    resetState();
+    physicsWorker->startSimulation(
+        std::make_unique<ComparisonModel>(gravity, lengthForCalculations, initialAngle, dragCoeff),
+        simulationStep());
+    frameScheduler->start();
+}
+
+// Шаг не крупнее периода / STEPS_PER_PERIOD, общий для всех вариантов
+double ComparisonView::simulationStep() const {
+    double period = 2 * M_PI * sqrt(lengthForCalculations / gravity);
+    return qMin(SIMULATION_STEP, period / STEPS_PER_PERIOD);
+}
+
+// Обновление анимации (вызывается на каждом кадре)
+void ComparisonView::updateAnimation(double) {
+    const PhysicsSnapshot &snapshot = physicsWorker->latestSnapshot();
+    const double displayTime = physicsWorker->simulatedTimeNow();
+    for (int i = 0; i < COMPARISON_VARIANT_COUNT; ++i) {
+        angles[i] = interpolateState(snapshot, 2 * i, displayTime);
+        angularVelocities[i] = interpolateState(snapshot, 2 * i + 1, displayTime);
+    }
+
+    update();
+
+    if (controlBar->timeScale() <= 1.0 || labelClock.hasExpired(LABEL_UPDATE_INTERVAL_MS)) {
+        updateOutputValues();
+        controlBar->setTimeline(qMin(displayTime, snapshot.simulatedTime), physicsWorker->recordedTime());
+        labelClock.restart();
+    }
+}
+
+// Расхождение угла с эталоном и относительное изменение энергии каждого
+// варианта. У варианта с сопротивлением убыль энергии — рассеяние, а не
+// ошибка метода, поэтому она подписана отдельно.
+void ComparisonView::updateOutputValues() {
+    for (int i = 0; i < COMPARISON_VARIANT_COUNT; ++i) {
+        double divergence = fabs(angles[i] - angles[0]);
+        double energy = ComparisonModel::variantEnergy(i, gravity, lengthForCalculations,
+                                                       angles[i], angularVelocities[i]);
+        double change = initialEnergies[i] > 0.0 ? (energy - initialEnergies[i]) / initialEnergies[i] : 0.0;
+        divergenceOutputs[i]->setText(i == 0 ? QString("reference") : QString::number(divergence, 'f', 4));
+        if (COMPARISON_VARIANTS[i].damped) {
+            energyDriftOutputs[i]->setText("dissipation " + QString::number(-change, 'e', 3));
+        } else {
+            energyDriftOutputs[i]->setText(QString::number(change, 'e', 3));
+        }
+    }
+}
+
+// Обработчики событий меню
+void ComparisonView::on_actionStart_triggered() {
+    startAnimation();
+}
+
+void ComparisonView::on_actionPause_triggered() {
+    if (frameScheduler->isActive()) {
+        physicsWorker->pauseSimulation();
+        frameScheduler->stop();
+        isPaused = true;
+    } else if (isPaused) {
+        physicsWorker->resumeSimulation();
+        frameScheduler->start();
+        isPaused = false;
+    }
+}
+
+void ComparisonView::on_actionReset_triggered() {
+    physicsWorker->stopSimulation();
+    frameScheduler->stop();
+    isPaused = false;
+    resetState();
+    controlBar->setTimeScale(1.0);
+    controlBar->setTimeline(0.0, 0.0);
+    update();
+}
+
+void ComparisonView::on_controlBar_timeScaleChanged(double scale) {
+    physicsWorker->setTimeScale(scale);
+}
+
+// Перемотка по шкале времени
+void ComparisonView::on_controlBar_seekRequested(double time) {
+    physicsWorker->seek(time);
+}
+
+// Результат перемотки на паузе; во время анимации его покажет очередной кадр
+void ComparisonView::on_physicsWorker_seekFinished() {
+    if (frameScheduler->isActive()) {
+        return;
+    }
+    updateAnimation(0.0);
+}
+
+void ComparisonView::on_actionExit_triggered()
+{
+    physicsWorker->stopSimulation();
+    if (frameScheduler->isActive()) {
+        frameScheduler->stop();
+    }
+
+    this->close();
+}
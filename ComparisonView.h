@@ -0,0 +1,78 @@
+#ifndef COMPARISONVIEW_H
+#define COMPARISONVIEW_H
+
+#include <QWidget>
+#include <QMenuBar>
+#include <QElapsedTimer>
+#include <QAction>
+#include <QLabel>
+#include <QTextBrowser>
+#include "ComparisonModel.h"
+
+class FrameScheduler;
+class PhysicsWorker;
+class SimulationControlBar;
+
+namespace Ui {
+class ComparisonView;
+}
+
+// Сравнение вариантов одного маятника: линеаризованный и нелинейный,
+// с сопротивлением и без, разные методы интегрирования. Все варианты
+// считаются одной моделью в одном потоке физики и рисуются за один проход
+// отрисовки поверх друг друга, с расхождением от эталона.
+class ComparisonView : public QWidget {
+    Q_OBJECT
+
+public:
+    ComparisonView(double length, double angle, double dragCoeff, QWidget *parent = nullptr);
+    ~ComparisonView();
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+
+private:
+    Ui::ComparisonView *ui;
+    QMenuBar *menuBar;
+    FrameScheduler *frameScheduler;
+    PhysicsWorker *physicsWorker;
+    SimulationControlBar *controlBar;
+    QElapsedTimer labelClock;
+    QLabel *variantNames[COMPARISON_VARIANT_COUNT];
+    QTextBrowser *divergenceOutputs[COMPARISON_VARIANT_COUNT];
+    QTextBrowser *energyDriftOutputs[COMPARISON_VARIANT_COUNT];
+
+    // Параметры маятника (из MathPendulum)
+    double lengthForCalculations = 10.0;
+    double initialAngle = 0.0;
+    double dragCoeff = 0.0;
+
+    // Текущее состояние вариантов (градусы, градусы/с)
+    double angles[COMPARISON_VARIANT_COUNT] = {};
+    double angularVelocities[COMPARISON_VARIANT_COUNT] = {};
+    double initialEnergies[COMPARISON_VARIANT_COUNT] = {};
+    bool variantVisible[COMPARISON_VARIANT_COUNT] = {};
+    bool isPaused = false;
+
+    const double gravity = 9.81;
+    const double STEPS_PER_PERIOD = 400.0;
+    const int LABEL_UPDATE_INTERVAL_MS = 100;
+
+    double simulationStep() const;
+    void resetState();
+    void startAnimation();
+    void updateOutputValues();
+
+private slots:
+    void on_actionStart_triggered();
+    void on_actionPause_triggered();
+    void on_actionReset_triggered();
+    void on_actionExit_triggered();
+    void on_controlBar_timeScaleChanged(double scale);
+    void on_controlBar_seekRequested(double time);
+    void on_physicsWorker_seekFinished();
+
+    void updateAnimation(double elapsedSeconds);
+};
+
+#endif
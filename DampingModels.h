@@ -0,0 +1,187 @@
+#ifndef DAMPINGMODELS_H
+#define DAMPINGMODELS_H
+
+#include <cmath>
+#include <tuple>
+#include <utility>
+
+// Модели сопротивления, собираемые в ядро шага на этапе компиляции.
+// Каждое слагаемое задает обобщенную силу в единицах скорости своей модели:
+// для математического маятника — угловое ускорение (град/с²) при скорости
+// в град/с, для пружинного — силу в ньютонах при скорости в м/с.
+// Пустая модель DampingModel<Scalar> не добавляет в шаг ни одной операции.
+
+// Настройки сопротивления, выбираемые пользователем
+struct DampingSettings {
+    bool linearEnabled = false;
+    double linearCoeff = 0.0;       // F = -c·v
+    bool quadraticEnabled = false;
+    double quadraticCoeff = 0.0;    // F = -q·v·|v|
+    bool dryEnabled = false;
+    double dryLevel = 0.0;          // F = -μ·sign(v), трение покоя той же величины
+
+    bool anyEnabled() const { return linearEnabled || quadraticEnabled || dryEnabled; }
+};
+
+// Линейное (вязкое) сопротивление воздуха
+template <typename Scalar>
+struct LinearDrag {
+    static constexpr bool isDry = false;
+    Scalar coeff = Scalar(0);
+
+    void configure(const DampingSettings &settings) { coeff = Scalar(settings.linearCoeff); }
+    Scalar force(const Scalar &velocity) const { return -coeff * velocity; }
+    Scalar level() const { return Scalar(0); }
+};
+
+// Квадратичное сопротивление воздуха
+template <typename Scalar>
+struct QuadraticDrag {
+    static constexpr bool isDry = false;
+    Scalar coeff = Scalar(0);
+
+    void configure(const DampingSettings &settings) { coeff = Scalar(settings.quadraticCoeff); }
+    Scalar force(const Scalar &velocity) const {
+        using std::fabs;
+        return -coeff * velocity * fabs(velocity);
+    }
+    Scalar level() const { return Scalar(0); }
+};
+
+// Сухое (кулоново) трение в подвесе. Разрывную силу не интегрируют
+// напрямую: ядро обрабатывает остановку и залипание как события.
+template <typename Scalar>
+struct CoulombFriction {
+    static constexpr bool isDry = true;
+    Scalar frictionLevel = Scalar(0);
+
+    void configure(const DampingSettings &settings) { frictionLevel = Scalar(settings.dryLevel); }
+    Scalar force(const Scalar &) const { return Scalar(0); }
+    Scalar level() const { return frictionLevel; }
+};
+
+template <typename Scalar, template <typename> class... Terms>
+struct DampingModel {
+    std::tuple<Terms<Scalar>...> terms;
+
+    static constexpr bool isEmpty = sizeof...(Terms) == 0;
+    static constexpr bool hasDryFriction = (false || ... || Terms<Scalar>::isDry);
+
+    template <template <typename> class Term>
+    Term<Scalar> &term() { return std::get<Term<Scalar>>(terms); }
+
+    void configure(const DampingSettings &settings) {
+        std::apply([&](auto &... term) { (term.configure(settings), ...); }, terms);
+    }
+
+    // Сумма гладких (вязких) слагаемых
+    Scalar viscousForce(const Scalar &velocity) const {
+        return std::apply([&](const auto &... term) { return (Scalar(0) + ... + term.force(velocity)); },
+                          terms);
+    }
+
+    // Величина сухого трения
+    Scalar dryLevel() const {
+        return std::apply([](const auto &... term) { return (Scalar(0) + ... + term.level()); }, terms);
+    }
+};
+
+// Вызов function(model) с моделью, собранной из включенных слагаемых.
+// Выбор делается один раз на пакет шагов, а не внутри цикла интегрирования.
+template <typename Scalar, template <typename> class... Terms, typename Function>
+void invokeWithDampingTerms(const DampingSettings &settings, Function &&function)
+{
+    DampingModel<Scalar, Terms...> model;
+    model.configure(settings);
+    function(model);
+}
+
+template <typename Scalar, typename Function>
+void withDampingModel(const DampingSettings &settings, Function &&function)
+{
+    const int mask = (settings.linearEnabled ? 1 : 0) |
+                     (settings.quadraticEnabled ? 2 : 0) |
+                     (settings.dryEnabled ? 4 : 0);
+    switch (mask) {
+    case 0: invokeWithDampingTerms<Scalar>(settings, function); break;
+    case 1: invokeWithDampingTerms<Scalar, LinearDrag>(settings, function); break;
+    case 2: invokeWithDampingTerms<Scalar, QuadraticDrag>(settings, function); break;
+    case 3: invokeWithDampingTerms<Scalar, LinearDrag, QuadraticDrag>(settings, function); break;
+    case 4: invokeWithDampingTerms<Scalar, CoulombFriction>(settings, function); break;
+    case 5: invokeWithDampingTerms<Scalar, LinearDrag, CoulombFriction>(settings, function); break;
+    case 6: invokeWithDampingTerms<Scalar, QuadraticDrag, CoulombFriction>(settings, function); break;
+    default: invokeWithDampingTerms<Scalar, LinearDrag, QuadraticDrag, CoulombFriction>(settings, function); break;
+    }
+}
+
+// Шаг полунеявного метода Эйлера с сопротивлением.
+// conservative — ускорение от консервативных сил, inertia — инерция модели
+// (ускорение = сила / inertia), energyScale переводит произведение
+// «сила·скорость» в джоули в секунду. Работа сил сопротивления
+// накапливается в dissipated.
+// Сухое трение: если скорость проходит через ноль внутри шага, груз
+// останавливается (событие остановки) и остается в покое, пока
+// консервативная сила не превысит уровень трения покоя. Так исключается
+// дребезг скорости около нуля.
+template <typename Damping, typename Sum, typename Scalar>
+void dampedEulerStep(const Damping &damping, Sum &coordinate, Scalar &velocity, Sum &dissipated,
+                     const Scalar &conservative, const Scalar &inertia, const Scalar &energyScale,
+                     const Scalar &dt)
+{
+    if constexpr (Damping::isEmpty) {
+        (void)damping;
+        (void)dissipated;
+        (void)inertia;
+        (void)energyScale;
+        velocity += conservative * dt;
+        coordinate.add(velocity * dt);
+    } else {
+        Scalar acceleration = conservative + damping.viscousForce(velocity) / inertia;
+        Scalar newVelocity;
+
+        if constexpr (Damping::hasDryFriction) {
+            using std::fabs;
+            const Scalar dry = damping.dryLevel() / inertia;
+            if (velocity == Scalar(0)) {
+                if (fabs(conservative) <= dry) {
+                    return;
+                }
+                acceleration -= conservative > Scalar(0) ? dry : -dry;
+                newVelocity = acceleration * dt;
+            } else {
+                acceleration -= velocity > Scalar(0) ? dry : -dry;
+                newVelocity = velocity + acceleration * dt;
+                if ((velocity > Scalar(0)) != (newVelocity > Scalar(0))) {
+                    newVelocity = Scalar(0);
+                }
+            }
+        } else {
+            newVelocity = velocity + acceleration * dt;
+        }
+
+        const Scalar dampingForce = (acceleration - conservative) * inertia;
+        dissipated.add(-dampingForce * newVelocity * energyScale * dt);
+        velocity = newVelocity;
+        coordinate.add(velocity * dt);
+    }
+}
+
+// Залипание сухим трением: скорость нулевая, и внешняя сила не превышает
+// трение покоя
+template <typename Damping, typename Scalar>
+bool isStuckByDryFriction(const Damping &damping, const Scalar &velocity,
+                          const Scalar &conservative, const Scalar &inertia)
+{
+    if constexpr (Damping::hasDryFriction) {
+        using std::fabs;
+        return velocity == Scalar(0) && fabs(conservative) <= damping.dryLevel() / inertia;
+    } else {
+        (void)damping;
+        (void)velocity;
+        (void)conservative;
+        (void)inertia;
+        return false;
+    }
+}
+
+#endif
@@ -0,0 +1,126 @@
+#ifndef DUALNUMBER_H
+#define DUALNUMBER_H
+
+#include <array>
+#include <cmath>
+#include <type_traits>
+#include "PendulumPhysics.h"
+
+// Дуальное число для прямого режима автоматического дифференцирования.
+// Хранит значение и N частных производных; все операции над производными —
+// плотные циклы по массиву фиксированной длины, которые компилятор
+// векторизует, так что один проход интегратора дает состояние и все
+// чувствительности сразу.
+template <typename T, int N>
+struct Dual {
+    T value{};
+    std::array<T, N> grad{};
+
+    Dual() = default;
+
+    template <typename U, typename = std::enable_if_t<std::is_arithmetic<U>::value>>
+    Dual(U constant) : value(static_cast<T>(constant)) {}
+
+    // Независимая переменная с единичной производной по своей «полосе»
+    static Dual variable(T value, int lane) {
+        Dual result(value);
+        result.grad[lane] = T(1);
+        return result;
+    }
+
+    Dual &operator+=(const Dual &other) {
+        value += other.value;
+        for (int i = 0; i < N; ++i) grad[i] += other.grad[i];
+        return *this;
+    }
+    Dual &operator-=(const Dual &other) {
+        value -= other.value;
+        for (int i = 0; i < N; ++i) grad[i] -= other.grad[i];
+        return *this;
+    }
+    Dual &operator*=(const Dual &other) { return *this = *this * other; }
+    Dual &operator/=(const Dual &other) { return *this = *this / other; }
+
+    friend Dual operator-(const Dual &a) {
+        Dual result;
+        result.value = -a.value;
+        for (int i = 0; i < N; ++i) result.grad[i] = -a.grad[i];
+        return result;
+    }
+
+    friend Dual operator+(Dual a, const Dual &b) { return a += b; }
+    friend Dual operator-(Dual a, const Dual &b) { return a -= b; }
+
+    friend Dual operator*(const Dual &a, const Dual &b) {
+        Dual result;
+        result.value = a.value * b.value;
+        for (int i = 0; i < N; ++i) result.grad[i] = a.grad[i] * b.value + a.value * b.grad[i];
+        return result;
+    }
+    friend Dual operator*(const Dual &a, T b) {
+        Dual result;
+        result.value = a.value * b;
+        for (int i = 0; i < N; ++i) result.grad[i] = a.grad[i] * b;
+        return result;
+    }
+    friend Dual operator*(T a, const Dual &b) { return b * a; }
+
+    friend Dual operator/(const Dual &a, const Dual &b) {
+        Dual result;
+        const T inverse = T(1) / b.value;
+        result.value = a.value * inverse;
+        for (int i = 0; i < N; ++i) result.grad[i] = (a.grad[i] - result.value * b.grad[i]) * inverse;
+        return result;
+    }
+    friend Dual operator/(const Dual &a, T b) { return a * (T(1) / b); }
+
+    // Сравнения выполняются по значению: ветвления интегратора
+    // (ограничение угла, упоры) дифференцируются как кусочные функции
+    friend bool operator<(const Dual &a, const Dual &b) { return a.value < b.value; }
+    friend bool operator>(const Dual &a, const Dual &b) { return a.value > b.value; }
+    friend bool operator<=(const Dual &a, const Dual &b) { return a.value <= b.value; }
+    friend bool operator>=(const Dual &a, const Dual &b) { return a.value >= b.value; }
+    friend bool operator==(const Dual &a, const Dual &b) { return a.value == b.value; }
+    friend bool operator!=(const Dual &a, const Dual &b) { return a.value != b.value; }
+
+    // Применение цепного правила: f(a) с производной df = f'(a)
+    friend Dual chain(const Dual &a, T f, T df) {
+        Dual result;
+        result.value = f;
+        for (int i = 0; i < N; ++i) result.grad[i] = df * a.grad[i];
+        return result;
+    }
+
+    friend Dual sin(const Dual &a) { using std::sin; using std::cos; return chain(a, sin(a.value), cos(a.value)); }
+    friend Dual cos(const Dual &a) { using std::sin; using std::cos; return chain(a, cos(a.value), -sin(a.value)); }
+    friend Dual exp(const Dual &a) { using std::exp; T e = exp(a.value); return chain(a, e, e); }
+    friend Dual log(const Dual &a) { using std::log; return chain(a, log(a.value), T(1) / a.value); }
+    friend Dual sqrt(const Dual &a) {
+        using std::sqrt;
+        T root = sqrt(a.value);
+        return chain(a, root, root > T(0) ? T(0.5) / root : T(0));
+    }
+    friend Dual pow(const Dual &a, T exponent) {
+        using std::pow;
+        return chain(a, pow(a.value, exponent), exponent * pow(a.value, exponent - T(1)));
+    }
+    friend Dual fabs(const Dual &a) { return a.value < T(0) ? -a : a; }
+    friend Dual abs(const Dual &a) { return fabs(a); }
+};
+
+// Значение без производных
+template <typename T>
+inline T primalValue(T x) { return x; }
+
+template <typename T, int N>
+inline T primalValue(const Dual<T, N> &x) { return x.value; }
+
+// Политика точности для ядер из PendulumPhysics.h
+template <int N, typename T = double>
+struct DualPrecision {
+    using Scalar = Dual<T, N>;
+    using Sum = PlainSum<Dual<T, N>>;
+    static constexpr const char *name = "dual";
+};
+
+#endif
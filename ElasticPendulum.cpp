@@ -0,0 +1,546 @@
+#include "ElasticPendulum.h"
+#include "ui_ElasticPendulum.h"
+#include "mainwindow.h"
+#include "FrameScheduler.h"
+#include "PhysicsWorker.h"
+#include "SimulationControlBar.h"
+#include "SpringPendulum.h"
+#include <QMenuBar>
+#include <QMenu>
+#include <QAction>
+#include <QPainter>
+#include <QVBoxLayout>
+#include <cmath>
+#include <QMessageBox>
+#include <QInputDialog>
+
+// Конструктор класса ElasticPendulum
+ElasticPendulum::ElasticPendulum(QWidget *parent) :
+    QWidget(parent), ui(new Ui::ElasticPendulum)
+{
+    ui->setupUi(this);
+    this->showFullScreen();
+
+    // Настройка меню
+    menuBar = new QMenuBar(this);
+    QMenu *fileMenu = menuBar->addMenu("Functions");
+    QAction *startAction = new QAction("Start", this);
+    startAction->setObjectName("actionStart");
+    QAction *pauseAction = new QAction("Pause", this);
+    pauseAction->setObjectName("actionPause");
+    QAction *fastForwardAction = new QAction("Fast forward...", this);
+    fastForwardAction->setObjectName("actionFastForward");
+    QAction *resetAction = new QAction("Reset", this);
+    resetAction->setObjectName("actionReset");
+    QAction *exitAction = new QAction("Exit", this);
+    exitAction->setObjectName("actionExit");
+    fileMenu->addAction(startAction);
+    fileMenu->addAction(pauseAction);
+    fileMenu->addAction(fastForwardAction);
+    fileMenu->addAction(resetAction);
+    fileMenu->addSeparator();
+    fileMenu->addAction(exitAction);
+
+    connect(startAction, &QAction::triggered, this, &ElasticPendulum::on_actionStart_triggered);
+    connect(pauseAction, &QAction::triggered, this, &ElasticPendulum::on_actionPause_triggered);
+    connect(fastForwardAction, &QAction::triggered, this, &ElasticPendulum::on_actionFastForward_triggered);
+    connect(resetAction, &QAction::triggered, this, &ElasticPendulum::on_actionReset_triggered);
+    connect(exitAction, &QAction::triggered, this, &ElasticPendulum::on_actionExit_triggered);
+
+    // След показывает фигуры Лиссажу, по которым видна перекачка энергии
+    QMenu *viewMenu = menuBar->addMenu("View");
+    QAction *motionTrailAction = new QAction("Motion trail", this);
+    motionTrailAction->setObjectName("actionMotionTrail");
+    motionTrailAction->setCheckable(true);
+    motionTrailAction->setChecked(motionTrailEnabled);
+    viewMenu->addAction(motionTrailAction);
+    connect(motionTrailAction, &QAction::toggled, this, &ElasticPendulum::on_actionMotionTrail_toggled);
+
+    QVBoxLayout *layout = new QVBoxLayout(this);
+    layout->setMenuBar(menuBar);
+
+    frameScheduler = new FrameScheduler(this);
+    connect(frameScheduler, &FrameScheduler::frame, this, &ElasticPendulum::updateAnimation);
+    physicsWorker = new PhysicsWorker(this);
+    connect(physicsWorker, &PhysicsWorker::seekFinished, this, &ElasticPendulum::on_physicsWorker_seekFinished);
+
+    controlBar = new SimulationControlBar(this);
+    menuBar->setCornerWidget(controlBar);
+    connect(controlBar, &SimulationControlBar::timeScaleChanged, this, &ElasticPendulum::on_controlBar_timeScaleChanged);
+    connect(controlBar, &SimulationControlBar::seekRequested, this, &ElasticPendulum::on_controlBar_seekRequested);
+    labelClock.start();
+    motionTrail.setFadeTime(10.0);
+
+    // Кнопки ввода подключает setupUi по именам слотов on_<кнопка>_clicked
+    defineParameters();
+    setInputsEnabled(true);
+    resetState();
+    updateOutputValues();
+}
+
+// Деструктор класса
+ElasticPendulum::~ElasticPendulum() {
+    delete ui;
+}
+
+// Описание вводимых параметров; значения по умолчанию записываются в поля
+void ElasticPendulum::defineParameters() {
+    parameters.define(Parameter::Mass, {"Mass", "kg", MIN_MASS, MAX_MASS, DEFAULT_MASS, true}, mass);
+    parameters.define(Parameter::Elasticity,
+                      {"Spring constant", "N/m", MIN_SPRING_CONST, MAX_SPRING_CONST, DEFAULT_SPRING_CONST, true},
+                      springConstant);
+    parameters.define(Parameter::RestLength,
+                      {"Rest length", "m", MIN_REST_LENGTH, MAX_REST_LENGTH, DEFAULT_REST_LENGTH, true},
+                      restLength);
+    parameters.define(Parameter::Angle, {"Angle", "deg", -90.0, 90.0, DEFAULT_ANGLE, false}, initialAngle);
+    parameters.define(Parameter::Stretch, {"Stretch", "m", -MAX_STRETCH, MAX_STRETCH, DEFAULT_STRETCH, false},
+                      initialStretch);
+}
+
+// Включение/отключение элементов ввода. Параметры, которые меняются на
+// ходу, остаются доступны в пределах LIVE_EDIT_RANGE от текущих значений,
+// чтобы шаг интегрирования оставался устойчивым.
+void ElasticPendulum::setInputsEnabled(bool enabled) {
+    const bool massEnabled = enabled || parameters.isLiveEditable(Parameter::Mass);
+    const bool elasticityEnabled = enabled || parameters.isLiveEditable(Parameter::Elasticity);
+    const bool restLengthEnabled = enabled || parameters.isLiveEditable(Parameter::RestLength);
+    const bool angleEnabled = enabled || parameters.isLiveEditable(Parameter::Angle);
+    const bool stretchEnabled = enabled || parameters.isLiveEditable(Parameter::Stretch);
+    parameters.setRange(Parameter::Mass, enabled ? MIN_MASS : qMax(MIN_MASS, mass / LIVE_EDIT_RANGE),
+                        enabled ? MAX_MASS : qMin(MAX_MASS, mass * LIVE_EDIT_RANGE));
+    parameters.setRange(Parameter::Elasticity,
+                        enabled ? MIN_SPRING_CONST : qMax(MIN_SPRING_CONST, springConstant / LIVE_EDIT_RANGE),
+                        enabled ? MAX_SPRING_CONST : qMin(MAX_SPRING_CONST, springConstant * LIVE_EDIT_RANGE));
+    parameters.setRange(Parameter::RestLength,
+                        enabled ? MIN_REST_LENGTH : qMax(MIN_REST_LENGTH, restLength / LIVE_EDIT_RANGE),
+                        enabled ? MAX_REST_LENGTH : qMin(MAX_REST_LENGTH, restLength * LIVE_EDIT_RANGE));
+
+    ui->MassInpEdit->setEnabled(massEnabled);
+    ui->ElasticityInpEdit->setEnabled(elasticityEnabled);
+    ui->RestLengthInpEdit->setEnabled(restLengthEnabled);
+    ui->AngleInpEdit->setEnabled(angleEnabled);
+    ui->StretchInpEdit->setEnabled(stretchEnabled);
+    ui->ButtonOKMass->setEnabled(massEnabled);
+    ui->ButtonResetMass->setEnabled(massEnabled);
+    ui->ButtonOKElasticity->setEnabled(elasticityEnabled);
+    ui->ButtonResetElasticity->setEnabled(elasticityEnabled);
+    ui->ButtonOKRestLength->setEnabled(restLengthEnabled);
+    ui->ButtonResetRestLength->setEnabled(restLengthEnabled);
+    ui->ButtonOKAngle->setEnabled(angleEnabled);
+    ui->ButtonResetAngle->setEnabled(angleEnabled);
+    ui->ButtonOKStretch->setEnabled(stretchEnabled);
+    ui->ButtonResetStretch->setEnabled(stretchEnabled);
+}
+
+// Начальное состояние: груз отведен на угол и растянут от равновесия,
+// скорость нулевая
+void ElasticPendulum::resetState() {
+    double angleRad = initialAngle * DEG_TO_RAD;
+    double radius = equilibriumLength() + initialStretch;
+    position[0] = radius * sin(angleRad);
+    position[1] = -radius * cos(angleRad);
+    velocity[0] = velocity[1] = 0.0;
+    simulatedTime = 0.0;
+    initialEnergy = calculateEnergy();
+    energyDrift = 0.0;
+    maxReach = calculateMaxReach();
+}
+
+// Отрисовка: пружина от подвеса к грузу. Геометрия пружины та же, что на
+// экране SpringPendulum, painter только поворачивается вдоль стержня.
+void ElasticPendulum::paintEvent(QPaintEvent *pEvent) {
+    QWidget::paintEvent(pEvent);
+    QPainter painter(this);
+    painter.setRenderHint(QPainter::Antialiasing);
+
+    if (motionTrailEnabled) {
+        motionTrail.draw(painter);
+    }
+
+    QPoint pivot = pivotPosition();
+    painter.setPen(QPen(Qt::black, 2));
+    painter.drawLine(pivot.x() - 60, pivot.y(), pivot.x() + 60, pivot.y());
+
+    // Положение равновесия
+    double scale = viewScale();
+    QPointF equilibrium(pivot.x(), pivot.y() + scale * equilibriumLength());
+    painter.setPen(QPen(Qt::lightGray, 1, Qt::DashLine));
+    painter.drawLine(QPointF(equilibrium.x() - 40, equilibrium.y()), QPointF(equilibrium.x() + 40, equilibrium.y()));
+
+    QPointF bob = bobPosition();
+    QPointF rod = bob - QPointF(pivot);
+    double pixels = std::hypot(rod.x(), rod.y());
+    if (pixels > bobRadius) {
+        painter.save();
+        painter.translate(pivot);
+        painter.rotate(-atan2(rod.x(), rod.y()) * RAD_TO_DEG);
+        SpringPendulum::drawSpring(painter, 0, 0, static_cast<int>(pixels) - bobRadius);
+        painter.restore();
+    }
+
+    painter.setPen(Qt::blue);
+    painter.setBrush(QBrush(Qt::white));
+    painter.drawEllipse(bob, bobRadius, bobRadius);
+}
+
+// Точка подвеса: сверху по центру окна
+QPoint ElasticPendulum::pivotPosition() const {
+    return QPoint(width() / 2, supportHeight);
+}
+
+// Масштаб: наибольшее удаление груза помещается в окно
+double ElasticPendulum::viewScale() const {
+    double available = qMin(height() - supportHeight - 3.0 * bobRadius, width() / 2.0 - 3.0 * bobRadius);
+    return qMax(available, 1.0) / maxReach;
+}
+
+// Положение груза на экране
+QPointF ElasticPendulum::bobPosition() const {
+    double scale = viewScale();
+    QPoint pivot = pivotPosition();
+    return QPointF(pivot.x() + scale * position[0], pivot.y() - scale * position[1]);
+}
+
+// Запуск анимации маятника
+void ElasticPendulum::startAnimation() {
+    if (frameScheduler->isActive()) {
+        return;
+    }
+
+    if (isPaused) {
+        physicsWorker->resumeSimulation();
+        frameScheduler->start();
+        isPaused = false;
+        return;
+    }
+
+    if (equilibriumLength() + initialStretch <= 0.0) {
+        QMessageBox::warning(this, "Error", "Stretch should keep the spring length positive!");
+        return;
+    }
+    if (qFuzzyIsNull(initialAngle) && qFuzzyIsNull(initialStretch)) {
+        QMessageBox::warning(this, "Error", "Please enter angle or stretch value first!");
+        return;
+    }
+
+    setInputsEnabled(false);
+    resetState();
+    motionTrail.clear();
+    physicsWorker->startSimulation(createPhysicsModel(), simulationStep());
+    frameScheduler->start();
+}
+
+// Обновление анимации (вызывается на каждом кадре)
+void ElasticPendulum::updateAnimation(double elapsedSeconds) {
+    const PhysicsSnapshot &snapshot = physicsWorker->latestSnapshot();
+    const double displayTime = physicsWorker->simulatedTimeNow();
+    for (int i = 0; i < 2; ++i) {
+        position[i] = interpolateState(snapshot, i, displayTime);
+        velocity[i] = interpolateState(snapshot, i + 2, displayTime);
+    }
+    simulatedTime = qMin(displayTime, snapshot.simulatedTime);
+
+    // Дрейф энергии считается по точному состоянию шага, а не по
+    // интерполированному, и относится к энергии колебаний
+    ElasticPendulumState<KahanDoublePrecision> state;
+    state.x = snapshot.state[0];
+    state.y = snapshot.state[1];
+    state.vx = snapshot.state[2];
+    state.vy = snapshot.state[3];
+    // После правки энергия отсчитывается от состояния, с которого модель
+    // продолжила движение с новыми параметрами
+    if (energyRevision > 0 && snapshot.parameterRevision >= energyRevision) {
+        initialEnergy = physicsKernel().energy(state);
+        maxReach = calculateMaxReach();
+        energyRevision = 0;
+    }
+    double oscillationEnergy = initialEnergy - calculateEquilibriumEnergy();
+    if (oscillationEnergy > 0.0) {
+        energyDrift = (physicsKernel().energy(state) - initialEnergy) / oscillationEnergy;
+    }
+
+    if (motionTrailEnabled) {
+        motionTrail.addPoint(bobPosition(), elapsedSeconds, size(), devicePixelRatioF());
+    }
+
+    update();
+
+    if (controlBar->timeScale() <= 1.0 || labelClock.hasExpired(LABEL_UPDATE_INTERVAL_MS)) {
+        updateOutputValues();
+        controlBar->setTimeline(simulatedTime, physicsWorker->recordedTime());
+        labelClock.restart();
+    }
+}
+
+// Ядро уравнений движения. Суммы Кэхэна для координат: изучение
+// перекачки энергии — это миллионы шагов.
+ElasticPendulumKernel<KahanDoublePrecision> ElasticPendulum::physicsKernel() const {
+    ElasticPendulumKernel<KahanDoublePrecision> kernel;
+    kernel.gravity = gravity;
+    kernel.mass = mass;
+    kernel.springConstant = springConstant;
+    kernel.restLength = restLength;
+    return kernel;
+}
+
+std::unique_ptr<PhysicsModel> ElasticPendulum::createPhysicsModel() const {
+    ElasticPendulumState<KahanDoublePrecision> state;
+    state.x = position[0];
+    state.y = position[1];
+    return makeKernelModel(physicsKernel(), state);
+}
+
+// Шаг интегрирования: не крупнее меньшего из периодов растяжения и
+// качаний / STEPS_PER_PERIOD
+double ElasticPendulum::simulationStep() const {
+    double springPeriod = 2 * M_PI * sqrt(mass / springConstant);
+    double swingPeriod = 2 * M_PI * sqrt(equilibriumLength() / gravity);
+    return qMin(SIMULATION_STEP, qMin(springPeriod, swingPeriod) / STEPS_PER_PERIOD);
+}
+
+// Длина пружины в равновесии под весом груза
+double ElasticPendulum::equilibriumLength() const {
+    return restLength + mass * gravity / springConstant;
+}
+
+// Механическая энергия относительно точки подвеса (Дж)
+double ElasticPendulum::calculateEnergy() const {
+    double stretch = std::hypot(position[0], position[1]) - restLength;
+    return 0.5 * mass * (velocity[0] * velocity[0] + velocity[1] * velocity[1]) +
+           0.5 * springConstant * stretch * stretch + mass * gravity * position[1];
+}
+
+// Энергия груза, висящего в равновесии (Дж)
+double ElasticPendulum::calculateEquilibriumEnergy() const {
+    double sag = mass * gravity / springConstant;
+    return 0.5 * springConstant * sag * sag - mass * gravity * equilibriumLength();
+}
+
+// Энергия растяжения: радиальное движение около длины равновесия
+double ElasticPendulum::calculateSpringModeEnergy() const {
+    double radius = std::hypot(position[0], position[1]);
+    if (radius <= 0.0) {
+        return 0.0;
+    }
+    double radialVelocity = (position[0] * velocity[0] + position[1] * velocity[1]) / radius;
+    double stretch = radius - equilibriumLength();
+    return 0.5 * mass * radialVelocity * radialVelocity + 0.5 * springConstant * stretch * stretch;
+}
+
+// Энергия качания: поперечное движение и подъем маятника длиной в
+// длину равновесия
+double ElasticPendulum::calculateSwingModeEnergy() const {
+    double radius = std::hypot(position[0], position[1]);
+    if (radius <= 0.0) {
+        return 0.0;
+    }
+    double tangentialVelocity = (position[0] * velocity[1] - position[1] * velocity[0]) / radius;
+    double cosAngle = -position[1] / radius;
+    return 0.5 * mass * tangentialVelocity * tangentialVelocity +
+           mass * gravity * equilibriumLength() * (1.0 - cosAngle);
+}
+
+// Отношение частот растяжения и малых качаний; при 2 обмен энергией
+// между ними резонансный
+double ElasticPendulum::calculateFrequencyRatio() const {
+    return sqrt(springConstant / mass) / sqrt(gravity / equilibriumLength());
+}
+
+// Наибольшее удаление груза от подвеса при энергии initialEnergy: груз
+// внизу без скорости, ½k(r - L0)² - m·g·r = E
+double ElasticPendulum::calculateMaxReach() const {
+    double weight = mass * gravity;
+    double discriminant = weight * weight + 2.0 * springConstant * (weight * restLength + initialEnergy);
+    return restLength + (weight + sqrt(qMax(discriminant, 0.0))) / springConstant;
+}
+
+// Обновление значений на интерфейсе
+void ElasticPendulum::updateOutputValues() {
+    ui->OutputSpringEnergyValue->setText(QString::number(calculateSpringModeEnergy(), 'f', 6));
+    ui->OutputSwingEnergyValue->setText(QString::number(calculateSwingModeEnergy(), 'f', 6));
+    ui->OutputFrequencyRatioValue->setText(QString::number(calculateFrequencyRatio(), 'f', 4));
+    ui->OutputEnergyDriftValue->setText(QString::number(energyDrift, 'e', 3));
+    ui->OutputSimulatedTimeValue->setText(QString::number(simulatedTime, 'f', 2));
+}
+
+// Единый путь ввода: проверка реестром, затем применение
+void ElasticPendulum::editParameter(Parameter parameter, const QString &text) {
+    QString error;
+    if (!parameters.set(parameter, text, error)) {
+        QMessageBox::warning(this, "Warning", error);
+        return;
+    }
+    applyParameterChange(parameter);
+}
+
+// Применение нового значения. До запуска меняется начальное состояние;
+// во время движения правка уходит в поток физики и вступает в силу на
+// ближайшей границе шага, а дрейф энергии отсчитывается заново.
+void ElasticPendulum::applyParameterChange(Parameter parameter) {
+    if (!physicsWorker->isRunning()) {
+        resetState();
+    } else if (parameters.isLiveEditable(parameter)) {
+        PhysicsParameter physicsParameter = PhysicsParameter::Length;
+        if (parameter == Parameter::Mass) {
+            physicsParameter = PhysicsParameter::Mass;
+        } else if (parameter == Parameter::Elasticity) {
+            physicsParameter = PhysicsParameter::SpringConstant;
+        }
+        energyRevision = physicsWorker->queueParameterEdits({{physicsParameter, parameters.value(parameter)}});
+        initialEnergy = calculateEnergy();
+        energyDrift = 0.0;
+        maxReach = calculateMaxReach();
+        motionTrail.clear();
+    }
+    updateOutputValues();
+    update();
+}
+
+// Обработчики событий кнопок
+void ElasticPendulum::on_ButtonOKMass_clicked() {
+    editParameter(Parameter::Mass, ui->MassInpEdit->toPlainText());
+}
+
+void ElasticPendulum::on_ButtonResetMass_clicked() {
+    parameters.reset(Parameter::Mass);
+    ui->MassInpEdit->clear();
+    applyParameterChange(Parameter::Mass);
+}
+
+void ElasticPendulum::on_ButtonOKElasticity_clicked() {
+    editParameter(Parameter::Elasticity, ui->ElasticityInpEdit->toPlainText());
+}
+
+void ElasticPendulum::on_ButtonResetElasticity_clicked() {
+    parameters.reset(Parameter::Elasticity);
+    ui->ElasticityInpEdit->clear();
+    applyParameterChange(Parameter::Elasticity);
+}
+
+void ElasticPendulum::on_ButtonOKRestLength_clicked() {
+    editParameter(Parameter::RestLength, ui->RestLengthInpEdit->toPlainText());
+}
+
+void ElasticPendulum::on_ButtonResetRestLength_clicked() {
+    parameters.reset(Parameter::RestLength);
+    ui->RestLengthInpEdit->clear();
+    applyParameterChange(Parameter::RestLength);
+}
+
+void ElasticPendulum::on_ButtonOKAngle_clicked() {
+    editParameter(Parameter::Angle, ui->AngleInpEdit->toPlainText());
+}
+
+void ElasticPendulum::on_ButtonResetAngle_clicked() {
+    parameters.reset(Parameter::Angle);
+    ui->AngleInpEdit->clear();
+    applyParameterChange(Parameter::Angle);
+}
+
+void ElasticPendulum::on_ButtonOKStretch_clicked() {
+    editParameter(Parameter::Stretch, ui->StretchInpEdit->toPlainText());
+}
+
+void ElasticPendulum::on_ButtonResetStretch_clicked() {
+    parameters.reset(Parameter::Stretch);
+    ui->StretchInpEdit->clear();
+    applyParameterChange(Parameter::Stretch);
+}
+
+// Обработчики событий меню
+void ElasticPendulum::on_actionStart_triggered() {
+    startAnimation();
+}
+
+void ElasticPendulum::on_actionPause_triggered() {
+    if (frameScheduler->isActive()) {
+        physicsWorker->pauseSimulation();
+        frameScheduler->stop();
+        isPaused = true;
+    } else if (isPaused) {
+        physicsWorker->resumeSimulation();
+        frameScheduler->start();
+        isPaused = false;
+    }
+}
+
+// Перемотка на заданное число секунд модельного времени
+void ElasticPendulum::on_actionFastForward_triggered() {
+    if (!frameScheduler->isActive() && !isPaused) {
+        QMessageBox::warning(this, "Error", "Please start the pendulum first!");
+        return;
+    }
+
+    bool ok;
+    double seconds = QInputDialog::getDouble(this, "Fast forward", "Skip simulated time [s]:",
+                                             60.0, 0.1, 1e6, 1, &ok);
+    if (!ok) return;
+
+    physicsWorker->skipAhead(seconds);
+    motionTrail.clear();
+    if (isPaused) {
+        on_actionPause_triggered();
+    }
+}
+
+void ElasticPendulum::on_actionReset_triggered() {
+    physicsWorker->stopSimulation();
+    frameScheduler->stop();
+    isPaused = false;
+
+    parameters.reset(Parameter::Mass);
+    parameters.reset(Parameter::Elasticity);
+    parameters.reset(Parameter::RestLength);
+    parameters.reset(Parameter::Angle);
+    parameters.reset(Parameter::Stretch);
+    ui->MassInpEdit->clear();
+    ui->ElasticityInpEdit->clear();
+    ui->RestLengthInpEdit->clear();
+    ui->AngleInpEdit->clear();
+    ui->StretchInpEdit->clear();
+    resetState();
+    motionTrail.clear();
+    controlBar->setTimeScale(1.0);
+    controlBar->setTimeline(0.0, 0.0);
+
+    setInputsEnabled(true);
+    updateOutputValues();
+    update();
+}
+
+void ElasticPendulum::on_actionMotionTrail_toggled(bool checked) {
+    motionTrailEnabled = checked;
+    motionTrail.clear();
+    update();
+}
+
+void ElasticPendulum::on_controlBar_timeScaleChanged(double scale) {
+    physicsWorker->setTimeScale(scale);
+}
+
+// Перемотка по шкале времени
+void ElasticPendulum::on_controlBar_seekRequested(double time) {
+    physicsWorker->seek(time);
+}
+
+// Результат перемотки на паузе; во время анимации его покажет очередной кадр
+void ElasticPendulum::on_physicsWorker_seekFinished() {
+    if (frameScheduler->isActive()) {
+        return;
+    }
+    motionTrail.clear();
+    updateAnimation(0.0);
+}
+
+void ElasticPendulum::on_actionExit_triggered()
+{
+    physicsWorker->stopSimulation();
+    if (frameScheduler->isActive()) {
+        frameScheduler->stop();
+    }
+
+    MainWindow *mainWindow = new MainWindow();
+    mainWindow->show();
+
+    this->close();
+}
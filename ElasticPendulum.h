@@ -0,0 +1,148 @@
+#ifndef ELASTICPENDULUM_H
+#define ELASTICPENDULUM_H
+
+#include <QWidget>
+#include <QMenuBar>
+#include <QElapsedTimer>
+#include <QMenu>
+#include <QAction>
+#include <memory>
+#include "PendulumPhysics.h"
+#include "PhysicsModel.h"
+#include "MotionTrail.h"
+#include "ParameterRegistry.h"
+
+class FrameScheduler;
+class PhysicsWorker;
+class SimulationControlBar;
+
+namespace Ui {
+class ElasticPendulum;
+}
+
+// Упругий маятник: груз на пружине, которая и растягивается, и качается.
+// Две степени свободы обмениваются энергией; при частоте растяжения вдвое
+// выше частоты качаний обмен почти полный. Перекачка энергии занимает
+// десятки периодов, поэтому кроме ускорения времени есть перемотка.
+class ElasticPendulum : public QWidget {
+    Q_OBJECT
+
+public:
+    explicit ElasticPendulum(QWidget *parent = nullptr);
+    ~ElasticPendulum();
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+
+private:
+    Ui::ElasticPendulum *ui;
+    QMenuBar *menuBar;
+    FrameScheduler *frameScheduler;
+    PhysicsWorker *physicsWorker;
+    SimulationControlBar *controlBar;
+    QElapsedTimer labelClock;
+    MotionTrail motionTrail;
+    bool motionTrailEnabled = true;
+
+    // Вводимые параметры: масса, жесткость и длина пружины меняются и во
+    // время движения, угол и растяжение задают начальное состояние
+    enum class Parameter { Mass, Elasticity, RestLength, Angle, Stretch };
+    ParameterRegistry<Parameter> parameters;
+
+    double mass = 1.0;
+    double springConstant = 0.0;
+    double restLength = 1.0;
+    double initialAngle = 0.0;
+    double initialStretch = 0.0;
+
+    // Текущее состояние относительно точки подвеса (x — вправо, y — вверх)
+    double position[2] = {};
+    double velocity[2] = {};
+    double simulatedTime = 0.0;
+    double initialEnergy = 0.0;
+    double energyDrift = 0.0;
+    // Пакет правок, после которого энергия отсчитывается заново по снимку
+    long long energyRevision = 0;
+    // Наибольшее удаление груза от подвеса при текущей энергии (м)
+    double maxReach = 1.0;
+    bool isPaused = false;
+
+    // Физические константы
+    const double gravity = 9.81;
+    const double DEG_TO_RAD = M_PI / 180.0;
+    const double RAD_TO_DEG = 180.0 / M_PI;
+    const int supportHeight = 80;
+    const int bobRadius = 15;
+    const double STEPS_PER_PERIOD = 400.0;
+    const int LABEL_UPDATE_INTERVAL_MS = 100;
+    // Во время движения масса, жесткость и длина меняются не больше чем в
+    // LIVE_EDIT_RANGE раз от значений при запуске
+    const double LIVE_EDIT_RANGE = 10.0;
+
+    // Диапазоны и значения по умолчанию. Жесткость по умолчанию дает
+    // резонанс 2:1 (k·L0 = 3·m·g) для груза 1 кг на пружине 1 м.
+    const double MIN_MASS = 1e-3;
+    const double MAX_MASS = 1e3;
+    const double MIN_SPRING_CONST = 1e-3;
+    const double MAX_SPRING_CONST = 1e6;
+    const double MIN_REST_LENGTH = 0.05;
+    const double MAX_REST_LENGTH = 100.0;
+    const double MAX_STRETCH = 100.0;
+    const double DEFAULT_MASS = 1.0;
+    const double DEFAULT_SPRING_CONST = 3.0 * 9.81;
+    const double DEFAULT_REST_LENGTH = 1.0;
+    const double DEFAULT_ANGLE = 10.0;
+    const double DEFAULT_STRETCH = 0.02;
+
+    // Методы расчетов
+    ElasticPendulumKernel<KahanDoublePrecision> physicsKernel() const;
+    std::unique_ptr<PhysicsModel> createPhysicsModel() const;
+    double simulationStep() const;
+    double equilibriumLength() const;
+    double calculateEnergy() const;
+    double calculateEquilibriumEnergy() const;
+    double calculateSpringModeEnergy() const;
+    double calculateSwingModeEnergy() const;
+    double calculateFrequencyRatio() const;
+    double calculateMaxReach() const;
+
+    // Вспомогательные методы
+    QPoint pivotPosition() const;
+    QPointF bobPosition() const;
+    double viewScale() const;
+    void resetState();
+    void startAnimation();
+    void setInputsEnabled(bool enabled);
+    void updateOutputValues();
+    void defineParameters();
+    void editParameter(Parameter parameter, const QString &text);
+    void applyParameterChange(Parameter parameter);
+
+private slots:
+    // Слоты для кнопок
+    void on_ButtonOKMass_clicked();
+    void on_ButtonResetMass_clicked();
+    void on_ButtonOKElasticity_clicked();
+    void on_ButtonResetElasticity_clicked();
+    void on_ButtonOKRestLength_clicked();
+    void on_ButtonResetRestLength_clicked();
+    void on_ButtonOKAngle_clicked();
+    void on_ButtonResetAngle_clicked();
+    void on_ButtonOKStretch_clicked();
+    void on_ButtonResetStretch_clicked();
+
+    // Слоты для меню
+    void on_actionStart_triggered();
+    void on_actionPause_triggered();
+    void on_actionFastForward_triggered();
+    void on_actionReset_triggered();
+    void on_actionExit_triggered();
+    void on_actionMotionTrail_toggled(bool checked);
+    void on_controlBar_timeScaleChanged(double scale);
+    void on_controlBar_seekRequested(double time);
+    void on_physicsWorker_seekFinished();
+
+    void updateAnimation(double elapsedSeconds);
+};
+
+#endif
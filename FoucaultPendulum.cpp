@@ -0,0 +1,422 @@
+#include "FoucaultPendulum.h"
+#include "ui_FoucaultPendulum.h"
+#include "FrameScheduler.h"
+#include "PhysicsWorker.h"
+#include "SimulationControlBar.h"
+#include <QMenuBar>
+#include <QMenu>
+#include <QAction>
+#include <QCloseEvent>
+#include <QPainter>
+#include <QVBoxLayout>
+#include <cmath>
+#include <QMessageBox>
+#include <QInputDialog>
+
+// Конструктор: параметры маятника передаются с экрана MathPendulum
+FoucaultPendulum::FoucaultPendulum(double length, double angle, double mass, QWidget *parent) :
+    QWidget(parent), ui(new Ui::FoucaultPendulum),
+    lengthForCalculations(length), initialAngle(angle), mass(mass)
+{
+    ui->setupUi(this);
+    this->showFullScreen();
+
+    // Настройка меню
+    menuBar = new QMenuBar(this);
+    QMenu *fileMenu = menuBar->addMenu("Functions");
+    QAction *startAction = new QAction("Start", this);
+    startAction->setObjectName("actionStart");
+    QAction *pauseAction = new QAction("Pause", this);
+    pauseAction->setObjectName("actionPause");
+    QAction *fastForwardAction = new QAction("Fast forward...", this);
+    fastForwardAction->setObjectName("actionFastForward");
+    QAction *resetAction = new QAction("Reset", this);
+    resetAction->setObjectName("actionReset");
+    QAction *exitAction = new QAction("Exit", this);
+    exitAction->setObjectName("actionExit");
+    fileMenu->addAction(startAction);
+    fileMenu->addAction(pauseAction);
+    fileMenu->addAction(fastForwardAction);
+    fileMenu->addAction(resetAction);
+    fileMenu->addSeparator();
+    fileMenu->addAction(exitAction);
+
+    connect(startAction, &QAction::triggered, this, &FoucaultPendulum::on_actionStart_triggered);
+    connect(pauseAction, &QAction::triggered, this, &FoucaultPendulum::on_actionPause_triggered);
+    connect(fastForwardAction, &QAction::triggered, this, &FoucaultPendulum::on_actionFastForward_triggered);
+    connect(resetAction, &QAction::triggered, this, &FoucaultPendulum::on_actionReset_triggered);
+    connect(exitAction, &QAction::triggered, this, &FoucaultPendulum::on_actionExit_triggered);
+
+    // След показывает розетку траектории и поворот плоскости качаний
+    QMenu *viewMenu = menuBar->addMenu("View");
+    QAction *motionTrailAction = new QAction("Motion trail", this);
+    motionTrailAction->setObjectName("actionMotionTrail");
+    motionTrailAction->setCheckable(true);
+    motionTrailAction->setChecked(motionTrailEnabled);
+    viewMenu->addAction(motionTrailAction);
+    connect(motionTrailAction, &QAction::toggled, this, &FoucaultPendulum::on_actionMotionTrail_toggled);
+
+    QVBoxLayout *layout = new QVBoxLayout(this);
+    layout->setMenuBar(menuBar);
+
+    frameScheduler = new FrameScheduler(this);
+    connect(frameScheduler, &FrameScheduler::frame, this, &FoucaultPendulum::updateAnimation);
+    physicsWorker = new PhysicsWorker(this);
+    connect(physicsWorker, &PhysicsWorker::seekFinished, this, &FoucaultPendulum::on_physicsWorker_seekFinished);
+
+    controlBar = new SimulationControlBar(this);
+    menuBar->setCornerWidget(controlBar);
+    connect(controlBar, &SimulationControlBar::timeScaleChanged, this, &FoucaultPendulum::on_controlBar_timeScaleChanged);
+    connect(controlBar, &SimulationControlBar::seekRequested, this, &FoucaultPendulum::on_controlBar_seekRequested);
+    labelClock.start();
+    motionTrail.setFadeTime(10.0);
+
+    latitude = DEFAULT_LATITUDE;
+    ui->LatitudeInpEdit->setPlainText(QString::number(latitude));
+    resetState();
+    updateOutputValues();
+}
+
+// Деструктор класса
+FoucaultPendulum::~FoucaultPendulum() {
+    delete ui;
+}
+
+// Включение/отключение элементов ввода
+void FoucaultPendulum::setInputsEnabled(bool enabled) {
+    ui->LatitudeInpEdit->setEnabled(enabled);
+    ui->ButtonOKLatitude->setEnabled(enabled);
+    ui->ButtonResetLatitude->setEnabled(enabled);
+}
+
+// Начальное состояние: груз отведен на восток и отпущен без скорости
+// относительно Земли
+void FoucaultPendulum::resetState() {
+    double angleRad = initialAngle * DEG_TO_RAD;
+    position[0] = lengthForCalculations * sin(angleRad);
+    position[1] = 0.0;
+    position[2] = -lengthForCalculations * cos(angleRad);
+    velocity[0] = velocity[1] = velocity[2] = 0.0;
+    simulatedTime = 0.0;
+    initialEnergy = calculateEnergy();
+    energyDrift = 0.0;
+    precessionAngle = 0.0;
+    lastPlaneAzimuth = calculatePlaneAzimuth();
+}
+
+// Вид сверху: север вверху, восток справа. Показаны исходная плоскость
+// качаний, теоретическое положение плоскости и след груза.
+void FoucaultPendulum::paintEvent(QPaintEvent *pEvent) {
+    QWidget::paintEvent(pEvent);
+    QPainter painter(this);
+    painter.setRenderHint(QPainter::Antialiasing);
+
+    if (motionTrailEnabled) {
+        motionTrail.draw(painter);
+    }
+
+    QPointF center(width() / 2.0, height() / 2.0);
+    double radius = viewScale() * lengthForCalculations * fabs(sin(initialAngle * DEG_TO_RAD)) * 1.05;
+
+    painter.setPen(Qt::gray);
+    painter.setBrush(Qt::NoBrush);
+    painter.drawEllipse(center, radius, radius);
+    painter.drawText(QPointF(center.x() - 4, center.y() - radius - 8), "N");
+    painter.drawText(QPointF(center.x() + radius + 8, center.y() + 4), "E");
+    painter.drawText(QPointF(center.x() - 4, center.y() + radius + 18), "S");
+    painter.drawText(QPointF(center.x() - radius - 18, center.y() + 4), "W");
+
+    // Исходная плоскость качаний (восток — запад)
+    painter.setPen(QPen(Qt::lightGray, 1));
+    painter.drawLine(QPointF(center.x() - radius, center.y()), QPointF(center.x() + radius, center.y()));
+
+    // Теоретическая плоскость: поворот на Ω·sin(φ)·t по часовой стрелке
+    double azimuth = (90.0 + calculateTheoreticalPrecession()) * DEG_TO_RAD;
+    QPointF direction(radius * sin(azimuth), -radius * cos(azimuth));
+    painter.setPen(QPen(Qt::darkGray, 1, Qt::DashLine));
+    painter.drawLine(center - direction, center + direction);
+
+    painter.setPen(Qt::blue);
+    painter.setBrush(QBrush(Qt::white));
+    const double bobRadius = 10.0;
+    QPointF bob = bobPosition();
+    painter.drawLine(center, bob);
+    painter.drawEllipse(bob, bobRadius, bobRadius);
+}
+
+// Масштаб вида сверху: амплитуда занимает 40% меньшей стороны окна
+double FoucaultPendulum::viewScale() const {
+    double amplitude = lengthForCalculations * fabs(sin(initialAngle * DEG_TO_RAD));
+    if (amplitude <= 0.0) {
+        return 1.0;
+    }
+    return 0.4 * qMin(width(), height()) / amplitude;
+}
+
+// Положение груза на экране
+QPointF FoucaultPendulum::bobPosition() const {
+    double scale = viewScale();
+    return QPointF(width() / 2.0 + scale * position[0], height() / 2.0 - scale * position[1]);
+}
+
+// Запуск анимации маятника
+void FoucaultPendulum::startAnimation() {
+    if (frameScheduler->isActive()) {
+        return;
+    }
+
+    if (isPaused) {
+        physicsWorker->resumeSimulation();
+        frameScheduler->start();
+        isPaused = false;
+        return;
+    }
+
+    if (qFuzzyIsNull(initialAngle)) {
+        QMessageBox::warning(this, "Error", "Please enter angle value on the mathematical pendulum screen first!");
+        return;
+    }
+
+    if (lengthForCalculations < 0.05 || lengthForCalculations > 1000.0) {
+        QMessageBox::information(this, "Information",
+        "Pendulum length is outside the oscillation range: [0.05;1000]. Oscillations are disabled.");
+        return;
+    }
+
+    setInputsEnabled(false);
+    resetState();
+    motionTrail.clear();
+    physicsWorker->startSimulation(createPhysicsModel(), simulationStep());
+    frameScheduler->start();
+}
+
+// Обновление анимации (вызывается на каждом кадре)
+void FoucaultPendulum::updateAnimation(double elapsedSeconds) {
+    const PhysicsSnapshot &snapshot = physicsWorker->latestSnapshot();
+    const double displayTime = physicsWorker->simulatedTimeNow();
+    for (int i = 0; i < 3; ++i) {
+        position[i] = interpolateState(snapshot, i, displayTime);
+        velocity[i] = interpolateState(snapshot, i + 3, displayTime);
+    }
+    double previousTime = simulatedTime;
+    simulatedTime = qMin(displayTime, snapshot.simulatedTime);
+    // После перемотки назад счет оборотов плоскости начинается заново
+    // с теоретического значения
+    if (simulatedTime < previousTime) {
+        previousTime = simulatedTime;
+        precessionAngle = calculateTheoreticalPrecession();
+        lastPlaneAzimuth = calculatePlaneAzimuth();
+    }
+
+    // Дрейф энергии считается по точному состоянию шага, а не по
+    // интерполированному
+    double z = snapshot.state[2];
+    double speedSquared = snapshot.state[3] * snapshot.state[3] + snapshot.state[4] * snapshot.state[4] +
+                          snapshot.state[5] * snapshot.state[5];
+    double energy = 0.5 * speedSquared + gravity * z;
+    energyDrift = (energy - initialEnergy) / (initialEnergy + gravity * lengthForCalculations);
+
+    // Азимут плоскости известен с точностью до 180°; ветвь выбирается по
+    // ожидаемому повороту, чтобы перемотка не сбивала счет оборотов
+    double expected = EARTH_ROTATION_RATE * sin(latitude * DEG_TO_RAD) * (simulatedTime - previousTime) * RAD_TO_DEG;
+    double azimuth = calculatePlaneAzimuth();
+    double delta = azimuth - lastPlaneAzimuth - expected;
+    delta -= 180.0 * std::round(delta / 180.0);
+    precessionAngle += expected + delta;
+    lastPlaneAzimuth = azimuth;
+
+    if (motionTrailEnabled) {
+        motionTrail.addPoint(bobPosition(), elapsedSeconds, size(), devicePixelRatioF());
+    }
+
+    update();
+
+    if (controlBar->timeScale() <= 1.0 || labelClock.hasExpired(LABEL_UPDATE_INTERVAL_MS)) {
+        updateOutputValues();
+        controlBar->setTimeline(simulatedTime, physicsWorker->recordedTime());
+        labelClock.restart();
+    }
+}
+
+// Ядро уравнений движения. Суммы Кэхэна для координат: прогон на
+// несколько суток — это десятки миллионов шагов.
+FoucaultPendulumKernel<KahanDoublePrecision> FoucaultPendulum::physicsKernel() const {
+    FoucaultPendulumKernel<KahanDoublePrecision> kernel;
+    kernel.gravity = gravity;
+    kernel.length = lengthForCalculations;
+    kernel.earthRate = EARTH_ROTATION_RATE;
+    kernel.latitude = latitude;
+    return kernel;
+}
+
+std::unique_ptr<PhysicsModel> FoucaultPendulum::createPhysicsModel() const {
+    SphericalPendulumState<KahanDoublePrecision> state;
+    state.x = position[0];
+    state.y = position[1];
+    state.z = position[2];
+    return makeKernelModel(physicsKernel(), state);
+}
+
+// Шаг интегрирования: не крупнее периода / STEPS_PER_PERIOD
+double FoucaultPendulum::simulationStep() const {
+    double period = 2 * M_PI * sqrt(lengthForCalculations / gravity);
+    return qMin(SIMULATION_STEP, period / STEPS_PER_PERIOD);
+}
+
+// Удельная механическая энергия относительно точки подвеса (Дж/кг)
+double FoucaultPendulum::calculateEnergy() const {
+    double speedSquared = velocity[0] * velocity[0] + velocity[1] * velocity[1] + velocity[2] * velocity[2];
+    return 0.5 * speedSquared + gravity * position[2];
+}
+
+// Азимут плоскости качаний (градусы от севера по часовой стрелке, по
+// модулю 180°). Тензор ω²·r·rᵀ + v·vᵀ горизонтальных компонент постоянен
+// при плоских гармонических колебаниях, поэтому его главная ось дает
+// плоскость в любой фазе качания, а не только в точке поворота.
+double FoucaultPendulum::calculatePlaneAzimuth() const {
+    double omegaSquared = gravity / lengthForCalculations;
+    double xx = omegaSquared * position[0] * position[0] + velocity[0] * velocity[0];
+    double yy = omegaSquared * position[1] * position[1] + velocity[1] * velocity[1];
+    double xy = omegaSquared * position[0] * position[1] + velocity[0] * velocity[1];
+    return 90.0 - 0.5 * atan2(2.0 * xy, xx - yy) * RAD_TO_DEG;
+}
+
+// Теоретический поворот плоскости: Ω·sin(φ)·t (градусы)
+double FoucaultPendulum::calculateTheoreticalPrecession() const {
+    return EARTH_ROTATION_RATE * sin(latitude * DEG_TO_RAD) * simulatedTime * RAD_TO_DEG;
+}
+
+// Время полного оборота плоскости: звездные сутки / |sin(φ)| (часы)
+double FoucaultPendulum::calculatePrecessionPeriod() const {
+    double rate = EARTH_ROTATION_RATE * fabs(sin(latitude * DEG_TO_RAD));
+    if (rate <= 0.0) {
+        return 0.0;
+    }
+    return 2 * M_PI / rate / SECONDS_PER_HOUR;
+}
+
+// Обновление значений на интерфейсе
+void FoucaultPendulum::updateOutputValues() {
+    ui->OutputPrecessionValue->setText(QString::number(precessionAngle, 'f', 3));
+    ui->OutputTheoryPrecessionValue->setText(QString::number(calculateTheoreticalPrecession(), 'f', 3));
+    if (calculatePrecessionPeriod() > 0.0) {
+        ui->OutputPrecessionPeriodValue->setText(QString::number(calculatePrecessionPeriod(), 'f', 3));
+    } else {
+        ui->OutputPrecessionPeriodValue->setText("-");
+    }
+    ui->OutputEnergyDriftValue->setText(QString::number(energyDrift, 'e', 3));
+    ui->OutputSimulatedTimeValue->setText(QString::number(simulatedTime / SECONDS_PER_HOUR, 'f', 3));
+}
+
+// Обработчики событий кнопок
+void FoucaultPendulum::on_ButtonOKLatitude_clicked() {
+    QString DataLatitude = ui->LatitudeInpEdit->toPlainText();
+    bool ok;
+    double newLatitude = DataLatitude.toDouble(&ok);
+
+    if (!ok || newLatitude < -90 || newLatitude > 90) {
+        QMessageBox::warning(this, "Warning", "Latitude should be in range [ -90, 90 ]!");
+        return;
+    }
+    latitude = newLatitude;
+    updateOutputValues();
+    update();
+}
+
+void FoucaultPendulum::on_ButtonResetLatitude_clicked() {
+    latitude = DEFAULT_LATITUDE;
+    ui->LatitudeInpEdit->setPlainText(QString::number(latitude));
+    updateOutputValues();
+    update();
+}
+
+// Обработчики событий меню
+void FoucaultPendulum::on_actionStart_triggered() {
+    startAnimation();
+}
+
+void FoucaultPendulum::on_actionPause_triggered() {
+    if (frameScheduler->isActive()) {
+        physicsWorker->pauseSimulation();
+        frameScheduler->stop();
+        isPaused = true;
+    } else if (isPaused) {
+        physicsWorker->resumeSimulation();
+        frameScheduler->start();
+        isPaused = false;
+    }
+}
+
+// Перемотка на заданное число часов модельного времени
+void FoucaultPendulum::on_actionFastForward_triggered() {
+    if (!frameScheduler->isActive() && !isPaused) {
+        QMessageBox::warning(this, "Error", "Please start the pendulum first!");
+        return;
+    }
+
+    bool ok;
+    double hours = QInputDialog::getDouble(this, "Fast forward", "Skip simulated time [h]:",
+                                           1.0, 0.01, 1000.0, 2, &ok);
+    if (!ok) return;
+
+    physicsWorker->skipAhead(hours * SECONDS_PER_HOUR);
+    motionTrail.clear();
+    if (isPaused) {
+        on_actionPause_triggered();
+    }
+}
+
+void FoucaultPendulum::on_actionReset_triggered() {
+    physicsWorker->stopSimulation();
+    frameScheduler->stop();
+    isPaused = false;
+
+    latitude = DEFAULT_LATITUDE;
+    ui->LatitudeInpEdit->setPlainText(QString::number(latitude));
+    resetState();
+    motionTrail.clear();
+    controlBar->setTimeScale(1.0);
+    controlBar->setTimeline(0.0, 0.0);
+
+    setInputsEnabled(true);
+    updateOutputValues();
+    update();
+}
+
+void FoucaultPendulum::on_actionMotionTrail_toggled(bool checked) {
+    motionTrailEnabled = checked;
+    motionTrail.clear();
+    update();
+}
+
+void FoucaultPendulum::on_controlBar_timeScaleChanged(double scale) {
+    physicsWorker->setTimeScale(scale);
+}
+
+// Перемотка по шкале времени
+void FoucaultPendulum::on_controlBar_seekRequested(double time) {
+    physicsWorker->seek(time);
+}
+
+// Результат перемотки на паузе; во время анимации его покажет очередной кадр
+void FoucaultPendulum::on_physicsWorker_seekFinished() {
+    if (frameScheduler->isActive()) {
+        return;
+    }
+    motionTrail.clear();
+    updateAnimation(0.0);
+}
+
+void FoucaultPendulum::on_actionExit_triggered()
+{
+    this->close();
+}
+
+// Остановка счета при любом закрытии окна, в том числе кнопкой заголовка
+void FoucaultPendulum::closeEvent(QCloseEvent *event)
+{
+    physicsWorker->stopSimulation();
+    frameScheduler->stop();
+    isPaused = false;
+    QWidget::closeEvent(event);
+}
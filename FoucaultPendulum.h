@@ -0,0 +1,113 @@
+#ifndef FOUCAULTPENDULUM_H
+#define FOUCAULTPENDULUM_H
+
+#include <QWidget>
+#include <QMenuBar>
+#include <QElapsedTimer>
+#include <QMenu>
+#include <QAction>
+#include <memory>
+#include "PendulumPhysics.h"
+#include "PhysicsModel.h"
+#include "MotionTrail.h"
+
+class FrameScheduler;
+class PhysicsWorker;
+class SimulationControlBar;
+
+namespace Ui {
+class FoucaultPendulum;
+}
+
+// Маятник Фуко: сферический маятник с учетом вращения Земли на заданной
+// широте. Длина, начальный угол и масса берутся из экрана MathPendulum,
+// движение показывается видом сверху. Прецессия плоскости качаний
+// занимает сутки и больше, поэтому кроме ускорения времени есть перемотка.
+class FoucaultPendulum : public QWidget {
+    Q_OBJECT
+
+public:
+    FoucaultPendulum(double length, double angle, double mass, QWidget *parent = nullptr);
+    ~FoucaultPendulum();
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+    // Закрытое окно остается до следующего открытия, поэтому поток физики
+    // останавливается здесь, а не в деструкторе
+    void closeEvent(QCloseEvent *event) override;
+
+private:
+    Ui::FoucaultPendulum *ui;
+    QMenuBar *menuBar;
+    FrameScheduler *frameScheduler;
+    PhysicsWorker *physicsWorker;
+    SimulationControlBar *controlBar;
+    QElapsedTimer labelClock;
+    MotionTrail motionTrail;
+    bool motionTrailEnabled = true;
+
+    // Параметры маятника (из MathPendulum)
+    double lengthForCalculations = 10.0;
+    double initialAngle = 0.0;
+    double mass = 1.0;
+    double latitude = 0.0;
+
+    // Текущее состояние: положение и скорость в местной системе
+    // (x — восток, y — север, z — вверх)
+    double position[3] = {};
+    double velocity[3] = {};
+    double simulatedTime = 0.0;
+    double initialEnergy = 0.0;
+    double energyDrift = 0.0;
+    // Азимут плоскости качаний с учетом полных оборотов (градусы)
+    double precessionAngle = 0.0;
+    double lastPlaneAzimuth = 0.0;
+    bool isPaused = false;
+
+    // Физические константы
+    const double gravity = 9.81;
+    const double DEG_TO_RAD = M_PI / 180.0;
+    const double RAD_TO_DEG = 180.0 / M_PI;
+    const double EARTH_ROTATION_RATE = 7.2921159e-5;  // рад/с (звездные сутки)
+    const double DEFAULT_LATITUDE = 48.85;            // Пантеон, Париж
+    const double SECONDS_PER_HOUR = 3600.0;
+    const double STEPS_PER_PERIOD = 400.0;
+    const int LABEL_UPDATE_INTERVAL_MS = 100;
+
+    // Методы расчетов
+    FoucaultPendulumKernel<KahanDoublePrecision> physicsKernel() const;
+    std::unique_ptr<PhysicsModel> createPhysicsModel() const;
+    double simulationStep() const;
+    double calculateEnergy() const;
+    double calculatePlaneAzimuth() const;
+    double calculateTheoreticalPrecession() const;
+    double calculatePrecessionPeriod() const;
+
+    // Вспомогательные методы
+    QPointF bobPosition() const;
+    double viewScale() const;
+    void resetState();
+    void startAnimation();
+    void setInputsEnabled(bool enabled);
+    void updateOutputValues();
+
+private slots:
+    // Слоты для кнопок
+    void on_ButtonOKLatitude_clicked();
+    void on_ButtonResetLatitude_clicked();
+
+    // Слоты для меню
+    void on_actionStart_triggered();
+    void on_actionPause_triggered();
+    void on_actionFastForward_triggered();
+    void on_actionReset_triggered();
+    void on_actionExit_triggered();
+    void on_actionMotionTrail_toggled(bool checked);
+    void on_controlBar_timeScaleChanged(double scale);
+    void on_controlBar_seekRequested(double time);
+    void on_physicsWorker_seekFinished();
+
+    void updateAnimation(double elapsedSeconds);
+};
+
+#endif
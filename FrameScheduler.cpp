@@ -0,0 +1,77 @@
+#include "FrameScheduler.h"
+#include <QEvent>
+#include <QWidget>
+#include <QWindow>
+
+// Конструктор планировщика кадров для окна виджета
+FrameScheduler::FrameScheduler(QWidget *widget) :
+    QObject(widget), widget(widget)
+{
+}
+
+// Запуск кадров; отсчет времени начинается заново
+void FrameScheduler::start()
+{
+    if (active) {
+        return;
+    }
+    active = true;
+    clock.start();
+    requestFrame();
+}
+
+// Остановка кадров: уже запрошенный кадр будет проигнорирован
+void FrameScheduler::stop()
+{
+    active = false;
+}
+
+bool FrameScheduler::isActive() const
+{
+    return active;
+}
+
+// Запрос следующего кадра у окна верхнего уровня
+void FrameScheduler::requestFrame()
+{
+    QWindow *handle = widget->window()->windowHandle();
+    if (handle != window) {
+        if (window) {
+            window->removeEventFilter(this);
+        }
+        window = handle;
+        if (window) {
+            window->installEventFilter(this);
+        }
+    }
+
+    if (!window || frameRequested) {
+        return;
+    }
+    frameRequested = true;
+    window->requestUpdate();
+}
+
+// Обработка запросов обновления окна
+bool FrameScheduler::eventFilter(QObject *watched, QEvent *event)
+{
+    if (watched == window) {
+        if (event->type() == QEvent::UpdateRequest && frameRequested) {
+            frameRequested = false;
+            if (active) {
+                double elapsedSeconds = clock.nsecsElapsed() * 1e-9;
+                clock.restart();
+                emit frame(elapsedSeconds);
+
+                if (active) {
+                    requestFrame();
+                }
+            }
+        } else if (event->type() == QEvent::Expose && active) {
+            // Скрытое окно может не доставить запрос — повторяем при показе
+            frameRequested = false;
+            requestFrame();
+        }
+    }
+    return QObject::eventFilter(watched, event);
+}
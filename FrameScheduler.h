@@ -0,0 +1,43 @@
+#ifndef FRAMESCHEDULER_H
+#define FRAMESCHEDULER_H
+
+#include <QObject>
+#include <QElapsedTimer>
+#include <QPointer>
+
+class QWidget;
+class QWindow;
+
+// Планировщик кадров анимации. Кадры запрашиваются через
+// QWindow::requestUpdate(), поэтому идут в такт обновлению экрана там, где
+// платформа это поддерживает. Пока планировщик остановлен, он не держит ни
+// таймеров, ни запросов перерисовки — простаивающее окно не тратит CPU.
+class FrameScheduler : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit FrameScheduler(QWidget *widget);
+
+    void start();
+    void stop();
+    bool isActive() const;
+
+signals:
+    // Очередной кадр; elapsedSeconds — реальное время с прошлого кадра
+    void frame(double elapsedSeconds);
+
+protected:
+    bool eventFilter(QObject *watched, QEvent *event) override;
+
+private:
+    void requestFrame();
+
+    QWidget *widget;
+    QPointer<QWindow> window;
+    QElapsedTimer clock;
+    bool active = false;
+    bool frameRequested = false;
+};
+
+#endif
@@ -0,0 +1,90 @@
+#include "InputLatencyMonitor.h"
+#include <QPainter>
+#include <QRect>
+#include <algorithm>
+
+InputLatencyMonitor &InputLatencyMonitor::instance()
+{
+    static InputLatencyMonitor monitor;
+    return monitor;
+}
+
+InputLatencyMonitor::InputLatencyMonitor()
+{
+    clock.start();
+}
+
+void InputLatencyMonitor::setEnabled(bool enabled)
+{
+    this->enabled = enabled;
+    pendingInput = -1;
+}
+
+bool InputLatencyMonitor::isEnabled() const
+{
+    return enabled;
+}
+
+// Запоминается только самое раннее еще не показанное событие
+void InputLatencyMonitor::inputHandled()
+{
+    if (enabled && pendingInput < 0) {
+        pendingInput = clock.nsecsElapsed();
+    }
+}
+
+// Кольцевой буфер измерений: долгая работа киоска не расходует память
+void InputLatencyMonitor::frameDrawn()
+{
+    if (!enabled || pendingInput < 0) {
+        return;
+    }
+    double latency = (clock.nsecsElapsed() - pendingInput) * 1e-6;
+    pendingInput = -1;
+    if (latencies.size() < MAX_SAMPLES) {
+        latencies.push_back(latency);
+    } else {
+        latencies[nextSlot] = latency;
+        nextSlot = (nextSlot + 1) % MAX_SAMPLES;
+    }
+}
+
+double InputLatencyMonitor::percentile(const std::vector<double> &sorted, double fraction)
+{
+    std::size_t index = static_cast<std::size_t>(fraction * (sorted.size() - 1) + 0.5);
+    return sorted[index];
+}
+
+QString InputLatencyMonitor::summary() const
+{
+    if (latencies.empty()) {
+        return "Input to frame: no samples";
+    }
+    std::vector<double> sorted = latencies;
+    std::sort(sorted.begin(), sorted.end());
+    double sum = 0.0;
+    for (double latency : sorted) {
+        sum += latency;
+    }
+    return QString("Input to frame: %1 samples, mean %2 ms, p50 %3 ms, p95 %4 ms, max %5 ms")
+        .arg(static_cast<qint64>(sorted.size()))
+        .arg(sum / sorted.size(), 0, 'f', 2)
+        .arg(percentile(sorted, 0.5), 0, 'f', 2)
+        .arg(percentile(sorted, 0.95), 0, 'f', 2)
+        .arg(sorted.back(), 0, 'f', 2);
+}
+
+void InputLatencyMonitor::drawOverlay(QPainter &painter, const QRect &rect)
+{
+    if (!enabled) {
+        return;
+    }
+    if (!overlayClock.isValid() || overlayClock.hasExpired(OVERLAY_INTERVAL_MS)) {
+        overlayText = summary();
+        overlayClock.start();
+    }
+    painter.save();
+    painter.setPen(Qt::darkRed);
+    painter.drawText(rect.adjusted(10, 10, -10, -10), Qt::AlignLeft | Qt::AlignBottom, overlayText);
+    painter.restore();
+}
@@ -0,0 +1,55 @@
+#ifndef INPUTLATENCYMONITOR_H
+#define INPUTLATENCYMONITOR_H
+
+#include <QElapsedTimer>
+#include <QString>
+#include <vector>
+
+class QPainter;
+class QRect;
+
+// Измерение задержки от ввода до кадра (ProjectPendulums --measure-latency).
+// Отсчет идет от обработки события ввода, изменившего сцену, до конца
+// отрисовки первого кадра, который показывает результат. Несколько событий
+// до одного кадра дают одно измерение от самого раннего из них. Время в
+// очереди событий платформы и вывод кадра на экран композитором сюда не
+// входят — это задержка, которую добавляет само приложение.
+class InputLatencyMonitor
+{
+public:
+    static InputLatencyMonitor &instance();
+
+    void setEnabled(bool enabled);
+    bool isEnabled() const;
+
+    // Событие ввода изменило сцену
+    void inputHandled();
+    // Кадр отрисован
+    void frameDrawn();
+
+    // Число измерений, среднее, медиана, 95-й процентиль и максимум (мс)
+    QString summary() const;
+    // Сводка поверх сцены в углу rect; пересчитывается не чаще раза в
+    // OVERLAY_INTERVAL_MS, чтобы сама не добавляла задержки кадру
+    void drawOverlay(QPainter &painter, const QRect &rect);
+
+private:
+    InputLatencyMonitor();
+
+    // Процентиль по отсортированной копии измерений
+    static double percentile(const std::vector<double> &sorted, double fraction);
+
+    // Хранится не больше MAX_SAMPLES последних измерений
+    static constexpr std::size_t MAX_SAMPLES = 10000;
+    static constexpr qint64 OVERLAY_INTERVAL_MS = 500;
+
+    QElapsedTimer clock;
+    bool enabled = false;
+    qint64 pendingInput = -1;
+    std::vector<double> latencies;
+    std::size_t nextSlot = 0;
+    QString overlayText;
+    QElapsedTimer overlayClock;
+};
+
+#endif
@@ -0,0 +1,271 @@
+#include "InteractionRecorder.h"
+#include <QAbstractButton>
+#include <QAbstractSlider>
+#include <QAction>
+#include <QActionEvent>
+#include <QApplication>
+#include <QInputDialog>
+#include <QPointer>
+#include <QTextEdit>
+#include <QTimer>
+
+// Экранирование разделителей строки записи
+static QString escapeField(const QString &text)
+{
+    QString result;
+    result.reserve(text.size());
+    for (QChar c : text) {
+        if (c == '\\') result += "\\\\";
+        else if (c == '\t') result += "\\t";
+        else if (c == '\n') result += "\\n";
+        else result += c;
+    }
+    return result;
+}
+
+static QString unescapeField(const QString &text)
+{
+    QString result;
+    result.reserve(text.size());
+    for (int i = 0; i < text.size(); ++i) {
+        if (text[i] != '\\' || i + 1 == text.size()) {
+            result += text[i];
+            continue;
+        }
+        QChar next = text[++i];
+        if (next == 't') result += '\t';
+        else if (next == 'n') result += '\n';
+        else result += next;
+    }
+    return result;
+}
+
+QString RecordedInteraction::toLine() const
+{
+    return QString("%1\t%2\t%3\t%4\t%5")
+        .arg(time)
+        .arg(escapeField(window), escapeField(kind), escapeField(object), escapeField(value));
+}
+
+// Разбор строки записи; пустые строки и комментарии (#) пропускаются
+bool RecordedInteraction::fromLine(const QString &line, RecordedInteraction &interaction)
+{
+    if (line.trimmed().isEmpty() || line.startsWith('#')) {
+        return false;
+    }
+    const QStringList fields = line.split('\t');
+    if (fields.size() != 5) {
+        return false;
+    }
+    bool ok;
+    interaction.time = fields[0].toLongLong(&ok);
+    if (!ok) {
+        return false;
+    }
+    interaction.window = unescapeField(fields[1]);
+    interaction.kind = unescapeField(fields[2]);
+    interaction.object = unescapeField(fields[3]);
+    interaction.value = unescapeField(fields[4]);
+    return true;
+}
+
+// Конструктор: файл открывается сразу, фильтр ставится на все приложение
+InteractionRecorder::InteractionRecorder(const QString &fileName, QObject *parent) :
+    QObject(parent), file(fileName)
+{
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text)) {
+        return;
+    }
+    stream.setDevice(&file);
+    clock.start();
+    qApp->installEventFilter(this);
+}
+
+InteractionRecorder::~InteractionRecorder()
+{
+    if (isOpen()) {
+        write(nullptr, "end", QString(), QString());
+    }
+}
+
+bool InteractionRecorder::isOpen() const
+{
+    return file.isOpen();
+}
+
+QString InteractionRecorder::errorString() const
+{
+    return file.errorString();
+}
+
+// Подключение к новым виджетам и действиям. Текст полей ввода записывается
+// в момент нажатия кнопки — до того, как обработчик кнопки его изменит.
+bool InteractionRecorder::eventFilter(QObject *watched, QEvent *event)
+{
+    switch (event->type()) {
+    case QEvent::Polish:
+        if (watched->isWidgetType()) {
+            watchWidget(static_cast<QWidget *>(watched));
+        }
+        break;
+    case QEvent::ActionAdded:
+        watchAction(static_cast<QActionEvent *>(event)->action());
+        break;
+    case QEvent::Show:
+        if (qobject_cast<QInputDialog *>(watched)) {
+            watchInputDialog(static_cast<QWidget *>(watched));
+        }
+        break;
+    case QEvent::MouseButtonPress:
+    case QEvent::KeyPress:
+        if (QAbstractButton *button = qobject_cast<QAbstractButton *>(watched)) {
+            recordTexts(button->window());
+        }
+        break;
+    default:
+        break;
+    }
+    return QObject::eventFilter(watched, event);
+}
+
+void InteractionRecorder::watchWidget(QWidget *widget)
+{
+    if (widget->objectName().isEmpty()) {
+        return;
+    }
+
+    if (QTextEdit *edit = qobject_cast<QTextEdit *>(widget)) {
+        knownTexts.insert(edit, edit->toPlainText());
+        connect(edit, &QObject::destroyed, this, [this](QObject *object) {
+            knownTexts.remove(object);
+        });
+    } else if (QAbstractButton *button = qobject_cast<QAbstractButton *>(widget)) {
+        connect(button, &QAbstractButton::clicked, this, [this, button]() {
+            QPointer<QWidget> window = button->window();
+            write(window, "click", button->objectName(), QString());
+            // Обработчик кнопки уже отработал; заданный им текст — не ввод
+            QTimer::singleShot(0, this, [this, window]() {
+                if (window) {
+                    rememberTexts(window);
+                }
+            });
+        });
+    } else if (QAbstractSlider *slider = qobject_cast<QAbstractSlider *>(widget)) {
+        knownSliderValues.insert(slider, slider->value());
+        auto recordSlider = [this, slider]() {
+            if (knownSliderValues.value(slider) == slider->value()) {
+                return;
+            }
+            knownSliderValues.insert(slider, slider->value());
+            write(slider->window(), "slider", slider->objectName(), QString::number(slider->value()));
+        };
+        // Во время перетаскивания записывается только конечное положение;
+        // прочие действия (клавиши, щелчок по полосе) меняют значение
+        // после сигнала, поэтому запись откладывается
+        connect(slider, &QAbstractSlider::sliderReleased, this, recordSlider);
+        connect(slider, &QAbstractSlider::actionTriggered, this, [this, slider, recordSlider](int action) {
+            if (action != QAbstractSlider::SliderMove) {
+                QTimer::singleShot(0, slider, recordSlider);
+            }
+        });
+        connect(slider, &QObject::destroyed, this, [this](QObject *object) {
+            knownSliderValues.remove(object);
+        });
+    }
+}
+
+// Действие подключается один раз, даже если добавлено в несколько меню.
+// Экраны подключают свои слоты после addAction, поэтому действие
+// записывается раньше, чем его обработчик откроет диалог.
+void InteractionRecorder::watchAction(QAction *action)
+{
+    if (action->property("interactionRecorded").toBool()) {
+        return;
+    }
+    action->setProperty("interactionRecorded", true);
+
+    connect(action, &QAction::triggered, this, [this, action]() {
+        QWidget *owner = qobject_cast<QWidget *>(action->parent());
+        if (!owner || action->objectName().isEmpty()) {
+            return;
+        }
+        QPointer<QWidget> window = owner->window();
+        recordTexts(window);
+        write(window, "action", action->objectName(), QString());
+        QTimer::singleShot(0, this, [this, window]() {
+            if (window) {
+                rememberTexts(window);
+            }
+        });
+    });
+}
+
+// Ответ в диалоге ввода: число или текст, пустое значение — отмена
+void InteractionRecorder::watchInputDialog(QWidget *widget)
+{
+    QInputDialog *dialog = static_cast<QInputDialog *>(widget);
+    if (dialog->property("interactionRecorded").toBool()) {
+        return;
+    }
+    dialog->setProperty("interactionRecorded", true);
+
+    connect(dialog, &QDialog::finished, this, [this, dialog](int result) {
+        QString value;
+        if (result == QDialog::Accepted) {
+            switch (dialog->inputMode()) {
+            case QInputDialog::DoubleInput:
+                value = QString::number(dialog->doubleValue(), 'g', 17);
+                break;
+            case QInputDialog::IntInput:
+                value = QString::number(dialog->intValue());
+                break;
+            case QInputDialog::TextInput:
+                value = dialog->textValue();
+                break;
+            }
+        }
+        QWidget *owner = dialog->parentWidget();
+        write(owner ? owner->window() : dialog, "input", dialog->objectName(), value);
+    });
+}
+
+// Запись полей ввода окна, текст которых изменился с прошлой записи
+void InteractionRecorder::recordTexts(QWidget *window)
+{
+    if (!window) {
+        return;
+    }
+    for (QTextEdit *edit : window->findChildren<QTextEdit *>()) {
+        auto known = knownTexts.find(edit);
+        if (known == knownTexts.end() || edit->isReadOnly()) {
+            continue;
+        }
+        const QString text = edit->toPlainText();
+        if (text != known.value()) {
+            known.value() = text;
+            write(window, "text", edit->objectName(), text);
+        }
+    }
+}
+
+void InteractionRecorder::rememberTexts(QWidget *window)
+{
+    for (QTextEdit *edit : window->findChildren<QTextEdit *>()) {
+        auto known = knownTexts.find(edit);
+        if (known != knownTexts.end()) {
+            known.value() = edit->toPlainText();
+        }
+    }
+}
+
+void InteractionRecorder::write(QWidget *window, const QString &kind, const QString &object, const QString &value)
+{
+    RecordedInteraction interaction;
+    interaction.time = clock.elapsed();
+    interaction.window = window ? window->metaObject()->className() : QString();
+    interaction.kind = kind;
+    interaction.object = object;
+    interaction.value = value;
+    stream << interaction.toLine() << '\n';
+    stream.flush();
+}
@@ -0,0 +1,70 @@
+#ifndef INTERACTIONRECORDER_H
+#define INTERACTIONRECORDER_H
+
+#include <QObject>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QHash>
+#include <QString>
+#include <QTextStream>
+
+class QAction;
+class QWidget;
+
+// Одно действие пользователя в записи сеанса. Действия записываются по
+// смыслу, а не по координатам мыши: окно и объект ищутся по имени класса и
+// objectName, поэтому запись воспроизводится на любом экране и платформе.
+//
+// Строка файла: время_мс \t класс_окна \t вид \t objectName \t значение
+//   text   — текст поля ввода перед нажатием кнопки или действием меню
+//   click  — нажатие кнопки
+//   action — действие меню (Start, Pause, Reset, ...)
+//   slider — новое положение ползунка
+//   input  — ответ в QInputDialog; пустое значение — отмена
+//   end    — конец сеанса
+struct RecordedInteraction {
+    qint64 time = 0;
+    QString window;
+    QString kind;
+    QString object;
+    QString value;
+
+    QString toLine() const;
+    static bool fromLine(const QString &line, RecordedInteraction &interaction);
+};
+
+// Запись действий пользователя в файл. Фильтр событий ставится на все
+// приложение и подключается к кнопкам, ползункам и действиям меню по мере
+// их появления; объекты без objectName не записываются.
+class InteractionRecorder : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit InteractionRecorder(const QString &fileName, QObject *parent = nullptr);
+    ~InteractionRecorder();
+
+    bool isOpen() const;
+    QString errorString() const;
+
+protected:
+    bool eventFilter(QObject *watched, QEvent *event) override;
+
+private:
+    void watchWidget(QWidget *widget);
+    void watchAction(QAction *action);
+    void watchInputDialog(QWidget *dialog);
+    void recordTexts(QWidget *window);
+    void rememberTexts(QWidget *window);
+    void write(QWidget *window, const QString &kind, const QString &object, const QString &value);
+
+    QFile file;
+    QTextStream stream;
+    QElapsedTimer clock;
+    // Последний записанный или установленный программой текст полей ввода
+    QHash<const QObject *, QString> knownTexts;
+    // Последнее записанное положение ползунков
+    QHash<const QObject *, int> knownSliderValues;
+};
+
+#endif
@@ -0,0 +1,112 @@
+#include "KeyframeTimeline.h"
+#include <algorithm>
+
+// Новый прогон: единственный кадр — начальное состояние
+void KeyframeTimeline::reset(const PhysicsModel &model)
+{
+    keyframes.clear();
+    editRecords.clear();
+    recordedSinceThin = 0;
+    keyframes.push_back({0, model.clone()});
+}
+
+long long KeyframeTimeline::interval() const
+{
+    return INTERVAL;
+}
+
+long long KeyframeTimeline::nextKeyframeStep(long long step) const
+{
+    return (step / INTERVAL + 1) * INTERVAL;
+}
+
+// Прореживание проходит по всем кадрам, поэтому выполняется не на каждой
+// записи, а после каждой четверти свежей части
+void KeyframeTimeline::record(long long step, const PhysicsModel &model)
+{
+    if (step % INTERVAL != 0) {
+        return;
+    }
+    // После перемотки назад досчет повторяет уже записанные шаги
+    if (!keyframes.empty() && step <= keyframes.back().step) {
+        return;
+    }
+    keyframes.push_back({step, model.clone()});
+    if (++recordedSinceThin >= RECENT_KEYFRAMES / 4) {
+        thin();
+    }
+}
+
+std::unique_ptr<PhysicsModel> KeyframeTimeline::restore(long long step, long long &keyframeStep) const
+{
+    auto next = std::upper_bound(keyframes.begin(), keyframes.end(), step,
+                                 [](long long value, const Keyframe &keyframe) { return value < keyframe.step; });
+    if (next == keyframes.begin()) {
+        return nullptr;
+    }
+    const Keyframe &keyframe = *(next - 1);
+    keyframeStep = keyframe.step;
+    return keyframe.model->clone();
+}
+
+void KeyframeTimeline::recordEdits(long long step, const std::vector<ParameterEdit> &edits)
+{
+    auto keyframesEnd = std::remove_if(keyframes.begin(), keyframes.end(),
+                                       [step](const Keyframe &keyframe) { return keyframe.step > step; });
+    keyframes.erase(keyframesEnd, keyframes.end());
+    auto editsEnd = std::remove_if(editRecords.begin(), editRecords.end(),
+                                   [step](const EditRecord &record) { return record.step > step; });
+    editRecords.erase(editsEnd, editRecords.end());
+
+    // Несколько правок на одном шаге применяются в порядке поступления
+    if (!editRecords.empty() && editRecords.back().step == step) {
+        editRecords.back().edits.insert(editRecords.back().edits.end(), edits.begin(), edits.end());
+    } else {
+        editRecords.push_back({step, edits});
+    }
+}
+
+long long KeyframeTimeline::nextEditStep(long long step) const
+{
+    auto next = std::upper_bound(editRecords.begin(), editRecords.end(), step,
+                                 [](long long value, const EditRecord &record) { return value < record.step; });
+    return next == editRecords.end() ? -1 : next->step;
+}
+
+void KeyframeTimeline::applyEdits(long long step, PhysicsModel &model) const
+{
+    auto record = std::lower_bound(editRecords.begin(), editRecords.end(), step,
+                                   [](const EditRecord &record, long long value) { return record.step < value; });
+    if (record == editRecords.end() || record->step != step) {
+        return;
+    }
+    for (const ParameterEdit &edit : record->edits) {
+        model.setParameter(edit.parameter, edit.value);
+    }
+}
+
+// Свежая часть — INTERVAL; дальше интервал удваивается при каждом
+// удвоении возраста, оставаясь не больше 2·age / RECENT_KEYFRAMES
+long long KeyframeTimeline::spacingForAge(long long age)
+{
+    long long spacing = INTERVAL;
+    while (2 * spacing * RECENT_KEYFRAMES <= 2 * age) {
+        spacing *= 2;
+    }
+    return spacing;
+}
+
+// Прореживание: остаются кадры, кратные интервалу для их возраста. С
+// возрастом интервал только растет и остается степенью двойки, умноженной
+// на INTERVAL, поэтому отброшенный кадр никогда не понадобится снова, а
+// оставшиеся совпадают с тем, что дало бы прореживание на каждой записи.
+// Начальный кадр не отбрасывается.
+void KeyframeTimeline::thin()
+{
+    recordedSinceThin = 0;
+    const long long newest = keyframes.back().step;
+    auto end = std::remove_if(keyframes.begin(), keyframes.end(), [newest](const Keyframe &keyframe) {
+        return keyframe.step % spacingForAge(newest - keyframe.step) != 0;
+    });
+    keyframes.erase(end, keyframes.end());
+}
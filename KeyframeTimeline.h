@@ -0,0 +1,70 @@
+#ifndef KEYFRAMETIMELINE_H
+#define KEYFRAMETIMELINE_H
+
+#include <memory>
+#include <vector>
+#include "PhysicsModel.h"
+
+// Ключевые кадры прогона для перемотки. Каждые INTERVAL шагов
+// сохраняется копия модели целиком (ядро, состояние, анализатор), и
+// переход к любому шагу — это восстановление ближайшего кадра не позже
+// него и детерминированный досчет до нужного шага.
+// Последние RECENT_KEYFRAMES кадров (около 4,5 ч модельного времени при
+// шаге SIMULATION_STEP) хранятся все, и досчет в этой части не длиннее
+// INTERVAL шагов. Дальше в прошлом кадры прореживаются: у кадра возраста
+// a шагов (от последнего кадра) расстояние до соседа — наибольшая
+// степень двойки, умноженная на INTERVAL, не больше 2a / RECENT_KEYFRAMES.
+// Поэтому досчет при переходе на a шагов назад не длиннее примерно
+// 2a / RECENT_KEYFRAMES шагов (час назад — около 2 с модельного времени),
+// а число кадров растет как RECENT_KEYFRAMES · (1 + log2(длина прогона /
+// длина свежей части) / 2).
+// Правки параметров на ходу записываются вместе с шагом, на котором они
+// применены, и повторяются при досчете, так что перемотка через правку
+// воспроизводит тот же прогон.
+// Используется только потоком физики.
+class KeyframeTimeline
+{
+public:
+    static constexpr long long INTERVAL = 250;
+    static constexpr long long RECENT_KEYFRAMES = 4096;
+
+    void reset(const PhysicsModel &model);
+
+    long long interval() const;
+    // Ближайший шаг, на котором нужен ключевой кадр (строго после step)
+    long long nextKeyframeStep(long long step) const;
+    // Сохранение кадра; шаги, уже покрытые записью, пропускаются
+    void record(long long step, const PhysicsModel &model);
+    // Копия модели из ближайшего кадра не позже step
+    std::unique_ptr<PhysicsModel> restore(long long step, long long &keyframeStep) const;
+
+    // Новая правка на шаге step: записанное после него больше не
+    // соответствует прогону и отбрасывается
+    void recordEdits(long long step, const std::vector<ParameterEdit> &edits);
+    // Ближайший шаг с записанной правкой строго после step (или -1)
+    long long nextEditStep(long long step) const;
+    // Применение правок, записанных ровно на шаге step
+    void applyEdits(long long step, PhysicsModel &model) const;
+
+private:
+    // Интервал, с которым хранятся кадры возраста age шагов
+    static long long spacingForAge(long long age);
+    void thin();
+
+    struct Keyframe {
+        long long step = 0;
+        std::unique_ptr<PhysicsModel> model;
+    };
+
+    struct EditRecord {
+        long long step = 0;
+        std::vector<ParameterEdit> edits;
+    };
+
+    std::vector<Keyframe> keyframes;
+    std::vector<EditRecord> editRecords;
+    // Кадров, записанных после последнего прореживания
+    long long recordedSinceThin = 0;
+};
+
+#endif
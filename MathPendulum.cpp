@@ -1,13 +1,23 @@
 #include "MathPendulum.h"
 #include "mainwindow.h"
 #include "ui_MathPendulum.h"
+#include "FrameScheduler.h"
+#include "PhysicsWorker.h"
+#include "SceneRenderer.h"
+#include "SimulationControlBar.h"
+#include "TrajectoryCache.h"
+#include "FoucaultPendulum.h"
+#include "ComparisonView.h"
+#include "InputLatencyMonitor.h"
 #include <QMenuBar>
 #include <QMenu>
 #include <QAction>
 #include <QPainter>
+#include <QMouseEvent>
 #include <QDebug>
 #include <cmath>
 #include <QMessageBox>
+#include <QInputDialog>
 
 // Конструктор класса MathPendulum
 MathPendulum::MathPendulum(QWidget *parent) :
@@ -20,9 +30,13 @@ MathPendulum::MathPendulum(QWidget *parent) :
     menuBar = new QMenuBar(this);
     QMenu *fileMenu = menuBar->addMenu("Functions");
     QAction *startAction = new QAction("Start", this);
+    startAction->setObjectName("actionStart");
     QAction *pauseAction = new QAction("Pause", this);
+    pauseAction->setObjectName("actionPause");
     QAction *resetAction = new QAction("Reset", this);
+    resetAction->setObjectName("actionReset");
     QAction *exitAction = new QAction("Exit", this);
+    exitAction->setObjectName("actionExit");
     fileMenu->addAction(startAction);
     fileMenu->addAction(pauseAction);
     fileMenu->addAction(resetAction);
@@ -35,73 +49,330 @@ MathPendulum::MathPendulum(QWidget *parent) :
     connect(resetAction, &QAction::triggered, this, &MathPendulum::on_actionReset_triggered);
     connect(exitAction, &QAction::triggered, this, &MathPendulum::on_actionExit_triggered);
 
+    dampingSettings = defaultDampingSettings();
+    setupDampingMenu();
+
+    // Отрисовка сцены в фоновом потоке для больших экранов
+    QMenu *viewMenu = menuBar->addMenu("View");
+    QAction *backgroundRenderingAction = new QAction("Background rendering", this);
+    backgroundRenderingAction->setObjectName("actionBackgroundRendering");
+    backgroundRenderingAction->setCheckable(true);
+    viewMenu->addAction(backgroundRenderingAction);
+    connect(backgroundRenderingAction, &QAction::toggled, this, &MathPendulum::on_actionBackgroundRendering_toggled);
+    QAction *motionTrailAction = new QAction("Motion trail", this);
+    motionTrailAction->setObjectName("actionMotionTrail");
+    motionTrailAction->setCheckable(true);
+    viewMenu->addAction(motionTrailAction);
+    connect(motionTrailAction, &QAction::toggled, this, &MathPendulum::on_actionMotionTrail_toggled);
+
+    // Трехмерные модели с теми же параметрами маятника
+    QMenu *modelsMenu = menuBar->addMenu("Models");
+    QAction *foucaultAction = new QAction("Foucault pendulum...", this);
+    foucaultAction->setObjectName("actionFoucaultPendulum");
+    modelsMenu->addAction(foucaultAction);
+    connect(foucaultAction, &QAction::triggered, this, &MathPendulum::on_actionFoucaultPendulum_triggered);
+    QAction *compareAction = new QAction("Compare variants...", this);
+    compareAction->setObjectName("actionCompareVariants");
+    modelsMenu->addAction(compareAction);
+    connect(compareAction, &QAction::triggered, this, &MathPendulum::on_actionCompareVariants_triggered);
+
     QVBoxLayout *layout = new QVBoxLayout(this);
     layout->setMenuBar(menuBar);
 
-    // Подключение кнопок интерфейса
-    connect(ui->ButtonOKLength, &QPushButton::clicked, this, &MathPendulum::on_ButtonOKLength_clicked);
-    connect(ui->ButtonResetLength, &QPushButton::clicked, this, &MathPendulum::on_ButtonResetLength_clicked);
-    connect(ui->ButtonOKAngle, &QPushButton::clicked, this, &MathPendulum::on_ButtonOKAngle_clicked);
-    connect(ui->ButtonResetAngle, &QPushButton::clicked, this, &MathPendulum::on_ButtonResetAngle_clicked);
-    connect(ui->ButtonOKMass, &QPushButton::clicked, this, &MathPendulum::on_ButtonOKMass_clicked);
-    connect(ui->ButtonResetMass, &QPushButton::clicked, this, &MathPendulum::on_ButtonResetMass_clicked);
-    connect(ui->ButtonOKAirFriction, &QPushButton::clicked, this, &MathPendulum::on_ButtonOKAirFriction_clicked);
-    connect(ui->ButtonOffAirFriction, &QPushButton::clicked, this, &MathPendulum::on_ButtonOffAirFriction_clicked);
-
-    // Настройка таймера для анимации
-    timer = new QTimer(this);
-    connect(timer, &QTimer::timeout, this, &MathPendulum::updateAnimation);
+    // Кнопки ввода подключает setupUi по именам слотов on_<кнопка>_clicked
+    defineParameters();
+
+    // Кадры анимации запрашиваются только пока маятник движется;
+    // интегрирование идет в отдельном потоке
+    frameScheduler = new FrameScheduler(this);
+    connect(frameScheduler, &FrameScheduler::frame, this, &MathPendulum::updateAnimation);
+    physicsWorker = new PhysicsWorker(this);
+    sceneRenderer = new SceneRenderer(this);
+    connect(sceneRenderer, &SceneRenderer::frameReady, this, &MathPendulum::updatePendulum);
+    connect(physicsWorker, &PhysicsWorker::seekFinished, this, &MathPendulum::on_physicsWorker_seekFinished);
+
+    // Управление скоростью модельного времени в углу строки меню
+    controlBar = new SimulationControlBar(this);
+    menuBar->setCornerWidget(controlBar);
+    connect(controlBar, &SimulationControlBar::timeScaleChanged, this, &MathPendulum::on_controlBar_timeScaleChanged);
+    connect(controlBar, &SimulationControlBar::seekRequested, this, &MathPendulum::on_controlBar_seekRequested);
+    labelClock.start();
 
     // Начальные настройки интерфейса
     setInputsEnabled(true);
     ui->ButtonOffAirFriction->setStyleSheet("background-color: red");
+    updateDriveLabels();
 }
 
 // Деструктор класса
 MathPendulum::~MathPendulum() {
     delete ui;
+    delete foucaultPendulum;
+    delete comparisonView;
 }
 
-// Включение/отключение элементов ввода
+// Включение/отключение элементов ввода. Параметры, которые меняются на
+// ходу, остаются доступны; длина во время движения ограничена диапазоном
+// колебаний, чтобы шаг интегрирования оставался устойчивым.
 void MathPendulum::setInputsEnabled(bool enabled) {
-    ui->lengthInpEdit->setEnabled(enabled);
-    ui->AngleInpEdit->setEnabled(enabled);
-    ui->MassInpEdit->setEnabled(enabled);
-    ui->ButtonOKLength->setEnabled(enabled);
-    ui->ButtonResetLength->setEnabled(enabled);
-    ui->ButtonOKAngle->setEnabled(enabled);
-    ui->ButtonResetAngle->setEnabled(enabled);
-    ui->ButtonOKMass->setEnabled(enabled);
-    ui->ButtonResetMass->setEnabled(enabled);
+    const bool lengthEnabled = enabled || parameters.isLiveEditable(Parameter::Length);
+    const bool angleEnabled = enabled || parameters.isLiveEditable(Parameter::Angle);
+    const bool massEnabled = enabled || parameters.isLiveEditable(Parameter::Mass);
+    parameters.setRange(Parameter::Length, enabled ? MIN_LENGTH : MIN_OSCILLATION_LENGTH,
+                        enabled ? MAX_LENGTH : MAX_OSCILLATION_LENGTH);
+
+    ui->lengthInpEdit->setEnabled(lengthEnabled);
+    ui->AngleInpEdit->setEnabled(angleEnabled);
+    ui->MassInpEdit->setEnabled(massEnabled);
+    ui->ButtonOKLength->setEnabled(lengthEnabled);
+    ui->ButtonResetLength->setEnabled(lengthEnabled);
+    ui->ButtonOKAngle->setEnabled(angleEnabled);
+    ui->ButtonResetAngle->setEnabled(angleEnabled);
+    ui->ButtonOKMass->setEnabled(massEnabled);
+    ui->ButtonResetMass->setEnabled(massEnabled);
     ui->ButtonOKAirFriction->setEnabled(enabled);
     ui->ButtonOffAirFriction->setEnabled(enabled);
+    dampingMenu->setEnabled(enabled);
+}
+
+// Меню выбора нелинейных сил сопротивления
+void MathPendulum::setupDampingMenu() {
+    dampingMenu = menuBar->addMenu("Damping");
+    quadraticDragAction = new QAction("Quadratic drag", this);
+    quadraticDragAction->setObjectName("actionQuadraticDrag");
+    quadraticDragAction->setCheckable(true);
+    dryFrictionAction = new QAction("Dry (Coulomb) friction", this);
+    dryFrictionAction->setObjectName("actionDryFriction");
+    dryFrictionAction->setCheckable(true);
+    QAction *coefficientsAction = new QAction("Set coefficients...", this);
+    coefficientsAction->setObjectName("actionDampingCoefficients");
+    dampingMenu->addAction(quadraticDragAction);
+    dampingMenu->addAction(dryFrictionAction);
+    dampingMenu->addSeparator();
+    dampingMenu->addAction(coefficientsAction);
+
+    connect(quadraticDragAction, &QAction::toggled, this, &MathPendulum::on_actionQuadraticDrag_toggled);
+    connect(dryFrictionAction, &QAction::toggled, this, &MathPendulum::on_actionDryFriction_toggled);
+    connect(coefficientsAction, &QAction::triggered, this, &MathPendulum::on_actionDampingCoefficients_triggered);
 }
 
-// Отрисовка маятника
+// Значения коэффициентов сопротивления по умолчанию (все силы выключены)
+DampingSettings MathPendulum::defaultDampingSettings() const {
+    DampingSettings settings;
+    settings.linearCoeff = DEFAULT_LINEAR_DRAG;
+    settings.quadraticCoeff = DEFAULT_QUADRATIC_DRAG;
+    settings.dryLevel = DEFAULT_DRY_FRICTION;
+    return settings;
+}
+
+// Отрисовка маятника. В режиме фоновой отрисовки сцена растеризуется в
+// потоке SceneRenderer, а здесь выводится последний готовый кадр; новый
+// кадр заказывается только при изменении сцены.
 void MathPendulum::paintEvent(QPaintEvent *pEvent) {
     QWidget::paintEvent(pEvent);
     QPainter painter(this);
+    Scene scene = currentScene();
+
+    // Изображение сцены прозрачно вне маятника, поэтому след рисуется под ним
+    if (motionTrailEnabled) {
+        motionTrail.draw(painter);
+    }
+
+    // Перетаскиваемый груз рисуется сразу: готовый кадр из потока
+    // отрисовки отставал бы от указателя еще на кадр
+    if (!backgroundRendering || bobDrag.isActive()) {
+        drawScene(painter, scene);
+    } else {
+        if (scene != submittedScene) {
+            submittedScene = scene;
+            sceneRenderer->submit(size(), devicePixelRatioF(),
+                                  [scene](QPainter &imagePainter) { drawScene(imagePainter, scene); });
+        }
+
+        const QImage &frame = sceneRenderer->latestFrame();
+        if (frame.isNull()) {
+            // Первый кадр еще не готов
+            drawScene(painter, scene);
+        } else {
+            painter.drawImage(0, 0, frame);
+        }
+    }
+
+    InputLatencyMonitor &latencyMonitor = InputLatencyMonitor::instance();
+    latencyMonitor.drawOverlay(painter, rect());
+    latencyMonitor.frameDrawn();
+}
+
+// Параметры сцены на текущий момент
+MathPendulum::Scene MathPendulum::currentScene() const {
+    Scene scene;
+    scene.width = width();
+    scene.height = height();
+    scene.length = length;
+    scene.angle = angle;
+    scene.supportHeight = supportHeight;
+    scene.driveEnabled = driveEnabled;
+    if (driveEnabled) {
+        // Подвес движется по y = a·cos(Ωt) вверх, на экране ось y вниз
+        scene.driveRange = driveAmplitudeRatio * pixelLength(scene);
+        scene.pivotOffset = -scene.driveRange * cos(drivePhase);
+    }
+    return scene;
+}
+
+// Рисование маятника; не обращается к членам виджета, поэтому может
+// выполняться в потоке отрисовки
+void MathPendulum::drawScene(QPainter &painter, const Scene &scene) {
     painter.setRenderHint(QPainter::Antialiasing);
     painter.setPen(Qt::blue);
     painter.setBrush(QBrush(Qt::white));
 
-    int width = this->width();
-    int height = this->height();
-    int pivotX = width / 2;
-    int pivotY = height / 6 - supportHeight;
+    QPoint pivot = pivotPosition(scene);
+    int pivotX = pivot.x();
+    int pivotY = pivot.y();
+
+    const int bobRadius = BOB_RADIUS;
 
-    const int pendulumLength = length * 11;
-    const int bobRadius = 20;
+    QPoint bob = bobPosition(scene);
+    int bobX = bob.x();
+    int bobY = bob.y();
 
-    double angleRad = angle * DEG_TO_RAD;
-    int bobX = pivotX + pendulumLength * sin(angleRad);
-    int bobY = pivotY + pendulumLength * cos(angleRad);
+    // Направляющая вибрирующего подвеса
+    if (scene.driveEnabled) {
+        int centerY = pivotY - qRound(scene.pivotOffset);
+        int range = qRound(scene.driveRange);
+        painter.drawLine(pivotX, centerY - range - 5, pivotX, centerY + range + 5);
+    }
 
     painter.drawLine(pivotX - 10, pivotY, pivotX + 10, pivotY);
     painter.drawLine(pivotX, pivotY, bobX, bobY);
     painter.drawEllipse(bobX - bobRadius, bobY - bobRadius, bobRadius * 2, bobRadius * 2);
 }
 
+// Положение точки подвеса на экране. С вибрирующим подвесом маятник
+// может стоять вверх ногами, поэтому подвес опускается к середине экрана.
+QPoint MathPendulum::pivotPosition(const Scene &scene) {
+    int pivotX = scene.width / 2;
+    if (scene.driveEnabled) {
+        return QPoint(pivotX, scene.height * 2 / 5 + qRound(scene.pivotOffset));
+    }
+    return QPoint(pivotX, scene.height / 6 - scene.supportHeight);
+}
+
+// Длина нити на экране
+int MathPendulum::pixelLength(const Scene &scene) {
+    int pendulumLength = scene.length * 11;
+    if (scene.driveEnabled) {
+        pendulumLength = qMin(pendulumLength, scene.height / 3);
+    }
+    return pendulumLength;
+}
+
+// Положение центра груза на экране
+QPoint MathPendulum::bobPosition(const Scene &scene) {
+    QPoint pivot = pivotPosition(scene);
+    const int pendulumLength = pixelLength(scene);
+
+    double angleRad = scene.angle * M_PI / 180.0;
+    return QPoint(pivot.x() + pendulumLength * sin(angleRad), pivot.y() + pendulumLength * cos(angleRad));
+}
+
+// Угол нити, направленной из точки подвеса на point (градусы)
+double MathPendulum::pointerAngle(const QPointF &point) const {
+    QPoint pivot = pivotPosition(currentScene());
+    return atan2(point.x() - pivot.x(), point.y() - pivot.y()) * RAD_TO_DEG;
+}
+
+// Захват груза мышью или касанием (касание приходит как событие мыши).
+// Поток физики останавливается, груз следует за указателем, а кадры
+// продолжают идти: след и энергии обновляются вживую.
+void MathPendulum::mousePressEvent(QMouseEvent *event) {
+    QPointF offset = pointerPosition(event) - QPointF(bobPosition(currentScene()));
+    if (event->button() != Qt::LeftButton || bobDrag.isActive() ||
+        hypot(offset.x(), offset.y()) > BOB_RADIUS + GRAB_MARGIN) {
+        QWidget::mousePressEvent(event);
+        return;
+    }
+
+    physicsWorker->stopSimulation();
+    isPaused = false;
+    isSettled = false;
+    angularVelocity = 0.0;
+    dragAngleOffset = angle - pointerAngle(pointerPosition(event));
+    bobDrag.start(angle, event->timestamp());
+    frameScheduler->start();
+    labelClock.restart();
+    event->accept();
+}
+
+// Груз переставляется сразу при обработке события, кадр покажет его без
+// ожидания потока физики. Qt сжимает подряд идущие перемещения, поэтому
+// при занятом потоке интерфейса обрабатывается только последнее.
+void MathPendulum::mouseMoveEvent(QMouseEvent *event) {
+    if (!bobDrag.isActive()) {
+        QWidget::mouseMoveEvent(event);
+        return;
+    }
+
+    const ParameterSpec &spec = parameters.spec(Parameter::Angle);
+    double target = remainder(pointerAngle(pointerPosition(event)) + dragAngleOffset, 360.0);
+    angle = qBound(spec.minimum, target, spec.maximum);
+    bobDrag.addSample(angle, event->timestamp());
+    angularVelocity = bobDrag.velocity();
+    InputLatencyMonitor::instance().inputHandled();
+    updatePendulum();
+}
+
+void MathPendulum::mouseReleaseEvent(QMouseEvent *event) {
+    if (!bobDrag.isActive() || event->button() != Qt::LeftButton) {
+        QWidget::mouseReleaseEvent(event);
+        return;
+    }
+
+    bobDrag.addSample(angle, event->timestamp());
+    angularVelocity = bobDrag.velocity();
+    bobDrag.stop();
+    releaseBob();
+}
+
+// Запуск движения из точки отпускания со скоростью отпускания. Скорость
+// ограничена так, чтобы груз не поднимался выше допустимого угла, у
+// которого ядро его останавливает.
+void MathPendulum::releaseBob() {
+    const double maxAngle = parameters.spec(Parameter::Angle).maximum;
+    const double heightReserve = qMax(0.0, cos(angle * DEG_TO_RAD) - cos(maxAngle * DEG_TO_RAD));
+    const double maxVelocity = sqrt(2 * gravity / lengthForCalculations * heightReserve) * RAD_TO_DEG;
+    angularVelocity = qBound(-maxVelocity, angularVelocity, maxVelocity);
+    ui->AngleInpEdit->setPlainText(QString::number(angle, 'f', 2));
+
+    // Вне диапазона колебаний груз остается там, где его отпустили
+    const bool canOscillate = lengthForCalculations >= MIN_OSCILLATION_LENGTH &&
+                              lengthForCalculations <= MAX_OSCILLATION_LENGTH;
+    if (!canOscillate) {
+        angularVelocity = 0.0;
+    }
+
+    totalMechanicalEnergy = calculateCurrentKineticEnergy() + calculateCurrentPotentialEnergy();
+    initialMechanicalEnergy = totalMechanicalEnergy;
+    dissipatedEnergy = 0.0;
+    // Амплитуда — угол, на котором вся энергия становится потенциальной
+    double cosAmplitude = 1.0 - totalMechanicalEnergy / (mass * gravity * lengthForCalculations);
+    initialAngle = acos(qBound(-1.0, cosAmplitude, 1.0)) * RAD_TO_DEG;
+    initialPeriod = calculatePeriod();
+    ui->OutputPeriodValue->setText(QString::number(initialPeriod, 'f', 6));
+    updateOutputValues();
+
+    if (!canOscillate || (qFuzzyIsNull(angle) && qFuzzyIsNull(angularVelocity))) {
+        frameScheduler->stop();
+        updatePendulum();
+        return;
+    }
+
+    setInputsEnabled(false);
+    physicsWorker->startSimulation(createPhysicsModel(), simulationStep());
+    frameScheduler->start();
+}
+
 // Обновление отрисовки маятника
 void MathPendulum::updatePendulum() {
     this->update();
@@ -109,7 +380,7 @@ void MathPendulum::updatePendulum() {
 
 // Запуск анимации маятника
 void MathPendulum::startAnimation() {
-    if (timer->isActive() && !isPaused) {
+    if ((frameScheduler->isActive() || isSettled) && !isPaused) {
         return;
     }
 
@@ -122,11 +393,13 @@ void MathPendulum::startAnimation() {
     }
 
     // Проверка диапазона длины для колебаний
-    if (lengthForCalculations < 0.05 || lengthForCalculations > 1000.0) {
+    if (lengthForCalculations < MIN_OSCILLATION_LENGTH || lengthForCalculations > MAX_OSCILLATION_LENGTH) {
         angularVelocity = 0.0;
         initialAngle = fabs(angle);
         initialPeriod = calculatePeriod();
         totalMechanicalEnergy = calculateCurrentPotentialEnergy();
+        initialMechanicalEnergy = totalMechanicalEnergy;
+        dissipatedEnergy = 0.0;
 
         ui->OutputPeriodValue->setText(QString::number(initialPeriod, 'f', 6));
         updateOutputValues();
@@ -138,7 +411,8 @@ void MathPendulum::startAnimation() {
     }
 
     if (isPaused) {
-        timer->start(16);
+        physicsWorker->resumeSimulation();
+        frameScheduler->start();
         isPaused = false;
         return;
     }
@@ -147,28 +421,193 @@ void MathPendulum::startAnimation() {
     initialAngle = fabs(angle);
     initialPeriod = calculatePeriod();
     totalMechanicalEnergy = calculateCurrentPotentialEnergy();
+    initialMechanicalEnergy = totalMechanicalEnergy;
+    dissipatedEnergy = 0.0;
     ui->OutputPeriodValue->setText(QString::number(initialPeriod, 'f', 6));
     updateOutputValues();
-    timer->start(16);
+    physicsWorker->startSimulation(createPhysicsModel(), simulationStep());
+    frameScheduler->start();
 }
 
-// Обновление анимации (вызывается таймером)
-void MathPendulum::updateAnimation() {
-    double alpha = -gravity / lengthForCalculations * sin(angle * DEG_TO_RAD) * RAD_TO_DEG;
-
-    if (airFrictionEnabled) {
-        alpha -= airFrictionCoeff * angularVelocity;
+// Обновление анимации (вызывается на каждом кадре).
+// Физика считается в потоке PhysicsWorker; здесь только читается
+// последний опубликованный снимок состояния. Положение интерполируется
+// на текущий момент модельного времени, так что замедленное время
+// остается плавным без пересчета.
+void MathPendulum::updateAnimation(double elapsedSeconds) {
+    // Во время перетаскивания состояние задает указатель, физика стоит
+    if (bobDrag.isActive()) {
+        totalMechanicalEnergy = calculateCurrentKineticEnergy() + calculateCurrentPotentialEnergy();
+        if (motionTrailEnabled) {
+            motionTrail.addPoint(bobPosition(currentScene()), elapsedSeconds, size(), devicePixelRatioF());
+            updatePendulum();
+        }
+        if (labelClock.hasExpired(LABEL_UPDATE_INTERVAL_MS)) {
+            updateOutputValues();
+            labelClock.restart();
+        }
+        return;
     }
 
-    angularVelocity += alpha * 0.016;
-    angle += angularVelocity * 0.016;
+    const PhysicsSnapshot &snapshot = physicsWorker->latestSnapshot();
+    const double displayTime = physicsWorker->simulatedTimeNow();
+    angle = interpolateState(snapshot, 0, displayTime);
+    angularVelocity = interpolateState(snapshot, 1, displayTime);
+    if (driveEnabled) {
+        // Фазу не интерполируем: она приведена к [0, 2π)
+        drivePhase = snapshot.state[2];
+    }
+    dissipatedEnergy = snapshot.dissipatedEnergy;
+    // После правки параметра энергия отсчитывается от точного состояния
+    // шага, с которого модель продолжила движение с новыми параметрами
+    if (energyRevision > 0 && snapshot.parameterRevision >= energyRevision) {
+        initialMechanicalEnergy = mechanicalEnergy(snapshot.state[0], snapshot.state[1]) + dissipatedEnergy;
+        energyRevision = 0;
+    }
+    totalMechanicalEnergy = initialMechanicalEnergy - dissipatedEnergy;
 
-    // Ограничение угла отклонения
-    if (angle > 90) angle = 90;
-    if (angle < -90) angle = -90;
+    if (motionTrailEnabled) {
+        motionTrail.addPoint(bobPosition(currentScene()), elapsedSeconds, size(), devicePixelRatioF());
+    }
 
     updatePendulum();
-    updateOutputValues();
+
+    // При ускоренном времени подписи обновляются не на каждом кадре
+    bool atRest = isAtRest(snapshot.stuckByFriction);
+    if (atRest || controlBar->timeScale() <= 1.0 || labelClock.hasExpired(LABEL_UPDATE_INTERVAL_MS)) {
+        updateOutputValues();
+        updateSpectrumValues(snapshot.spectrum);
+        controlBar->setTimeline(qMin(displayTime, snapshot.simulatedTime), physicsWorker->recordedTime());
+        labelClock.restart();
+    }
+
+    // Затухшие или залипшие колебания больше не требуют кадров. Поток
+    // физики только приостанавливается, чтобы прогон можно было перемотать.
+    if (atRest) {
+        physicsWorker->pauseSimulation();
+        frameScheduler->stop();
+        isSettled = true;
+    }
+}
+
+// Проверка, что сопротивление погасило колебания или сухое трение
+// удерживает груз в покое
+bool MathPendulum::isAtRest(bool stuckByFriction) {
+    if (!dampingSettings.anyEnabled()) {
+        return false;
+    }
+    if (stuckByFriction) {
+        return true;
+    }
+    double energy = calculateCurrentKineticEnergy() + calculateCurrentPotentialEnergy();
+    return energy <= REST_ENERGY_FRACTION * initialMechanicalEnergy;
+}
+
+// Ядро уравнений движения с текущими параметрами маятника
+template <typename Damping>
+MathPendulumKernel<DoublePrecision, Damping> MathPendulum::physicsKernel(const Damping &damping) const {
+    MathPendulumKernel<DoublePrecision, Damping> kernel;
+    kernel.gravity = gravity;
+    kernel.length = lengthForCalculations;
+    kernel.mass = mass;
+    kernel.damping = damping;
+    return kernel;
+}
+
+// Ядро маятника с вибрирующим подвесом
+template <bool Averaged, typename Damping>
+KapitzaPendulumKernel<DoublePrecision, Averaged, Damping> MathPendulum::drivenKernel(const Damping &damping) const {
+    KapitzaPendulumKernel<DoublePrecision, Averaged, Damping> kernel;
+    kernel.gravity = gravity;
+    kernel.length = lengthForCalculations;
+    kernel.mass = mass;
+    kernel.driveAmplitude = driveAmplitudeRatio * lengthForCalculations;
+    kernel.driveFrequency = driveFrequencyRatio * naturalFrequency();
+    kernel.damping = damping;
+    return kernel;
+}
+
+// Шаг интегрирования: короткий период требует более мелкого шага.
+// С вибрирующим подвесом медленное движение задает шаг усредненной
+// модели, а полной модели нужен еще и период подвеса.
+double MathPendulum::simulationStep() const {
+    if (driveEnabled) {
+        double step = qMin(SIMULATION_STEP, 2 * M_PI / slowFrequency() / STEPS_PER_PERIOD);
+        if (!isDriveAveraged()) {
+            double driveFrequency = driveFrequencyRatio * naturalFrequency();
+            step = qMin(step, 2 * M_PI / driveFrequency / DRIVE_STEPS_PER_PERIOD);
+        }
+        return step;
+    }
+    return qMin(SIMULATION_STEP, initialPeriod / STEPS_PER_PERIOD);
+}
+
+// Собственная частота малых колебаний (рад/с)
+double MathPendulum::naturalFrequency() const {
+    return sqrt(gravity / lengthForCalculations);
+}
+
+// Частота малых колебаний около нижнего положения в эффективном
+// потенциале Капицы: ω² = g/L + (aΩ)²/(2L²)
+double MathPendulum::slowFrequency() const {
+    double drive = driveAmplitudeRatio * driveFrequencyRatio * naturalFrequency();
+    return sqrt(gravity / lengthForCalculations + 0.5 * drive * drive);
+}
+
+// Выбор усредненной модели: вибрация много быстрее медленного движения
+bool MathPendulum::isDriveAveraged() const {
+    double driveFrequency = driveFrequencyRatio * naturalFrequency();
+    return driveFrequency >= MIN_AVERAGING_RATIO * slowFrequency() &&
+           driveAmplitudeRatio <= MAX_AVERAGING_AMPLITUDE;
+}
+
+// Движение из покоя без нелинейного сопротивления берется из кэша
+// безразмерных траекторий
+bool MathPendulum::usesTrajectoryCache() const {
+    return !driveEnabled && qFuzzyIsNull(angularVelocity) &&
+           !dampingSettings.quadraticEnabled && !dampingSettings.dryEnabled;
+}
+
+// Модель для потока физики с текущими параметрами и состоянием маятника.
+// Модель сопротивления выбирается здесь, один раз на запуск.
+// Движение из покоя с линейным сопротивлением (или без него) берется из
+// кэша безразмерных траекторий: одна таблица подходит для любых длины и
+// массы.
+std::unique_ptr<PhysicsModel> MathPendulum::createPhysicsModel() const {
+    if (driveEnabled) {
+        KapitzaPendulumState<DoublePrecision> state;
+        state.angle = angle;
+        state.angularVelocity = angularVelocity;
+        state.drivePhase = drivePhase;
+
+        std::unique_ptr<PhysicsModel> model;
+        const bool averaged = isDriveAveraged();
+        withDampingModel<double>(dampingSettings, [&](const auto &damping) {
+            if (averaged) {
+                model = makeKernelModel(drivenKernel<true>(damping), state);
+            } else {
+                model = makeKernelModel(drivenKernel<false>(damping), state);
+            }
+        });
+        return model;
+    }
+
+    if (usesTrajectoryCache()) {
+        double normalizedDamping = dampingSettings.linearEnabled
+            ? dampingSettings.linearCoeff * sqrt(lengthForCalculations / gravity) : 0.0;
+        return std::make_unique<CachedTrajectoryModel>(angle * DEG_TO_RAD, normalizedDamping,
+                                                        gravity, lengthForCalculations, mass);
+    }
+
+    MathPendulumState<DoublePrecision> state;
+    state.angle = angle;
+    state.angularVelocity = angularVelocity;
+
+    std::unique_ptr<PhysicsModel> model;
+    withDampingModel<double>(dampingSettings, [&](const auto &damping) {
+        model = makeKernelModel(physicsKernel(damping), state);
+    });
+    return model;
 }
 
 // Расчет высоты подъема груза
@@ -186,14 +625,14 @@ double MathPendulum::calculateCurrentPotentialEnergy() {
     return mass * gravity * calculateHeight();
 }
 
-// Расчет периода колебаний
+// Расчет периода колебаний по амплитуде initialAngle
 double MathPendulum::calculatePeriod() {
     const double smallAngleThreshold = 20.0; // Порог в градусах
 
-    if (fabs(angle) <= smallAngleThreshold) {
+    if (initialAngle <= smallAngleThreshold) {
         return 2 * M_PI * sqrt(lengthForCalculations / gravity);
     } else {
-        double theta0 = fabs(angle); // В градусах
+        double theta0 = initialAngle; // В градусах
         double theta0Rad = theta0 * DEG_TO_RAD;
         double theta0Squared = theta0Rad * theta0Rad;
 
@@ -202,6 +641,12 @@ double MathPendulum::calculatePeriod() {
     }
 }
 
+// Механическая энергия в заданном состоянии при текущих длине и массе
+double MathPendulum::mechanicalEnergy(double stateAngle, double stateAngularVelocity) const {
+    double speed = stateAngularVelocity * DEG_TO_RAD * lengthForCalculations;
+    return 0.5 * mass * speed * speed + mass * gravity * lengthForCalculations * (1 - cos(stateAngle * DEG_TO_RAD));
+}
+
 // Расчет скорости груза
 double MathPendulum::calculateVelocity() {
     return sqrt(2 * calculateCurrentKineticEnergy()/mass);
@@ -225,121 +670,275 @@ void MathPendulum::updateOutputValues() {
     ui->OutputHighValue->setText(QString::number(calculateHeight(), 'f', 6));
 }
 
-// Обработчики событий кнопок
-void MathPendulum::on_ButtonOKLength_clicked() {
-    QString Datal = ui->lengthInpEdit->toPlainText();
-    bool ok;
-    double newLength = Datal.toDouble(&ok);
+// Измеренные по живому сигналу период, гармоники и затухание
+void MathPendulum::updateSpectrumValues(const SpectralEstimate &spectrum) {
+    if (spectrum.periodValid) {
+        ui->OutputMeasuredPeriodValue->setText(QString::number(spectrum.period, 'f', 6));
+    }
+    if (spectrum.harmonicsValid) {
+        ui->OutputHarmonicsValue->setText(QString::number(spectrum.harmonicDistortion, 'e', 3));
+    }
+    if (spectrum.dampingValid) {
+        ui->OutputDampingRateValue->setText(QString::number(spectrum.dampingRate, 'e', 3));
+    }
+}
+
+// Описание вводимых параметров; значения по умолчанию записываются в поля
+void MathPendulum::defineParameters() {
+    parameters.define(Parameter::Length, {"Length", "m", MIN_LENGTH, MAX_LENGTH, 10.0, true},
+                      lengthForCalculations);
+    parameters.define(Parameter::Angle, {"Angle", "deg", -90.0, 90.0, 0.0, false}, angle);
+    parameters.define(Parameter::Mass, {"Mass", "kg", MIN_MASS, MAX_MASS, 1.0, true}, mass);
+    updateDisplayLength();
+}
 
-    if (!ok || newLength <= 0) {
-        QMessageBox::warning(this, "Error", "Length should be positive value!");
+// Единый путь ввода: проверка реестром, затем применение
+void MathPendulum::editParameter(Parameter parameter, const QString &text) {
+    QString error;
+    if (!parameters.set(parameter, text, error)) {
+        QMessageBox::warning(this, "Warning", error);
         return;
     }
+    applyParameterChange(parameter);
+}
 
-    if (newLength > MAX_LENGTH || newLength < MIN_LENGTH) {
-        QMessageBox::warning(this, "Warning",
-                             QString("Value of the length should be in range: [ %1, %2 ] m!").arg(MIN_LENGTH).arg(MAX_LENGTH));
-        return;
+// Применение нового значения. Во время движения правка уходит в поток
+// физики и вступает в силу на ближайшей границе шага. Все модели при этом
+// сохраняют угол и угловую скорость. Энергия отсчитывается заново от
+// состояния после правки, как только придет снимок с ним; до тех пор она
+// оценивается по показанному состоянию.
+void MathPendulum::applyParameterChange(Parameter parameter) {
+    if (parameter == Parameter::Length) {
+        updateDisplayLength();
+        updateDriveLabels();
     }
 
-    if (newLength > 50) {
-        lengthForCalculations = newLength;
-        length = 50;
-    } else {
-        if (newLength < 3) {
-            lengthForCalculations = newLength;
-            length = 3;
-        } else {
-            lengthForCalculations = newLength;
-            length = newLength;
+    if (physicsWorker->isRunning() && parameters.isLiveEditable(parameter)) {
+        // При вибрации подвеса длина задает интегратор и шаг
+        if (parameter == Parameter::Length && driveEnabled) {
+            restartPhysicsModel();
+            return;
         }
+
+        PhysicsParameter physicsParameter = parameter == Parameter::Length ? PhysicsParameter::Length
+                                                                           : PhysicsParameter::Mass;
+        energyRevision = physicsWorker->queueParameterEdits({{physicsParameter, parameters.value(parameter)}});
+        initialMechanicalEnergy = calculateCurrentKineticEnergy() + calculateCurrentPotentialEnergy() + dissipatedEnergy;
+        totalMechanicalEnergy = initialMechanicalEnergy - dissipatedEnergy;
+        updateOutputValues();
     }
     updatePendulum();
 }
 
+// Длина на экране ограничена, в расчетах используется введенная
+void MathPendulum::updateDisplayLength() {
+    if (lengthForCalculations > 50) {
+        length = 50;
+    } else if (lengthForCalculations < 3) {
+        length = 3;
+    } else {
+        length = lengthForCalculations;
+    }
+}
+
+// Обработчики событий кнопок
+void MathPendulum::on_ButtonOKLength_clicked() {
+    editParameter(Parameter::Length, ui->lengthInpEdit->toPlainText());
+}
+
 void MathPendulum::on_ButtonResetLength_clicked() {
-    length = DEFAULT_Y_OFFSET;
+    parameters.reset(Parameter::Length);
     ui->lengthInpEdit->clear();
-    updatePendulum();
+    applyParameterChange(Parameter::Length);
 }
 
 void MathPendulum::on_ButtonOKAngle_clicked() {
-    QString DataAngle = ui->AngleInpEdit->toPlainText();
-    bool ok;
-    double newAngle = DataAngle.toDouble(&ok);
-
-    if (!ok || newAngle < -90 || newAngle > 90) {
-        QMessageBox::warning(this, "Warning",
-                             "Angle should be in range [ -90, 90 ]!");
-        return;
-    }
-    angle = newAngle;
-    updatePendulum();
+    editParameter(Parameter::Angle, ui->AngleInpEdit->toPlainText());
 }
 
 void MathPendulum::on_ButtonResetAngle_clicked() {
-    angle = 0;
+    parameters.reset(Parameter::Angle);
     ui->AngleInpEdit->clear();
-    updatePendulum();
+    applyParameterChange(Parameter::Angle);
 }
 
 void MathPendulum::on_ButtonOKMass_clicked() {
-    QString DataMass = ui->MassInpEdit->toPlainText();
-    bool ok;
-    double newMass = DataMass.toDouble(&ok);
-
-    if (!ok || newMass < MIN_MASS || newMass > MAX_MASS) {
-        QMessageBox::warning(this, "Warning",
-                             QString("Mass should be in range: [ %1, %2] kg!").arg(MIN_MASS).arg(MAX_MASS));
-        return;
-    }
-    mass = newMass;
+    editParameter(Parameter::Mass, ui->MassInpEdit->toPlainText());
 }
 
 void MathPendulum::on_ButtonResetMass_clicked() {
-    mass = 1.0;
+    parameters.reset(Parameter::Mass);
     ui->MassInpEdit->clear();
+    applyParameterChange(Parameter::Mass);
 }
 
 void MathPendulum::on_ButtonOKAirFriction_clicked() {
-    airFrictionEnabled = true;
+    dampingSettings.linearEnabled = true;
     ui->ButtonOKAirFriction->setStyleSheet("background-color: green");
     ui->ButtonOffAirFriction->setStyleSheet("");
 }
 
 void MathPendulum::on_ButtonOffAirFriction_clicked() {
-    airFrictionEnabled = false;
+    dampingSettings.linearEnabled = false;
     ui->ButtonOKAirFriction->setStyleSheet("");
     ui->ButtonOffAirFriction->setStyleSheet("background-color: red");
 }
 
+// Обработчики меню сопротивления
+void MathPendulum::on_actionQuadraticDrag_toggled(bool checked) {
+    dampingSettings.quadraticEnabled = checked;
+}
+
+void MathPendulum::on_actionDryFriction_toggled(bool checked) {
+    dampingSettings.dryEnabled = checked;
+}
+
+void MathPendulum::on_actionDampingCoefficients_triggered() {
+    bool ok;
+    double linear = QInputDialog::getDouble(this, "Damping", "Linear drag coefficient [1/s]:",
+                                            dampingSettings.linearCoeff, 0.0, 1000.0, 6, &ok);
+    if (!ok) return;
+    double quadratic = QInputDialog::getDouble(this, "Damping", "Quadratic drag coefficient [1/deg]:",
+                                               dampingSettings.quadraticCoeff, 0.0, 1000.0, 6, &ok);
+    if (!ok) return;
+    double dry = QInputDialog::getDouble(this, "Damping", "Dry friction level [deg/s^2]:",
+                                         dampingSettings.dryLevel, 0.0, 1000.0, 6, &ok);
+    if (!ok) return;
+
+    dampingSettings.linearCoeff = linear;
+    dampingSettings.quadraticCoeff = quadratic;
+    dampingSettings.dryLevel = dry;
+}
+
+// Подписи вибрации подвеса: значения ползунков, частота в герцах,
+// выбранный интегратор и устойчивость верхнего положения ((aΩ)² > 2gL)
+void MathPendulum::updateDriveLabels() {
+    double driveFrequency = driveFrequencyRatio * naturalFrequency();
+    ui->DriveAmplitudeValue->setText(QString::number(driveAmplitudeRatio, 'f', 3));
+    ui->DriveFrequencyValue->setText(QString::number(driveFrequencyRatio, 'f', 1) + "x (" +
+                                     QString::number(driveFrequency / (2 * M_PI), 'f', 2) + " Hz)");
+
+    double stability = driveAmplitudeRatio * driveFrequencyRatio;
+    QString mode = isDriveAveraged() ? "Averaged" : "Full step";
+    QString inverted = stability * stability > 2.0 ? "inverted stable" : "inverted unstable";
+    ui->DriveModeLabel->setText(mode + ", " + inverted);
+}
+
+// Параметры вибрации меняются на ходу
+void MathPendulum::applyDriveChange() {
+    updateDriveLabels();
+    restartPhysicsModel();
+}
+
+// Модель пересоздается из текущего состояния, при этом заново выбирается
+// интегратор и шаг
+void MathPendulum::restartPhysicsModel() {
+    if (!frameScheduler->isActive() && !isPaused) {
+        updatePendulum();
+        return;
+    }
+
+    initialMechanicalEnergy = calculateCurrentKineticEnergy() + calculateCurrentPotentialEnergy();
+    totalMechanicalEnergy = initialMechanicalEnergy;
+    dissipatedEnergy = 0.0;
+    physicsWorker->startSimulation(createPhysicsModel(), simulationStep());
+    if (isPaused) {
+        physicsWorker->pauseSimulation();
+    }
+}
+
+// Положение логарифмического ползунка для отношения ratio
+int MathPendulum::driveSliderValue(double ratio) const {
+    return static_cast<int>(lround(log10(ratio) * DRIVE_SLIDER_STEPS_PER_DECADE));
+}
+
+void MathPendulum::on_DriveEnabledCheck_toggled(bool checked) {
+    driveEnabled = checked;
+    drivePhase = 0.0;
+    // Верхнее положение доступно только с вибрирующим подвесом; без
+    // вибрации угол снова ограничен нижней полуплоскостью
+    const double maxAngle = checked ? 180.0 : 90.0;
+    parameters.setRange(Parameter::Angle, -maxAngle, maxAngle);
+    if (!checked && fabs(angle) > 90.0) {
+        angle = angle > 0 ? 90.0 : -90.0;
+    }
+    applyDriveChange();
+}
+
+void MathPendulum::on_DriveAmplitudeSlider_valueChanged(int value) {
+    driveAmplitudeRatio = pow(10.0, static_cast<double>(value) / DRIVE_SLIDER_STEPS_PER_DECADE);
+    applyDriveChange();
+}
+
+void MathPendulum::on_DriveFrequencySlider_valueChanged(int value) {
+    driveFrequencyRatio = pow(10.0, static_cast<double>(value) / DRIVE_SLIDER_STEPS_PER_DECADE);
+    applyDriveChange();
+}
+
+// Маятник Фуко с текущими длиной, углом и массой
+void MathPendulum::on_actionFoucaultPendulum_triggered() {
+    if (qFuzzyIsNull(angle)) {
+        QMessageBox::warning(this, "Error", "Please enter angle value first!");
+        return;
+    }
+
+    delete foucaultPendulum;
+    foucaultPendulum = new FoucaultPendulum(lengthForCalculations, angle, mass);
+    foucaultPendulum->show();
+}
+
+// Варианты маятника с текущими длиной и углом в одном окне; вариант с
+// сопротивлением берет текущий коэффициент линейного сопротивления
+void MathPendulum::on_actionCompareVariants_triggered() {
+    if (qFuzzyIsNull(angle)) {
+        QMessageBox::warning(this, "Error", "Please enter angle value first!");
+        return;
+    }
+
+    delete comparisonView;
+    comparisonView = new ComparisonView(lengthForCalculations, angle, dampingSettings.linearCoeff);
+    comparisonView->show();
+}
+
 // Обработчики событий меню
 void MathPendulum::on_actionStart_triggered() {
     startAnimation();
 }
 
 void MathPendulum::on_actionPause_triggered() {
-    if (timer->isActive()) {
-        timer->stop();
+    if (frameScheduler->isActive()) {
+        physicsWorker->pauseSimulation();
+        frameScheduler->stop();
         isPaused = true;
     } else if (isPaused) {
-        timer->start(16);
+        physicsWorker->resumeSimulation();
+        frameScheduler->start();
         isPaused = false;
     }
 }
 
 void MathPendulum::on_actionReset_triggered() {
     // Сброс всех параметров к начальным значениям
-    timer->stop();
+    bobDrag.stop();
+    physicsWorker->stopSimulation();
+    frameScheduler->stop();
     isPaused = false;
-    length = DEFAULT_Y_OFFSET;
-    lengthForCalculations = 10.0;
-    angle = 0;
-    mass = 1.0;
+    isSettled = false;
+    parameters.reset(Parameter::Length);
+    parameters.reset(Parameter::Angle);
+    parameters.reset(Parameter::Mass);
+    updateDisplayLength();
     angularVelocity = 0;
-    airFrictionEnabled = false;
+    dampingSettings = defaultDampingSettings();
+    quadraticDragAction->setChecked(false);
+    dryFrictionAction->setChecked(false);
+    ui->DriveEnabledCheck->setChecked(false);
+    ui->DriveAmplitudeSlider->setValue(driveSliderValue(DEFAULT_DRIVE_AMPLITUDE));
+    ui->DriveFrequencySlider->setValue(driveSliderValue(DEFAULT_DRIVE_FREQUENCY));
 
     totalMechanicalEnergy = calculateCurrentPotentialEnergy();
+    initialMechanicalEnergy = totalMechanicalEnergy;
+    dissipatedEnergy = 0.0;
     maxPotentialEnergy = totalMechanicalEnergy;
     maxKineticEnergy = 0.0;
     maxMechanicalEnergy = totalMechanicalEnergy;
@@ -352,10 +951,17 @@ void MathPendulum::on_actionReset_triggered() {
     ui->OutputHighValue->clear();
     ui->OutputVelosityValue->clear();
     ui->OutputPeriodValue->clear();
+    ui->OutputMeasuredPeriodValue->clear();
+    ui->OutputHarmonicsValue->clear();
+    ui->OutputDampingRateValue->clear();
     ui->lengthInpEdit->clear();
     ui->AngleInpEdit->clear();
     ui->MassInpEdit->clear();
 
+    motionTrail.clear();
+    controlBar->setTimeScale(1.0);
+    controlBar->setTimeline(0.0, 0.0);
+
     // Сброс стилей кнопок
     ui->ButtonOKAirFriction->setStyleSheet("");
     ui->ButtonOffAirFriction->setStyleSheet("background-color: red");
@@ -363,10 +969,50 @@ void MathPendulum::on_actionReset_triggered() {
     setInputsEnabled(true);
     updatePendulum();
 }
+void MathPendulum::on_actionBackgroundRendering_toggled(bool checked) {
+    backgroundRendering = checked;
+    submittedScene = Scene();
+    if (!checked) {
+        sceneRenderer->stopRendering();
+    }
+    updatePendulum();
+}
+
+void MathPendulum::on_actionMotionTrail_toggled(bool checked) {
+    motionTrailEnabled = checked;
+    motionTrail.clear();
+    updatePendulum();
+}
+
+void MathPendulum::on_controlBar_timeScaleChanged(double scale) {
+    physicsWorker->setTimeScale(scale);
+}
+
+// Перемотка по шкале времени
+void MathPendulum::on_controlBar_seekRequested(double time) {
+    physicsWorker->seek(time);
+}
+
+// Результат перемотки. Во время анимации его покажет очередной кадр;
+// остановленный маятник после перемотки стоит на паузе
+void MathPendulum::on_physicsWorker_seekFinished() {
+    if (frameScheduler->isActive()) {
+        return;
+    }
+    if (isSettled) {
+        isSettled = false;
+        isPaused = true;
+    }
+    motionTrail.clear();
+    updateAnimation(0.0);
+}
+
 void MathPendulum::on_actionExit_triggered()
 {
-    if (timer->isActive()) {
-        timer->stop();
+    physicsWorker->stopSimulation();
+    sceneRenderer->stopRendering();
+    if (frameScheduler->isActive()) {
+        frameScheduler->stop();
     }
 
     MainWindow *mainWindow = new MainWindow();
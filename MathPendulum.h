@@ -3,11 +3,25 @@
 
 #include <QWidget>
 #include <QMenuBar>
+#include <QElapsedTimer>
+#include <QMenu>
+#include <QAction>
 #include <QPropertyAnimation>
-#include <QTimer>
 #include <QLabel>
+#include <memory>
+#include "PendulumPhysics.h"
+#include "PhysicsModel.h"
+#include "MotionTrail.h"
+#include "ParameterRegistry.h"
+#include "BobDrag.h"
 
 class MainWindow;
+class FrameScheduler;
+class PhysicsWorker;
+class SceneRenderer;
+class SimulationControlBar;
+class FoucaultPendulum;
+class ComparisonView;
 
 namespace Ui {
 class MathPendulum;
@@ -22,16 +36,66 @@ public:
 
 protected:
     void paintEvent(QPaintEvent *event) override;
+    void mousePressEvent(QMouseEvent *event) override;
+    void mouseMoveEvent(QMouseEvent *event) override;
+    void mouseReleaseEvent(QMouseEvent *event) override;
 
 private:
     Ui::MathPendulum *ui;
     QMenuBar *menuBar;
-    QTimer *timer;
+    QMenu *dampingMenu;
+    QAction *quadraticDragAction;
+    QAction *dryFrictionAction;
+    FrameScheduler *frameScheduler;
+    PhysicsWorker *physicsWorker;
+    SceneRenderer *sceneRenderer;
+    SimulationControlBar *controlBar;
+    FoucaultPendulum *foucaultPendulum = nullptr;
+    ComparisonView *comparisonView = nullptr;
+    QElapsedTimer labelClock;
+
+    // Параметры сцены, скопированные для отрисовки в потоке SceneRenderer
+    struct Scene {
+        int width = 0;
+        int height = 0;
+        double length = 0.0;
+        double angle = 0.0;
+        int supportHeight = 0;
+        // Вибрирующий подвес: сцена центрируется, чтобы было видно
+        // верхнее положение, подвес смещен на pivotOffset (размах driveRange)
+        bool driveEnabled = false;
+        double pivotOffset = 0.0;
+        double driveRange = 0.0;
+
+        bool operator==(const Scene &other) const {
+            return width == other.width && height == other.height && length == other.length &&
+                   angle == other.angle && supportHeight == other.supportHeight &&
+                   driveEnabled == other.driveEnabled && pivotOffset == other.pivotOffset &&
+                   driveRange == other.driveRange;
+        }
+        bool operator!=(const Scene &other) const { return !(*this == other); }
+    };
+    Scene submittedScene;
+    bool backgroundRendering = false;
+    MotionTrail motionTrail;
+    bool motionTrailEnabled = false;
+
+    // Перетаскивание груза: угол груза отличается от угла указателя на
+    // dragAngleOffset, чтобы груз не прыгал к точке захвата
+    BobDrag bobDrag;
+    double dragAngleOffset = 0.0;
+
+    // Вводимые параметры: длина и масса меняются и во время движения,
+    // угол задает начальное состояние
+    enum class Parameter { Length, Angle, Mass };
+    ParameterRegistry<Parameter> parameters;
 
     // Параметры маятника
     double initialAngle = 0.0;
     double initialPeriod = 0.0;
     double totalMechanicalEnergy = 0.0;
+    double initialMechanicalEnergy = 0.0;
+    double dissipatedEnergy = 0.0;
     double maxPotentialEnergy = 0.0;
     double maxKineticEnergy = 0.0;
     double maxMechanicalEnergy = 0.0;
@@ -42,33 +106,97 @@ private:
     double mass = 1.0;
     double angularVelocity = 0.0;
     bool isAnimating = false;
-    bool airFrictionEnabled = false;
+    DampingSettings dampingSettings;
     bool isPaused = false;
+    bool isSettled = false;
+    // Пакет правок параметров, после применения которого энергия
+    // отсчитывается заново по снимку (0 — не ждем)
+    long long energyRevision = 0;
+
+    // Вибрация подвеса: амплитуда в долях длины, частота в долях
+    // собственной частоты √(g/L)
+    bool driveEnabled = false;
+    double driveAmplitudeRatio = DEFAULT_DRIVE_AMPLITUDE;
+    double driveFrequencyRatio = DEFAULT_DRIVE_FREQUENCY;
+    double drivePhase = 0.0;
 
     // Физические константы
     const double gravity = 9.81;
     const double DEG_TO_RAD = M_PI / 180.0;
     const double RAD_TO_DEG = 180.0 / M_PI;
     const int supportHeight = 80;
-    const double airFrictionCoeff = 0.02;
+    static constexpr int BOB_RADIUS = 20;
+    // Груз захватывается и рядом с кругом: палец на сенсорном экране
+    // закрывает больше, чем сам груз
+    const int GRAB_MARGIN = 20;
+    const double DEFAULT_LINEAR_DRAG = 0.02;      // 1/с
+    const double DEFAULT_QUADRATIC_DRAG = 0.001;  // 1/град
+    const double DEFAULT_DRY_FRICTION = 2.0;      // град/с²
     const double MIN_MASS = pow(10,-6);
     const double MAX_MASS = pow(10,6);
     const double MIN_LENGTH = pow(10,-6);
     const double MAX_LENGTH = pow(10,6);
+    const double MIN_OSCILLATION_LENGTH = 0.05;
+    const double MAX_OSCILLATION_LENGTH = 1000.0;
+    const double REST_ENERGY_FRACTION = 1e-6;
+    static constexpr double DEFAULT_DRIVE_AMPLITUDE = 0.05;  // a/L
+    static constexpr double DEFAULT_DRIVE_FREQUENCY = 50.0;  // Ω/ω0
+    // Шаг интегрирования не крупнее периода / STEPS_PER_PERIOD
+    const double STEPS_PER_PERIOD = 400.0;
+    // Интервал обновления подписей при ускоренном времени
+    const int LABEL_UPDATE_INTERVAL_MS = 100;
+    // Усреднение по вибрации подвеса допустимо, если она быстрее медленного
+    // движения хотя бы в MIN_AVERAGING_RATIO раз и амплитуда мала;
+    // иначе полная модель с шагом не крупнее периода подвеса / DRIVE_STEPS_PER_PERIOD
+    const double MIN_AVERAGING_RATIO = 20.0;
+    const double MAX_AVERAGING_AMPLITUDE = 0.1;
+    const double DRIVE_STEPS_PER_PERIOD = 40.0;
+    // Деления ползунков вибрации на один порядок величины
+    const int DRIVE_SLIDER_STEPS_PER_DECADE = 20;
 
     // Методы расчетов
+    template <typename Damping>
+    MathPendulumKernel<DoublePrecision, Damping> physicsKernel(const Damping &damping) const;
+    template <bool Averaged, typename Damping>
+    KapitzaPendulumKernel<DoublePrecision, Averaged, Damping> drivenKernel(const Damping &damping) const;
+    DampingSettings defaultDampingSettings() const;
+    std::unique_ptr<PhysicsModel> createPhysicsModel() const;
+    double simulationStep() const;
     double calculateHeight();
     double calculateCurrentKineticEnergy();
     double calculateCurrentPotentialEnergy();
+    double mechanicalEnergy(double stateAngle, double stateAngularVelocity) const;
     double calculatePeriod();
     double calculateVelocity();
     double calculateAmplitude();
+    double naturalFrequency() const;
+    double slowFrequency() const;
+    bool isDriveAveraged() const;
+    bool usesTrajectoryCache() const;
+    bool isAtRest(bool stuckByFriction);
 
     // Вспомогательные методы
+    Scene currentScene() const;
+    static void drawScene(QPainter &painter, const Scene &scene);
+    static QPoint pivotPosition(const Scene &scene);
+    static int pixelLength(const Scene &scene);
+    static QPoint bobPosition(const Scene &scene);
+    double pointerAngle(const QPointF &point) const;
+    void releaseBob();
     void updatePendulum();
     void setInputsEnabled(bool enabled);
     void startAnimation();
     void updateOutputValues();
+    void updateSpectrumValues(const SpectralEstimate &spectrum);
+    void setupDampingMenu();
+    void defineParameters();
+    void editParameter(Parameter parameter, const QString &text);
+    void applyParameterChange(Parameter parameter);
+    void updateDisplayLength();
+    void updateDriveLabels();
+    int driveSliderValue(double ratio) const;
+    void applyDriveChange();
+    void restartPhysicsModel();
 
 private slots:
     // Слоты для кнопок
@@ -86,8 +214,21 @@ private slots:
     void on_actionPause_triggered();
     void on_actionReset_triggered();
     void on_actionExit_triggered();
+    void on_actionBackgroundRendering_toggled(bool checked);
+    void on_actionMotionTrail_toggled(bool checked);
+    void on_controlBar_timeScaleChanged(double scale);
+    void on_controlBar_seekRequested(double time);
+    void on_physicsWorker_seekFinished();
+    void on_actionQuadraticDrag_toggled(bool checked);
+    void on_actionDryFriction_toggled(bool checked);
+    void on_actionDampingCoefficients_triggered();
+    void on_actionFoucaultPendulum_triggered();
+    void on_actionCompareVariants_triggered();
+    void on_DriveEnabledCheck_toggled(bool checked);
+    void on_DriveAmplitudeSlider_valueChanged(int value);
+    void on_DriveFrequencySlider_valueChanged(int value);
 
-    void updateAnimation();
+    void updateAnimation(double elapsedSeconds);
 };
 
 #endif
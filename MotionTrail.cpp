@@ -0,0 +1,77 @@
+#include "MotionTrail.h"
+#include <QPainter>
+#include <QPen>
+#include <cmath>
+
+void MotionTrail::setFadeTime(double seconds)
+{
+    fadeTime = seconds;
+}
+
+void MotionTrail::setColor(const QColor &newColor)
+{
+    color = newColor;
+}
+
+// Затухание накопленного следа и дорисовка нового отрезка
+void MotionTrail::addPoint(const QPointF &point, double elapsedSeconds, const QSize &size, qreal devicePixelRatio)
+{
+    QSize pixelSize = size * devicePixelRatio;
+    if (image.size() != pixelSize) {
+        image = QImage(pixelSize, QImage::Format_ARGB32_Premultiplied);
+        image.setDevicePixelRatio(devicePixelRatio);
+        clear();
+    }
+
+    pendingFade *= std::exp(-elapsedSeconds / fadeTime);
+    if (pendingFade <= MIN_FADE_FACTOR) {
+        {
+            QPainter fadePainter(&image);
+            fadePainter.setCompositionMode(QPainter::CompositionMode_DestinationIn);
+            fadePainter.fillRect(image.rect(), QColor(0, 0, 0, qRound(255 * pendingFade)));
+        }
+        pendingFade = 1.0;
+        clearFaintPixels();
+    }
+
+    if (hasLastPoint) {
+        QPainter painter(&image);
+        painter.setRenderHint(QPainter::Antialiasing);
+        painter.setPen(QPen(color, 3, Qt::SolidLine, Qt::RoundCap));
+        painter.drawLine(lastPoint, point);
+    }
+    lastPoint = point;
+    hasLastPoint = true;
+}
+
+// Слабые пиксели при умножении на MIN_FADE_FACTOR округляются к тому же
+// значению альфы и не исчезают никогда; за часы работы из них
+// накапливается след всего пути. Такие пиксели обнуляются сразу.
+void MotionTrail::clearFaintPixels()
+{
+    const int height = image.height();
+    const int width = image.width();
+    for (int y = 0; y < height; ++y) {
+        QRgb *line = reinterpret_cast<QRgb *>(image.scanLine(y));
+        for (int x = 0; x < width; ++x) {
+            if (qAlpha(line[x]) < MIN_VISIBLE_ALPHA) {
+                line[x] = 0;
+            }
+        }
+    }
+}
+
+// Очистка следа; следующая точка начинает новый путь
+void MotionTrail::clear()
+{
+    image.fill(Qt::transparent);
+    pendingFade = 1.0;
+    hasLastPoint = false;
+}
+
+void MotionTrail::draw(QPainter &painter) const
+{
+    if (!image.isNull()) {
+        painter.drawImage(0, 0, image);
+    }
+}
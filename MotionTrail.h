@@ -0,0 +1,47 @@
+#ifndef MOTIONTRAIL_H
+#define MOTIONTRAIL_H
+
+#include <QImage>
+#include <QPointF>
+#include <QColor>
+#include <QSize>
+
+class QPainter;
+
+// След груза в накопительном изображении. На каждом кадре изображение
+// целиком затухает одной операцией DestinationIn, и в него дорисовывается
+// только последний отрезок пути. Стоимость кадра не зависит от длины
+// следа, поэтому многочасовой прогон не замедляет отрисовку.
+class MotionTrail
+{
+public:
+    // Время, за которое яркость следа падает в e раз
+    void setFadeTime(double seconds);
+    void setColor(const QColor &newColor);
+
+    // Добавление точки пути; elapsedSeconds — реальное время с прошлой точки.
+    // При изменении размера окна след начинается заново.
+    void addPoint(const QPointF &point, double elapsedSeconds, const QSize &size, qreal devicePixelRatio);
+    void clear();
+
+    void draw(QPainter &painter) const;
+
+private:
+    // Затухание применяется порциями не мельче этой: при 8-битной
+    // альфе слишком малое затухание округляется до нуля
+    static constexpr double MIN_FADE_FACTOR = 0.9;
+    // Альфа a переживает затухание без изменений, пока a·(1 - MIN_FADE_FACTOR)
+    // меньше половины единицы округления, то есть при a ≤ 5
+    static constexpr int MIN_VISIBLE_ALPHA = 6;
+
+    void clearFaintPixels();
+
+    QImage image;
+    QColor color = QColor(70, 130, 220);
+    double fadeTime = 2.0;
+    double pendingFade = 1.0;
+    QPointF lastPoint;
+    bool hasLastPoint = false;
+};
+
+#endif
@@ -0,0 +1,428 @@
+#include "ParameterFit.h"
+#include "DualNumber.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <fstream>
+#include <future>
+#include <sstream>
+#include <thread>
+
+namespace {
+
+const int PARAMETER_COUNT = 4;
+
+using FitVector = std::array<double, PARAMETER_COUNT>;
+using FitMatrix = std::array<FitVector, PARAMETER_COUNT>;
+
+// Пробные значения lambda на итерации: lambda·10^-2 … lambda·10^2. Сетка не
+// зависит от числа потоков, поэтому ход итераций и результат одинаковы на
+// любой машине; потоки только считают пробы одновременно.
+const int TRIAL_COUNT = 5;
+
+// Вызов task(0) … task(count - 1) не более чем в threads потоках. Каждый
+// поток берет индексы с шагом threads; результаты пишутся по индексу, так
+// что порядок выполнения на них не влияет.
+template <typename Task>
+void parallelFor(int count, int threads, const Task &task)
+{
+    const int workers = std::min(count, std::max(threads, 1));
+    auto run = [&](int first) {
+        for (int i = first; i < count; i += workers) task(i);
+    };
+    std::vector<std::future<void>> pending;
+    for (int worker = 1; worker < workers; ++worker) {
+        pending.push_back(std::async(std::launch::async, run, worker));
+    }
+    run(0);
+    for (std::future<void> &future : pending) future.get();
+}
+
+// Моделирование траектории в моменты измерений. Шаг не превышает maxStep,
+// последний шаг перед измерением укорачивается, чтобы попасть точно в него.
+template <typename Scalar, typename Kernel, typename State>
+void sampleTrajectory(const Kernel &kernel, State state, const Recording &recording,
+                      double maxStep, std::vector<Scalar> &coordinates)
+{
+    coordinates.resize(recording.time.size());
+    double time = recording.time.front();
+    coordinates[0] = state.coordinate();
+
+    for (std::size_t i = 1; i < recording.time.size(); ++i) {
+        const double target = recording.time[i];
+        while (time < target) {
+            double dt = std::min(maxStep, target - time);
+            kernel.step(state.physics, dt);
+            time = (target - time <= maxStep) ? target : time + dt;
+        }
+        coordinates[i] = state.coordinate();
+    }
+}
+
+// Обертки над состояниями ядер с единым доступом к координате
+template <typename Precision>
+struct MathFitState {
+    MathPendulumState<Precision> physics;
+    typename Precision::Scalar coordinate() const { return physics.angle; }
+};
+
+template <typename Precision>
+struct SpringFitState {
+    SpringPendulumState<Precision> physics;
+    typename Precision::Scalar coordinate() const { return physics.position; }
+};
+
+// Параметр index: в прогоне в дуальных числах ширины Width производные
+// берутся по параметрам firstLane … firstLane + Width - 1, остальные —
+// константы
+template <typename Scalar>
+struct FitVariable {
+    static double make(double value, int, int) { return value; }
+};
+
+template <int Width>
+struct FitVariable<Dual<double, Width>> {
+    static Dual<double, Width> make(double value, int index, int firstLane) {
+        const int lane = index - firstLane;
+        if (lane < 0 || lane >= Width) {
+            return Dual<double, Width>(value);
+        }
+        return Dual<double, Width>::variable(value, lane);
+    }
+};
+
+template <typename Precision>
+void simulate(const FitVector &parameters, const Recording &recording, const FitOptions &options,
+              std::vector<typename Precision::Scalar> &coordinates, int firstLane = 0)
+{
+    using Scalar = typename Precision::Scalar;
+    auto variable = [&](int index) {
+        return FitVariable<Scalar>::make(parameters[index], index, firstLane);
+    };
+
+    if (options.model == FitModel::Math) {
+        MathPendulumKernel<Precision, DampingModel<Scalar, LinearDrag>> kernel;
+        kernel.length = variable(0);
+        kernel.damping.template term<LinearDrag>().coeff = variable(1);
+
+        MathFitState<Precision> state;
+        state.physics.angle = variable(2);
+        state.physics.angularVelocity = variable(3);
+        sampleTrajectory<Scalar>(kernel, state, recording, options.maxStep, coordinates);
+    } else {
+        SpringPendulumKernel<Precision, DampingModel<Scalar, LinearDrag>> kernel;
+        kernel.mass = Scalar(options.mass);
+        kernel.springConstant = variable(0);
+        kernel.damping.template term<LinearDrag>().coeff = variable(1);
+
+        SpringFitState<Precision> state;
+        state.physics.position = variable(2);
+        state.physics.velocity = variable(3);
+        sampleTrajectory<Scalar>(kernel, state, recording, options.maxStep, coordinates);
+    }
+}
+
+// Сумма квадратов невязок для пробной точки
+double residualCost(const FitVector &parameters, const Recording &recording, const FitOptions &options)
+{
+    std::vector<double> coordinates;
+    simulate<DoublePrecision>(parameters, recording, options, coordinates);
+
+    double cost = 0.0;
+    for (std::size_t i = 0; i < coordinates.size(); ++i) {
+        double residual = coordinates[i] - recording.value[i];
+        cost += residual * residual;
+    }
+    return std::isfinite(cost) ? cost : HUGE_VAL;
+}
+
+// Столбцы якобиана firstLane … firstLane + Width - 1 и модельные значения
+template <int Width>
+void jacobianColumns(const FitVector &parameters, const Recording &recording, const FitOptions &options,
+                     int firstLane, std::vector<FitVector> &jacobian, std::vector<double> &values)
+{
+    std::vector<Dual<double, Width>> coordinates;
+    simulate<DualPrecision<Width>>(parameters, recording, options, coordinates, firstLane);
+    for (std::size_t i = 0; i < coordinates.size(); ++i) {
+        for (int lane = 0; lane < Width; ++lane) {
+            jacobian[i][firstLane + lane] = coordinates[i].grad[lane];
+        }
+    }
+    if (firstLane == 0) {
+        values.resize(coordinates.size());
+        for (std::size_t i = 0; i < coordinates.size(); ++i) values[i] = coordinates[i].value;
+    }
+}
+
+// Нормальные уравнения JᵀJ и Jᵀr. Траекторию нельзя начать с середины
+// записи, поэтому якобиан делится не по отсчетам, а по столбцам: при
+// нескольких потоках каждый прогоняет траекторию в дуальных числах по
+// своей части параметров. Арифметика каждой полосы производной от ширины
+// не зависит, так что результат одинаков при любом числе потоков.
+double normalEquations(const FitVector &parameters, const Recording &recording, const FitOptions &options,
+                       int threads, FitMatrix &jtj, FitVector &jtr)
+{
+    std::vector<FitVector> jacobian(recording.time.size());
+    std::vector<double> values;
+    if (threads >= PARAMETER_COUNT) {
+        parallelFor(PARAMETER_COUNT, threads, [&](int lane) {
+            jacobianColumns<1>(parameters, recording, options, lane, jacobian, values);
+        });
+    } else if (threads >= 2) {
+        parallelFor(2, threads, [&](int half) {
+            jacobianColumns<PARAMETER_COUNT / 2>(parameters, recording, options,
+                                                 half * PARAMETER_COUNT / 2, jacobian, values);
+        });
+    } else {
+        jacobianColumns<PARAMETER_COUNT>(parameters, recording, options, 0, jacobian, values);
+    }
+
+    jtj = FitMatrix{};
+    jtr = FitVector{};
+    double cost = 0.0;
+    for (std::size_t i = 0; i < jacobian.size(); ++i) {
+        const FitVector &grad = jacobian[i];
+        double residual = values[i] - recording.value[i];
+        cost += residual * residual;
+        for (int row = 0; row < PARAMETER_COUNT; ++row) {
+            jtr[row] += grad[row] * residual;
+            for (int column = 0; column <= row; ++column) {
+                jtj[row][column] += grad[row] * grad[column];
+            }
+        }
+    }
+    for (int row = 0; row < PARAMETER_COUNT; ++row) {
+        for (int column = row + 1; column < PARAMETER_COUNT; ++column) {
+            jtj[row][column] = jtj[column][row];
+        }
+    }
+    return cost;
+}
+
+// Решение системы методом Гаусса с выбором главного элемента
+bool solve(FitMatrix matrix, FitVector rhs, FitVector &solution)
+{
+    for (int column = 0; column < PARAMETER_COUNT; ++column) {
+        int pivot = column;
+        for (int row = column + 1; row < PARAMETER_COUNT; ++row) {
+            if (std::fabs(matrix[row][column]) > std::fabs(matrix[pivot][column])) pivot = row;
+        }
+        if (matrix[pivot][column] == 0.0 || !std::isfinite(matrix[pivot][column])) {
+            return false;
+        }
+        std::swap(matrix[pivot], matrix[column]);
+        std::swap(rhs[pivot], rhs[column]);
+
+        for (int row = column + 1; row < PARAMETER_COUNT; ++row) {
+            double factor = matrix[row][column] / matrix[column][column];
+            for (int k = column; k < PARAMETER_COUNT; ++k) matrix[row][k] -= factor * matrix[column][k];
+            rhs[row] -= factor * rhs[column];
+        }
+    }
+    for (int row = PARAMETER_COUNT - 1; row >= 0; --row) {
+        double sum = rhs[row];
+        for (int k = row + 1; k < PARAMETER_COUNT; ++k) sum -= matrix[row][k] * solution[k];
+        solution[row] = sum / matrix[row][row];
+    }
+    return true;
+}
+
+// Начальное приближение: период по переходам через среднее значение
+// с гистерезисом (шум затухшего хвоста записи не дает ложных переходов),
+// скорость — по первой разности
+FitVector initialGuess(const Recording &recording, const FitOptions &options)
+{
+    const std::vector<double> &t = recording.time;
+    const std::vector<double> &x = recording.value;
+
+    double mean = 0.0;
+    for (double value : x) mean += value;
+    mean /= x.size();
+
+    double peak = 0.0;
+    for (double value : x) peak = std::max(peak, std::fabs(value - mean));
+    const double hysteresis = 0.1 * peak;
+
+    int crossings = 0;
+    double firstCrossing = 0.0;
+    double lastCrossing = 0.0;
+    bool armed = false;
+    for (std::size_t i = 1; i < x.size(); ++i) {
+        if (x[i] < mean - hysteresis) {
+            armed = true;
+        }
+        if (armed && x[i - 1] < mean && x[i] >= mean) {
+            armed = false;
+            double crossing = t[i - 1] + (t[i] - t[i - 1]) * (mean - x[i - 1]) / (x[i] - x[i - 1]);
+            if (crossings == 0) firstCrossing = crossing;
+            lastCrossing = crossing;
+            ++crossings;
+        }
+    }
+    double period = crossings >= 2 ? (lastCrossing - firstCrossing) / (crossings - 1)
+                                   : t.back() - t.front();
+    double omega = 2 * M_PI / period;
+
+    FitVector guess;
+    if (options.model == FitModel::Math) {
+        guess[0] = PhysicsConstants<double>::gravity() / (omega * omega);
+    } else {
+        guess[0] = options.mass * omega * omega;
+    }
+    guess[1] = 0.0;
+    guess[2] = x[0];
+    guess[3] = (x[1] - x[0]) / (t[1] - t[0]);
+    return guess;
+}
+
+const char *parameterName(FitModel model, int index)
+{
+    static const char *mathNames[PARAMETER_COUNT] = {
+        "lengthForCalculations", "airFrictionCoeff", "initialAngle", "initialAngularVelocity"
+    };
+    static const char *springNames[PARAMETER_COUNT] = {
+        "springConstant", "airFrictionCoeff", "initialPosition", "initialVelocity"
+    };
+    return model == FitModel::Math ? mathNames[index] : springNames[index];
+}
+
+}
+
+// Загрузка записи из CSV
+bool loadRecording(const std::string &path, Recording &recording, std::string &error)
+{
+    std::ifstream file(path);
+    if (!file) {
+        error = "Cannot open " + path;
+        return false;
+    }
+
+    recording = Recording();
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(file, line)) {
+        ++lineNumber;
+        std::replace(line.begin(), line.end(), ',', ' ');
+        std::replace(line.begin(), line.end(), ';', ' ');
+        std::replace(line.begin(), line.end(), '\t', ' ');
+
+        std::istringstream stream(line);
+        double time;
+        double value;
+        if (!(stream >> time >> value)) {
+            continue;
+        }
+        if (!recording.time.empty() && time <= recording.time.back()) {
+            error = "Time must increase strictly (line " + std::to_string(lineNumber) + ")";
+            return false;
+        }
+        recording.time.push_back(time);
+        recording.value.push_back(value);
+    }
+
+    if (recording.time.size() < 2 * PARAMETER_COUNT) {
+        error = "Recording has too few samples";
+        return false;
+    }
+    return true;
+}
+
+// Метод Левенберга–Марквардта с масштабированием по диагонали JᵀJ.
+// На каждой итерации TRIAL_COUNT значений lambda проверяются параллельно,
+// и берется лучшее уменьшение невязки.
+FitResult fitRecording(const Recording &recording, const FitOptions &options)
+{
+    FitResult result;
+    const std::size_t sampleCount = recording.time.size();
+    if (sampleCount < 2 * PARAMETER_COUNT || recording.value.size() != sampleCount) {
+        result.message = "Recording has too few samples";
+        return result;
+    }
+
+    int threads = options.threads > 0 ? options.threads
+                                      : static_cast<int>(std::thread::hardware_concurrency());
+    threads = std::max(threads, 1);
+
+    FitVector parameters = initialGuess(recording, options);
+    FitMatrix jtj;
+    FitVector jtr;
+    double cost = normalEquations(parameters, recording, options, threads, jtj, jtr);
+    double lambda = 1e-3;
+
+    for (result.iterations = 1; result.iterations <= options.maxIterations; ++result.iterations) {
+        // Пробные lambda: геометрическая сетка вокруг текущего значения
+        double lambdas[TRIAL_COUNT];
+        for (int i = 0; i < TRIAL_COUNT; ++i) {
+            lambdas[i] = lambda * std::pow(10.0, i - TRIAL_COUNT / 2);
+        }
+
+        FitVector candidates[TRIAL_COUNT];
+        bool solved[TRIAL_COUNT];
+        for (int i = 0; i < TRIAL_COUNT; ++i) {
+            FitMatrix damped = jtj;
+            FitVector rhs;
+            for (int k = 0; k < PARAMETER_COUNT; ++k) {
+                damped[k][k] += lambdas[i] * std::max(jtj[k][k], 1e-12);
+                rhs[k] = -jtr[k];
+            }
+            FitVector delta{};
+            solved[i] = solve(damped, rhs, delta);
+            for (int k = 0; k < PARAMETER_COUNT; ++k) candidates[i][k] = parameters[k] + delta[k];
+        }
+
+        double costs[TRIAL_COUNT];
+        parallelFor(TRIAL_COUNT, threads, [&](int i) {
+            costs[i] = solved[i] ? residualCost(candidates[i], recording, options) : HUGE_VAL;
+        });
+
+        int best = -1;
+        double bestCost = cost;
+        for (int i = 0; i < TRIAL_COUNT; ++i) {
+            if (costs[i] < bestCost) {
+                bestCost = costs[i];
+                best = i;
+            }
+        }
+
+        if (best < 0) {
+            lambda *= std::pow(10.0, TRIAL_COUNT);
+            if (lambda > 1e16) {
+                result.converged = true;
+                result.message = "No further improvement";
+                break;
+            }
+            continue;
+        }
+
+        double improvement = (cost - bestCost) / std::max(cost, 1e-300);
+        parameters = candidates[best];
+        lambda = std::max(lambdas[best] / 10.0, 1e-12);
+        cost = normalEquations(parameters, recording, options, threads, jtj, jtr);
+
+        if (improvement < options.tolerance) {
+            result.converged = true;
+            result.message = "Converged";
+            break;
+        }
+    }
+    if (!result.converged) {
+        result.message = "Iteration limit reached";
+        result.iterations = options.maxIterations;
+    }
+
+    // Ковариация: s²·(JᵀJ)⁻¹, s² — дисперсия невязок
+    const double variance = cost / std::max<double>(sampleCount - PARAMETER_COUNT, 1);
+    result.residualRms = std::sqrt(cost / sampleCount);
+    for (int k = 0; k < PARAMETER_COUNT; ++k) {
+        FitVector unit{};
+        unit[k] = 1.0;
+        FitVector column{};
+        double uncertainty = NAN;
+        if (solve(jtj, unit, column) && column[k] >= 0.0) {
+            uncertainty = std::sqrt(variance * column[k]);
+        }
+        result.parameters.push_back({parameterName(options.model, k), parameters[k], uncertainty});
+    }
+    return result;
+}
@@ -0,0 +1,59 @@
+#ifndef PARAMETERFIT_H
+#define PARAMETERFIT_H
+
+#include <string>
+#include <vector>
+
+// Оценка параметров маятника по измеренной траектории методом
+// Левенберга–Марквардта. Кандидаты моделируются теми же уравнениями
+// движения, что и в приложении (PendulumPhysics.h); якобиан получается
+// прогоном в дуальных числах, разделенным по параметрам между потоками, а
+// пробные шаги с разными коэффициентами демпфирования считаются
+// параллельно. Результат от числа потоков не зависит.
+
+enum class FitModel {
+    Math,    // (t, angle) — угол в градусах
+    Spring   // (t, position) — смещение от равновесия в метрах
+};
+
+// Временной ряд измерений
+struct Recording {
+    std::vector<double> time;
+    std::vector<double> value;
+};
+
+// Загрузка CSV с двумя столбцами (t, значение). Разделители — запятая,
+// точка с запятой, табуляция или пробел; нечисловые строки (заголовок)
+// пропускаются. Время должно строго возрастать.
+bool loadRecording(const std::string &path, Recording &recording, std::string &error);
+
+struct FitOptions {
+    FitModel model = FitModel::Math;
+    double mass = 1.0;          // масса груза пружинного маятника, кг
+    double maxStep = 0.001;     // наибольший шаг интегрирования, с
+    int maxIterations = 100;
+    double tolerance = 1e-10;   // относительное изменение невязки для остановки
+    int threads = 0;            // 0 — по числу ядер
+};
+
+struct FitParameter {
+    std::string name;
+    double value = 0.0;
+    double uncertainty = 0.0;   // стандартная ошибка (1 sigma)
+};
+
+struct FitResult {
+    bool converged = false;
+    int iterations = 0;
+    double residualRms = 0.0;
+    std::vector<FitParameter> parameters;
+    std::string message;
+};
+
+// Подбор параметров. Для математического маятника оцениваются
+// lengthForCalculations, airFrictionCoeff и начальные угол и угловая
+// скорость; для пружинного — springConstant, airFrictionCoeff и начальные
+// смещение и скорость (масса считается известной).
+FitResult fitRecording(const Recording &recording, const FitOptions &options);
+
+#endif
@@ -0,0 +1,94 @@
+#ifndef PARAMETERREGISTRY_H
+#define PARAMETERREGISTRY_H
+
+#include <QString>
+#include <map>
+
+// Описание параметра, который вводится на экране: имя и единицы для
+// сообщений, допустимый диапазон, значение по умолчанию и можно ли менять
+// его во время движения
+struct ParameterSpec {
+    QString name;
+    QString unit;
+    double minimum = 0.0;
+    double maximum = 0.0;
+    double defaultValue = 0.0;
+    bool liveEditable = false;
+};
+
+// Реестр параметров экрана с ключом Key (enum class экрана). Значения
+// хранятся в полях самого экрана, реестр только проверяет и записывает
+// их, так что весь ввод проходит один путь проверки.
+template <typename Key>
+class ParameterRegistry
+{
+public:
+    // Регистрация параметра; storage получает значение по умолчанию
+    void define(Key key, const ParameterSpec &spec, double &storage)
+    {
+        entries[key] = Entry{spec, &storage};
+        storage = spec.defaultValue;
+    }
+
+    const ParameterSpec &spec(Key key) const { return entries.at(key).spec; }
+    double value(Key key) const { return *entries.at(key).storage; }
+    bool isLiveEditable(Key key) const { return entries.at(key).spec.liveEditable; }
+
+    // Диапазон, зависящий от режима экрана
+    void setRange(Key key, double minimum, double maximum)
+    {
+        Entry &entry = entries.at(key);
+        entry.spec.minimum = minimum;
+        entry.spec.maximum = maximum;
+    }
+
+    // Разбор и проверка ввода. Пустая строка — значение по умолчанию.
+    bool parse(Key key, const QString &text, double &result, QString &error) const
+    {
+        const ParameterSpec &parameter = spec(key);
+        if (text.trimmed().isEmpty()) {
+            result = parameter.defaultValue;
+            return true;
+        }
+
+        bool ok;
+        double value = text.toDouble(&ok);
+        if (!ok || value < parameter.minimum || value > parameter.maximum) {
+            error = QString("%1 should be in range: [ %2, %3 ]%4!")
+                        .arg(parameter.name)
+                        .arg(parameter.minimum)
+                        .arg(parameter.maximum)
+                        .arg(parameter.unit.isEmpty() ? QString() : " " + parameter.unit);
+            return false;
+        }
+        result = value;
+        return true;
+    }
+
+    // Проверка и запись; при ошибке значение не меняется
+    bool set(Key key, const QString &text, QString &error)
+    {
+        double result;
+        if (!parse(key, text, result, error)) {
+            return false;
+        }
+        *entries.at(key).storage = result;
+        return true;
+    }
+
+    void reset(Key key)
+    {
+        Entry &entry = entries.at(key);
+        *entry.storage = entry.spec.defaultValue;
+    }
+
+private:
+    struct Entry {
+        ParameterSpec spec;
+        double *storage = nullptr;
+    };
+
+    std::map<Key, Entry> entries;
+};
+
+#endif
@@ -0,0 +1,157 @@
+#include "ParameterSweep.h"
+#include <algorithm>
+#include <cmath>
+
+double SweepAxis::value(long long index) const
+{
+    if (count <= 1) {
+        return minimum;
+    }
+    return minimum + (maximum - minimum) * static_cast<double>(index) / static_cast<double>(count - 1);
+}
+
+long long SweepSpec::pointCount() const
+{
+    return axes[0].count * axes[1].count;
+}
+
+void SweepSpec::point(long long index, double &first, double &second) const
+{
+    first = axes[0].value(index / axes[1].count);
+    second = axes[1].value(index % axes[1].count);
+}
+
+const char *sweepModelName(SweepModel model)
+{
+    return model == SweepModel::Math ? "math" : "spring";
+}
+
+const char *sweepAxisName(SweepModel model, int axis)
+{
+    if (model == SweepModel::Math) {
+        return axis == 0 ? "length" : "angle";
+    }
+    return axis == 0 ? "spring" : "position";
+}
+
+namespace {
+
+// Период по восходящим переходам через ноль и дрейф энергии
+class SweepTracker
+{
+public:
+    explicit SweepTracker(double dt) : dt(dt) {}
+
+    void sample(double time, double coordinate, double energy)
+    {
+        if (hasPrevious && previousCoordinate < 0.0 && coordinate >= 0.0) {
+            double crossing = time - dt * coordinate / (coordinate - previousCoordinate);
+            if (crossings == 0) {
+                firstCrossing = crossing;
+            }
+            lastCrossing = crossing;
+            ++crossings;
+        }
+        if (!hasPrevious) {
+            initialEnergy = energy;
+        }
+        drift = std::max(drift, std::abs(energy - initialEnergy));
+        previousCoordinate = coordinate;
+        hasPrevious = true;
+    }
+
+    void fill(SweepResult &result) const
+    {
+        result.period = crossings >= 2 ? (lastCrossing - firstCrossing) / (crossings - 1) : 0.0;
+        result.energyDrift = initialEnergy > 0.0 ? drift / initialEnergy : drift;
+    }
+
+private:
+    double dt;
+    bool hasPrevious = false;
+    double previousCoordinate = 0.0;
+    double firstCrossing = 0.0;
+    double lastCrossing = 0.0;
+    long crossings = 0;
+    double initialEnergy = 0.0;
+    double drift = 0.0;
+};
+
+using SweepDamping = DampingModel<double, LinearDrag>;
+
+SweepResult evaluateMath(const SweepSpec &spec, double length, double angle)
+{
+    using Constants = PhysicsConstants<double>;
+    MathPendulumKernel<DoublePrecision, SweepDamping> kernel;
+    kernel.length = length;
+    kernel.mass = spec.mass;
+    kernel.damping.term<LinearDrag>().coeff = spec.airFrictionCoeff;
+
+    MathPendulumState<DoublePrecision> state;
+    state.angle = angle;
+
+    // Полная энергия вместе с рассеянной сохраняется
+    auto energy = [&]() {
+        double speed = state.angularVelocity * Constants::degToRad() * length;
+        double height = length * (1.0 - std::cos(double(state.angle) * Constants::degToRad()));
+        return 0.5 * spec.mass * speed * speed + spec.mass * kernel.gravity * height
+               + double(state.dissipatedEnergy);
+    };
+
+    SweepTracker tracker(spec.dt);
+    tracker.sample(0.0, state.angle, energy());
+    const long steps = static_cast<long>(spec.duration / spec.dt);
+    for (long i = 1; i <= steps; ++i) {
+        kernel.step(state, spec.dt);
+        tracker.sample(i * spec.dt, state.angle, energy());
+    }
+
+    SweepResult result;
+    result.finalCoordinate = state.angle;
+    result.finalVelocity = state.angularVelocity;
+    tracker.fill(result);
+    return result;
+}
+
+SweepResult evaluateSpring(const SweepSpec &spec, double springConstant, double position)
+{
+    SpringPendulumKernel<DoublePrecision, SweepDamping> kernel;
+    kernel.mass = spec.mass;
+    kernel.springConstant = springConstant;
+    kernel.damping.term<LinearDrag>().coeff = spec.airFrictionCoeff;
+
+    SpringPendulumState<DoublePrecision> state;
+    state.position = position;
+
+    auto energy = [&]() {
+        double x = state.position;
+        return 0.5 * spec.mass * state.velocity * state.velocity + 0.5 * springConstant * x * x
+               + double(state.dissipatedEnergy);
+    };
+
+    SweepTracker tracker(spec.dt);
+    tracker.sample(0.0, state.position, energy());
+    const long steps = static_cast<long>(spec.duration / spec.dt);
+    for (long i = 1; i <= steps; ++i) {
+        kernel.step(state, spec.dt);
+        tracker.sample(i * spec.dt, state.position, energy());
+    }
+
+    SweepResult result;
+    result.finalCoordinate = state.position;
+    result.finalVelocity = state.velocity;
+    tracker.fill(result);
+    return result;
+}
+
+}
+
+SweepResult evaluateSweepPoint(const SweepSpec &spec, long long index)
+{
+    double first, second;
+    spec.point(index, first, second);
+    if (spec.model == SweepModel::Math) {
+        return evaluateMath(spec, first, second);
+    }
+    return evaluateSpring(spec, first, second);
+}
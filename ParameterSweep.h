@@ -0,0 +1,54 @@
+#ifndef PARAMETERSWEEP_H
+#define PARAMETERSWEEP_H
+
+#include "PendulumPhysics.h"
+
+// Перебор параметров маятника по двумерной сетке. Каждая точка сетки —
+// независимый прогон того же интегратора, что и в приложении, поэтому
+// точки можно считать в любом порядке и в разных процессах
+// (tools/SweepCoordinator).
+
+enum class SweepModel {
+    Math = 0,     // оси: длина (м), начальный угол (градусы)
+    Spring = 1    // оси: жесткость (Н/м), начальное смещение (м)
+};
+
+// Равномерная ось: count значений от minimum до maximum включительно
+struct SweepAxis {
+    double minimum = 0.0;
+    double maximum = 0.0;
+    long long count = 1;
+
+    double value(long long index) const;
+};
+
+struct SweepSpec {
+    SweepModel model = SweepModel::Math;
+    SweepAxis axes[2];
+    double mass = 1.0;
+    // Коэффициент линейного сопротивления, 0 — без сопротивления
+    double airFrictionCoeff = 0.0;
+    double duration = 60.0;
+    double dt = SIMULATION_STEP;
+
+    long long pointCount() const;
+    // Значения параметров точки; вторая ось меняется быстрее
+    void point(long long index, double &first, double &second) const;
+};
+
+const char *sweepModelName(SweepModel model);
+const char *sweepAxisName(SweepModel model, int axis);
+
+// Результат прогона одной точки. period — среднее время между восходящими
+// переходами через ноль (0, если переходов меньше двух); energyDrift —
+// наибольшее относительное отклонение полной энергии с учетом рассеянной.
+struct SweepResult {
+    double finalCoordinate = 0.0;
+    double finalVelocity = 0.0;
+    double period = 0.0;
+    double energyDrift = 0.0;
+};
+
+SweepResult evaluateSweepPoint(const SweepSpec &spec, long long index);
+
+#endif
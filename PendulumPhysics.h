@@ -0,0 +1,570 @@
+#ifndef PENDULUMPHYSICS_H
+#define PENDULUMPHYSICS_H
+
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+#include "DampingModels.h"
+
+// Уравнения движения маятников, параметризованные политикой точности.
+// Политика задает тип скаляра (Scalar) и тип накопителя координаты (Sum):
+// обычное суммирование или компенсированное (Кэхэн) для длительных прогонов.
+
+// Накопитель без компенсации ошибки округления
+template <typename T>
+struct PlainSum {
+    T value{};
+
+    PlainSum() = default;
+    PlainSum(T initial) : value(initial) {}
+
+    void add(T delta) { value += delta; }
+    void set(T newValue) { value = newValue; }
+    operator T() const { return value; }
+};
+
+// Накопитель с компенсированным суммированием (алгоритм Кэхэна–Ноймайера)
+template <typename T>
+struct KahanSum {
+    T value{};
+    T compensation{};
+
+    KahanSum() = default;
+    KahanSum(T initial) : value(initial) {}
+
+    void add(T delta) {
+        T sum = value + delta;
+        using std::fabs;
+        if (fabs(value) >= fabs(delta)) {
+            compensation += (value - sum) + delta;
+        } else {
+            compensation += (delta - sum) + value;
+        }
+        value = sum;
+    }
+    void set(T newValue) { value = newValue; compensation = T(0); }
+    operator T() const { return value + compensation; }
+};
+
+// Политики точности
+struct FloatPrecision {
+    using Scalar = float;
+    using Sum = PlainSum<float>;
+    static constexpr const char *name = "float";
+};
+
+struct DoublePrecision {
+    using Scalar = double;
+    using Sum = PlainSum<double>;
+    static constexpr const char *name = "double";
+};
+
+struct LongDoublePrecision {
+    using Scalar = long double;
+    using Sum = PlainSum<long double>;
+    static constexpr const char *name = "long double";
+};
+
+struct KahanFloatPrecision {
+    using Scalar = float;
+    using Sum = KahanSum<float>;
+    static constexpr const char *name = "float + Kahan";
+};
+
+struct KahanDoublePrecision {
+    using Scalar = double;
+    using Sum = KahanSum<double>;
+    static constexpr const char *name = "double + Kahan";
+};
+
+// Эталон: long double с компенсированным суммированием
+struct ReferencePrecision {
+    using Scalar = long double;
+    using Sum = KahanSum<long double>;
+    static constexpr const char *name = "long double + Kahan";
+};
+
+// Физические константы в нужной точности
+template <typename Scalar>
+struct PhysicsConstants {
+    static Scalar pi() { return Scalar(3.141592653589793238462643383279502884L); }
+    static Scalar degToRad() { return Scalar(3.141592653589793238462643383279502884L / 180.0L); }
+    static Scalar radToDeg() { return Scalar(180.0L / 3.141592653589793238462643383279502884L); }
+    static Scalar gravity() { return Scalar(9.81L); }
+};
+
+// Шаг интегрирования, которым пользуются виджеты
+constexpr double SIMULATION_STEP = 0.016;
+
+// Версия физического кода. Входит в ключ каждого сохраненного результата
+// (ResultCache) рядом с отпечатком по эталонным траекториям: эталоны не
+// проходят все ветви ядер (ограничение ±90°, нижняя граница пружины,
+// застой при сухом трении), поэтому при любой правке этого файла или
+// DampingModels.h, способной изменить результат, версию нужно увеличить.
+constexpr long long PHYSICS_CODE_VERSION = 1;
+
+// ---------------------------------------------------------------------------
+// Математический маятник
+// ---------------------------------------------------------------------------
+
+// Состояние: угол (градусы), угловая скорость (градусы/с) и энергия,
+// рассеянная сопротивлением с начала движения (Дж)
+template <typename Precision>
+struct MathPendulumState {
+    typename Precision::Sum angle{};
+    typename Precision::Scalar angularVelocity{};
+    typename Precision::Sum dissipatedEnergy{};
+};
+
+// Методы интегрирования математического маятника. Приложение работает
+// полунеявным (симплектическим) методом Эйлера; явный Эйлер и Рунге–Кутта
+// 4-го порядка нужны для сравнения методов (ComparisonModel).
+struct SemiImplicitEuler {};
+struct ExplicitEuler {};
+struct RungeKutta4 {};
+
+// Математический маятник в тех же единицах, что и MathPendulum.
+// Сопротивление задается моделью Damping (см. DampingModels.h); без него
+// шаг не содержит ни ветвлений, ни лишних операций. Integrator — метод
+// интегрирования, Linearised заменяет sin θ на θ (малые колебания).
+// Сухое трение поддерживает только полунеявный метод Эйлера.
+template <typename Precision,
+          typename Damping = DampingModel<typename Precision::Scalar>,
+          typename Integrator = SemiImplicitEuler,
+          bool Linearised = false>
+struct MathPendulumKernel {
+    using Scalar = typename Precision::Scalar;
+    using State = MathPendulumState<Precision>;
+
+    static_assert(std::is_same_v<Integrator, SemiImplicitEuler> || !Damping::hasDryFriction,
+                  "Dry friction needs the stop events of the semi-implicit Euler step");
+
+    Scalar gravity = PhysicsConstants<Scalar>::gravity();
+    Scalar length = Scalar(10.0);
+    Scalar mass = Scalar(1.0);
+    Scalar maxAngle = Scalar(90.0);
+    Damping damping;
+
+    // Ускорение от силы тяжести при угле angle (град/с²)
+    Scalar conservativeAcceleration(Scalar angle) const {
+        if constexpr (Linearised) {
+            return -gravity / length * angle;
+        } else {
+            using std::sin;
+            return -gravity / length * sin(angle * PhysicsConstants<Scalar>::degToRad())
+                   * PhysicsConstants<Scalar>::radToDeg();
+        }
+    }
+
+    Scalar conservativeAcceleration(const State &state) const {
+        return conservativeAcceleration(Scalar(state.angle));
+    }
+
+    // Полное ускорение без сухого трения (град/с²)
+    Scalar acceleration(Scalar angle, Scalar angularVelocity) const {
+        return conservativeAcceleration(angle) + damping.viscousForce(angularVelocity);
+    }
+
+    // Множитель перевода «угловое ускорение · угловая скорость» в Дж/с
+    Scalar energyScale() const {
+        const Scalar degToRad = PhysicsConstants<Scalar>::degToRad();
+        return mass * length * length * degToRad * degToRad;
+    }
+
+    void step(State &state, Scalar dt) const {
+        if constexpr (std::is_same_v<Integrator, SemiImplicitEuler>) {
+            dampedEulerStep(damping, state.angle, state.angularVelocity, state.dissipatedEnergy,
+                            conservativeAcceleration(state), Scalar(1), energyScale(), dt);
+        } else if constexpr (std::is_same_v<Integrator, ExplicitEuler>) {
+            // Скорость и угол обновляются по состоянию начала шага
+            const Scalar angle = state.angle;
+            const Scalar velocity = state.angularVelocity;
+            state.angularVelocity = velocity + acceleration(angle, velocity) * dt;
+            state.angle.add(velocity * dt);
+            state.dissipatedEnergy.add(-damping.viscousForce(velocity) * velocity * energyScale() * dt);
+        } else {
+            static_assert(std::is_same_v<Integrator, RungeKutta4>, "Unknown integrator");
+            // Мощность сопротивления интегрируется теми же весами, что и
+            // состояние
+            const Scalar angle = state.angle;
+            const Scalar v1 = state.angularVelocity;
+            const Scalar a1 = acceleration(angle, v1);
+            const Scalar v2 = v1 + Scalar(0.5) * dt * a1;
+            const Scalar a2 = acceleration(angle + Scalar(0.5) * dt * v1, v2);
+            const Scalar v3 = v1 + Scalar(0.5) * dt * a2;
+            const Scalar a3 = acceleration(angle + Scalar(0.5) * dt * v2, v3);
+            const Scalar v4 = v1 + dt * a3;
+            const Scalar a4 = acceleration(angle + dt * v3, v4);
+            const Scalar sixth = dt / Scalar(6);
+            state.angle.add(sixth * (v1 + Scalar(2) * v2 + Scalar(2) * v3 + v4));
+            state.angularVelocity = v1 + sixth * (a1 + Scalar(2) * a2 + Scalar(2) * a3 + a4);
+            const Scalar power = damping.viscousForce(v1) * v1 + Scalar(2) * damping.viscousForce(v2) * v2 +
+                                 Scalar(2) * damping.viscousForce(v3) * v3 + damping.viscousForce(v4) * v4;
+            state.dissipatedEnergy.add(-power * energyScale() * sixth);
+        }
+
+        // Ограничение угла отклонения
+        Scalar angle = state.angle;
+        if (angle > maxAngle) state.angle.set(maxAngle);
+        if (angle < -maxAngle) state.angle.set(-maxAngle);
+    }
+
+    bool isStuck(const State &state) const {
+        return isStuckByDryFriction(damping, state.angularVelocity, conservativeAcceleration(state), Scalar(1));
+    }
+};
+
+// Синус отрезком ряда Тейлора на [-π/2, π/2] (углы ядра не выходят за
+// ±90°). Число членов подобрано под точность Scalar: отброшенный член
+// меньше единицы младшего разряда, погрешность — несколько единиц
+// младшего разряда. В отличие от вызова sin, многочлен компилятор
+// векторизует вместе с циклом, в котором он стоит.
+template <typename Scalar>
+struct PolynomialSine {
+    static constexpr int TERMS = std::numeric_limits<Scalar>::digits <= 24 ? 6
+                               : std::numeric_limits<Scalar>::digits <= 53 ? 11 : 12;
+    Scalar coefficients[TERMS];
+
+    PolynomialSine() {
+        coefficients[0] = Scalar(1);
+        for (int k = 1; k < TERMS; ++k) {
+            coefficients[k] = -coefficients[k - 1] / Scalar((2 * k) * (2 * k + 1));
+        }
+    }
+
+    Scalar operator()(Scalar x) const {
+        const Scalar x2 = x * x;
+        Scalar sum = coefficients[TERMS - 1];
+        for (int k = TERMS - 2; k >= 0; --k) {
+            sum = sum * x2 + coefficients[k];
+        }
+        return x * sum;
+    }
+};
+
+// Ансамбль математических маятников в раскладке SoA: одинаковые параметры
+// ядра, независимые начальные условия. Синус многочленом (PolynomialSine),
+// ограничение угла через min/max, поэтому цикл векторизуется и float дает
+// вдвое больше маятников на инструкцию, чем double (проверка:
+// -O3 -fopt-info-vec). Учитывается только вязкая часть сопротивления.
+template <typename Precision, typename Damping>
+void stepMathPendulumEnsemble(const MathPendulumKernel<Precision, Damping> &kernel,
+                              typename Precision::Scalar *angles,
+                              typename Precision::Scalar *angularVelocities,
+                              std::size_t count, typename Precision::Scalar dt)
+{
+    static_assert(!Damping::hasDryFriction, "Ensemble kernel does not handle stick-slip events");
+    using Scalar = typename Precision::Scalar;
+    const Scalar k = -kernel.gravity / kernel.length * PhysicsConstants<Scalar>::radToDeg();
+    const Scalar degToRad = PhysicsConstants<Scalar>::degToRad();
+    const Scalar maxAngle = kernel.maxAngle;
+    const PolynomialSine<Scalar> sine;
+
+    for (std::size_t i = 0; i < count; ++i) {
+        Scalar alpha = k * sine(angles[i] * degToRad);
+        if constexpr (!Damping::isEmpty) {
+            alpha += kernel.damping.viscousForce(angularVelocities[i]);
+        }
+        Scalar omega = angularVelocities[i] + alpha * dt;
+        Scalar angle = angles[i] + omega * dt;
+        angle = angle > maxAngle ? maxAngle : angle;
+        angle = angle < -maxAngle ? -maxAngle : angle;
+        angularVelocities[i] = omega;
+        angles[i] = angle;
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Маятник Капицы (вибрирующий подвес)
+// ---------------------------------------------------------------------------
+
+// Состояние: угол и угловая скорость (градусы, угол не ограничен —
+// верхнее положение равновесия тоже рабочее), фаза колебаний подвеса
+// (рад, в пределах [0, 2π)) и рассеянная энергия (Дж)
+template <typename Precision>
+struct KapitzaPendulumState {
+    typename Precision::Sum angle{};
+    typename Precision::Scalar angularVelocity{};
+    typename Precision::Scalar drivePhase{};
+    typename Precision::Sum dissipatedEnergy{};
+};
+
+// Подвес колеблется по вертикали: y = a·cos(Ωt).
+// Averaged = false — полное уравнение, шаг должен разрешать период подвеса.
+// Averaged = true — движение, усредненное по быстрым колебаниям
+// (эффективный потенциал Капицы): к силе тяжести добавляется
+// -(aΩ)²/(2L²)·sinθ·cosθ, и шаг задается только медленным движением.
+// Фаза подвеса в усредненной модели продвигается лишь для отрисовки.
+template <typename Precision, bool Averaged,
+          typename Damping = DampingModel<typename Precision::Scalar>>
+struct KapitzaPendulumKernel {
+    using Scalar = typename Precision::Scalar;
+    using State = KapitzaPendulumState<Precision>;
+
+    Scalar gravity = PhysicsConstants<Scalar>::gravity();
+    Scalar length = Scalar(10.0);
+    Scalar mass = Scalar(1.0);
+    Scalar driveAmplitude = Scalar(0.5);   // м
+    Scalar driveFrequency = Scalar(50.0);  // рад/с
+    Damping damping;
+
+    // Угловое ускорение от силы тяжести и вибрации подвеса (град/с²)
+    Scalar conservativeAcceleration(const State &state) const {
+        using std::sin;
+        using std::cos;
+        Scalar angle = state.angle;
+        Scalar angleRad = angle * PhysicsConstants<Scalar>::degToRad();
+        Scalar acceleration;
+        if constexpr (Averaged) {
+            Scalar drive = driveAmplitude * driveFrequency / length;
+            acceleration = -gravity / length * sin(angleRad)
+                           - Scalar(0.5) * drive * drive * sin(angleRad) * cos(angleRad);
+        } else {
+            Scalar pivotAcceleration = -driveAmplitude * driveFrequency * driveFrequency * cos(state.drivePhase);
+            acceleration = -(gravity + pivotAcceleration) / length * sin(angleRad);
+        }
+        return acceleration * PhysicsConstants<Scalar>::radToDeg();
+    }
+
+    Scalar energyScale() const {
+        const Scalar degToRad = PhysicsConstants<Scalar>::degToRad();
+        return mass * length * length * degToRad * degToRad;
+    }
+
+    void step(State &state, Scalar dt) const {
+        using std::floor;
+        dampedEulerStep(damping, state.angle, state.angularVelocity, state.dissipatedEnergy,
+                        conservativeAcceleration(state), Scalar(1), energyScale(), dt);
+
+        // Фаза хранится приведенной, чтобы не терять точность на долгом прогоне
+        const Scalar twoPi = Scalar(2) * PhysicsConstants<Scalar>::pi();
+        Scalar phase = state.drivePhase + driveFrequency * dt;
+        state.drivePhase = phase - twoPi * floor(phase / twoPi);
+    }
+
+    bool isStuck(const State &state) const {
+        return isStuckByDryFriction(damping, state.angularVelocity, conservativeAcceleration(state), Scalar(1));
+    }
+};
+
+// ---------------------------------------------------------------------------
+// Пружинный маятник
+// ---------------------------------------------------------------------------
+
+// Состояние: смещение от равновесия (м), скорость (м/с) и рассеянная
+// сопротивлением энергия (Дж)
+template <typename Precision>
+struct SpringPendulumState {
+    typename Precision::Sum position{};
+    typename Precision::Scalar velocity{};
+    typename Precision::Sum dissipatedEnergy{};
+};
+
+template <typename Precision,
+          typename Damping = DampingModel<typename Precision::Scalar>>
+struct SpringPendulumKernel {
+    using Scalar = typename Precision::Scalar;
+    using State = SpringPendulumState<Precision>;
+
+    Scalar mass = Scalar(1.0);
+    Scalar springConstant = Scalar(10.0);
+    // Нижний упор: груз не может подняться выше точки подвеса
+    Scalar minPosition = std::numeric_limits<Scalar>::lowest();
+    Damping damping;
+
+    Scalar conservativeAcceleration(const State &state) const {
+        Scalar position = state.position;
+        return -springConstant * position / mass;
+    }
+
+    void step(State &state, Scalar dt) const {
+        dampedEulerStep(damping, state.position, state.velocity, state.dissipatedEnergy,
+                        conservativeAcceleration(state), mass, Scalar(1), dt);
+
+        Scalar position = state.position;
+        if (position < minPosition) {
+            state.position.set(minPosition);
+            state.velocity = Scalar(0);
+        }
+    }
+
+    bool isStuck(const State &state) const {
+        return isStuckByDryFriction(damping, state.velocity, conservativeAcceleration(state), mass);
+    }
+};
+
+// ---------------------------------------------------------------------------
+// Сферический маятник во вращающейся системе отсчета (маятник Фуко)
+// ---------------------------------------------------------------------------
+
+// Состояние: положение груза относительно точки подвеса (м) и скорость (м/с)
+// в местной системе: x — на восток, y — на север, z — вверх
+template <typename Precision>
+struct SphericalPendulumState {
+    typename Precision::Sum x{};
+    typename Precision::Sum y{};
+    typename Precision::Sum z{};
+    typename Precision::Scalar vx{};
+    typename Precision::Scalar vy{};
+    typename Precision::Scalar vz{};
+    typename Precision::Sum dissipatedEnergy{};
+};
+
+// Шаг RATTLE для связи |r| = L с точным поворотом скорости силой Кориолиса
+// (расщепление Странга: полповорота, шаг RATTLE, полповорота). RATTLE
+// симплектичен и сохраняет связь с точностью округления, а сила Кориолиса
+// работы не совершает и только поворачивает скорость, поэтому ее точный
+// поворот не вносит дрейфа энергии: ошибка энергии ограничена и не растет
+// со временем. Величина ее — порядка (ω·dt)²; при 400 шагах на период
+// (как в FoucaultPendulum) это около 6e-5 энергии колебаний.
+// Центробежная сила включена в g.
+template <typename Precision>
+struct FoucaultPendulumKernel {
+    using Scalar = typename Precision::Scalar;
+    using State = SphericalPendulumState<Precision>;
+
+    Scalar gravity = PhysicsConstants<Scalar>::gravity();
+    Scalar length = Scalar(10.0);
+    // Угловая скорость вращения Земли (рад/с) и широта (градусы)
+    Scalar earthRate = Scalar(7.2921159e-5);
+    Scalar latitude = Scalar(45.0);
+
+    void step(State &state, Scalar dt) const {
+        using std::sqrt;
+        const Scalar half = Scalar(0.5) * dt;
+        rotateVelocity(state, half);
+
+        // Полушаг скорости и свободный шаг положения
+        Scalar qx = state.x, qy = state.y, qz = state.z;
+        Scalar dx = dt * state.vx;
+        Scalar dy = dt * state.vy;
+        Scalar dz = dt * (state.vz - gravity * half);
+
+        // Множитель связи: |q + d - mu·q| = L (меньший корень)
+        const Scalar lengthSquared = length * length;
+        Scalar px = qx + dx, py = qy + dy, pz = qz + dz;
+        Scalar pq = px * qx + py * qy + pz * qz;
+        Scalar pp = px * px + py * py + pz * pz;
+        Scalar discriminant = pq * pq - lengthSquared * (pp - lengthSquared);
+        Scalar mu = (pq - sqrt(discriminant)) / lengthSquared;
+        dx -= mu * qx;
+        dy -= mu * qy;
+        dz -= mu * qz;
+        state.x.add(dx);
+        state.y.add(dy);
+        state.z.add(dz);
+
+        // Второй полушаг скорости и проекция на касательную плоскость
+        Scalar nx = qx + dx, ny = qy + dy, nz = qz + dz;
+        Scalar vx = dx / dt, vy = dy / dt, vz = dz / dt - gravity * half;
+        Scalar radial = (vx * nx + vy * ny + vz * nz) / lengthSquared;
+        state.vx = vx - radial * nx;
+        state.vy = vy - radial * ny;
+        state.vz = vz - radial * nz;
+
+        rotateVelocity(state, half);
+    }
+
+    // Точное решение v' = -2Ω×v за время h — поворот вокруг оси Ω
+    // на угол -2|Ω|h, после которого скорость снова проецируется на
+    // касательную плоскость
+    void rotateVelocity(State &state, Scalar h) const {
+        using std::sin;
+        using std::cos;
+        const Scalar latitudeRad = latitude * PhysicsConstants<Scalar>::degToRad();
+        const Scalar ky = cos(latitudeRad), kz = sin(latitudeRad);
+        const Scalar angle = Scalar(-2) * earthRate * h;
+        const Scalar c = cos(angle), s = sin(angle);
+
+        Scalar vx = state.vx, vy = state.vy, vz = state.vz;
+        Scalar kv = ky * vy + kz * vz;
+        // k × v при k = (0, ky, kz)
+        Scalar cx = ky * vz - kz * vy;
+        Scalar cy = kz * vx;
+        Scalar cz = -ky * vx;
+        vx = vx * c + cx * s;
+        vy = vy * c + cy * s + ky * kv * (Scalar(1) - c);
+        vz = vz * c + cz * s + kz * kv * (Scalar(1) - c);
+
+        Scalar x = state.x, y = state.y, z = state.z;
+        Scalar radial = (vx * x + vy * y + vz * z) / (length * length);
+        state.vx = vx - radial * x;
+        state.vy = vy - radial * y;
+        state.vz = vz - radial * z;
+    }
+
+    // Удельная механическая энергия (Дж/кг) для контроля дрейфа
+    Scalar specificEnergy(const State &state) const {
+        Scalar z = state.z;
+        return Scalar(0.5) * (state.vx * state.vx + state.vy * state.vy + state.vz * state.vz) + gravity * z;
+    }
+
+    bool isStuck(const State &) const { return false; }
+};
+
+// ---------------------------------------------------------------------------
+// Упругий маятник (груз на пружине, которая и растягивается, и качается)
+// ---------------------------------------------------------------------------
+
+// Состояние: положение груза относительно точки подвеса (м) и скорость
+// (м/с) в плоскости качаний: x — по горизонтали, y — вверх
+template <typename Precision>
+struct ElasticPendulumState {
+    typename Precision::Sum x{};
+    typename Precision::Sum y{};
+    typename Precision::Scalar vx{};
+    typename Precision::Scalar vy{};
+    typename Precision::Sum dissipatedEnergy{};
+};
+
+// Метод Штёрмера–Верле (скоростная форма) в декартовых координатах: в них
+// кинетическая энергия не зависит от положения, и схема остается явной и
+// симплектичной. Энергия не дрейфует и на хаотических режимах, поэтому
+// обмен энергией между растяжением и качанием можно считать часами
+// модельного времени. Сопротивление не учитывается.
+template <typename Precision>
+struct ElasticPendulumKernel {
+    using Scalar = typename Precision::Scalar;
+    using State = ElasticPendulumState<Precision>;
+
+    Scalar gravity = PhysicsConstants<Scalar>::gravity();
+    Scalar mass = Scalar(1.0);
+    Scalar springConstant = Scalar(30.0);
+    Scalar restLength = Scalar(1.0);
+
+    // Ускорение от пружины и силы тяжести (м/с²)
+    void acceleration(Scalar x, Scalar y, Scalar &ax, Scalar &ay) const {
+        using std::sqrt;
+        Scalar r = sqrt(x * x + y * y);
+        Scalar tension = r > Scalar(0) ? springConstant / mass * (Scalar(1) - restLength / r) : Scalar(0);
+        ax = -tension * x;
+        ay = -tension * y - gravity;
+    }
+
+    void step(State &state, Scalar dt) const {
+        const Scalar half = Scalar(0.5) * dt;
+        Scalar ax, ay;
+        acceleration(state.x, state.y, ax, ay);
+        Scalar vx = state.vx + half * ax;
+        Scalar vy = state.vy + half * ay;
+        state.x.add(dt * vx);
+        state.y.add(dt * vy);
+        acceleration(state.x, state.y, ax, ay);
+        state.vx = vx + half * ax;
+        state.vy = vy + half * ay;
+    }
+
+    // Механическая энергия (Дж) относительно точки подвеса
+    Scalar energy(const State &state) const {
+        using std::sqrt;
+        Scalar x = state.x, y = state.y;
+        Scalar stretch = sqrt(x * x + y * y) - restLength;
+        return Scalar(0.5) * mass * (state.vx * state.vx + state.vy * state.vy) +
+               Scalar(0.5) * springConstant * stretch * stretch + mass * gravity * y;
+    }
+
+    bool isStuck(const State &) const { return false; }
+};
+
+#endif
@@ -0,0 +1,297 @@
+#ifndef PHYSICSMODEL_H
+#define PHYSICSMODEL_H
+
+#include <memory>
+#include <utility>
+#include <vector>
+#include "PendulumPhysics.h"
+#include "SpectralAnalyzer.h"
+
+// Максимальное число компонент состояния в снимке (шесть пар «угол,
+// скорость» для сравнения вариантов)
+constexpr int PHYSICS_STATE_SIZE = 12;
+
+// Снимок состояния, который поток физики передает интерфейсу.
+// Время хранится как номер шага: simulatedTime = step · dt без накопления
+// ошибки, сколько бы ни длился прогон.
+struct PhysicsSnapshot {
+    long long step = 0;
+    double simulatedTime = 0.0;
+    double stepSize = 0.0;
+    // Компоненты состояния; их смысл задает модель (например, угол и
+    // угловая скорость математического маятника)
+    double state[PHYSICS_STATE_SIZE] = {};
+    // Состояние на предыдущем шаге, для интерполяции при отрисовке
+    double previousState[PHYSICS_STATE_SIZE] = {};
+    double dissipatedEnergy = 0.0;
+    bool stuckByFriction = false;
+    SpectralEstimate spectrum;
+    // Номер последнего пакета правок, который учтен в снимке (см.
+    // PhysicsWorker::queueParameterEdits)
+    long long parameterRevision = 0;
+};
+
+// Линейная интерполяция компоненты состояния на момент time между
+// предыдущим и последним шагом
+inline double interpolateState(const PhysicsSnapshot &snapshot, int index, double time)
+{
+    if (snapshot.stepSize <= 0.0) {
+        return snapshot.state[index];
+    }
+    double fraction = 1.0 - (snapshot.simulatedTime - time) / snapshot.stepSize;
+    fraction = fraction < 0.0 ? 0.0 : (fraction > 1.0 ? 1.0 : fraction);
+    return snapshot.previousState[index] + (snapshot.state[index] - snapshot.previousState[index]) * fraction;
+}
+
+// Параметры, которые можно менять на ходу (см. PhysicsModel::setParameter)
+enum class PhysicsParameter {
+    Length,          // длина нити или пружины без нагрузки (м)
+    Mass,            // масса груза (кг)
+    SpringConstant,  // жесткость пружины (Н/м)
+    MinPosition      // нижний упор пружинного маятника (м от равновесия)
+};
+
+// Одна правка параметра; правки из одного пакета применяются вместе
+struct ParameterEdit {
+    PhysicsParameter parameter;
+    double value;
+};
+
+// Модель, которую поток физики продвигает пакетами шагов.
+// Виртуальный вызов делается один раз на пакет, внутри пакета работает
+// ядро с моделью сопротивления, выбранной при создании.
+class PhysicsModel
+{
+public:
+    virtual ~PhysicsModel() = default;
+
+    virtual void advance(long steps, double dt) = 0;
+    virtual void writeSnapshot(PhysicsSnapshot &snapshot) const = 0;
+    // Полная копия модели для ключевых кадров перемотки
+    virtual std::unique_ptr<PhysicsModel> clone() const = 0;
+    // Смена параметра между шагами; состояние сохраняется.
+    // false — модель этот параметр на ходу не меняет.
+    virtual bool setParameter(PhysicsParameter parameter, double value)
+    {
+        (void)parameter;
+        (void)value;
+        return false;
+    }
+};
+
+// Координата, по которой ведется спектральный анализ
+template <typename Precision>
+double stateCoordinate(const MathPendulumState<Precision> &state)
+{
+    return static_cast<double>(typename Precision::Scalar(state.angle));
+}
+
+template <typename Precision>
+double stateCoordinate(const SpringPendulumState<Precision> &state)
+{
+    return static_cast<double>(typename Precision::Scalar(state.position));
+}
+
+template <typename Precision>
+double stateCoordinate(const KapitzaPendulumState<Precision> &state)
+{
+    return static_cast<double>(typename Precision::Scalar(state.angle));
+}
+
+// Для маятника Фуко — смещение на восток
+template <typename Precision>
+double stateCoordinate(const SphericalPendulumState<Precision> &state)
+{
+    return static_cast<double>(typename Precision::Scalar(state.x));
+}
+
+// Для упругого маятника — горизонтальное смещение
+template <typename Precision>
+double stateCoordinate(const ElasticPendulumState<Precision> &state)
+{
+    return static_cast<double>(typename Precision::Scalar(state.x));
+}
+
+// Запись компонент состояния ядра в массив снимка
+template <typename Precision>
+void writeState(const MathPendulumState<Precision> &state, double *components)
+{
+    components[0] = stateCoordinate(state);
+    components[1] = static_cast<double>(state.angularVelocity);
+}
+
+template <typename Precision>
+void writeState(const SpringPendulumState<Precision> &state, double *components)
+{
+    components[0] = stateCoordinate(state);
+    components[1] = static_cast<double>(state.velocity);
+}
+
+// Угол, угловая скорость и фаза колебаний подвеса
+template <typename Precision>
+void writeState(const KapitzaPendulumState<Precision> &state, double *components)
+{
+    components[0] = stateCoordinate(state);
+    components[1] = static_cast<double>(state.angularVelocity);
+    components[2] = static_cast<double>(state.drivePhase);
+}
+
+// Положение x, y, z и скорость vx, vy, vz
+template <typename Precision>
+void writeState(const SphericalPendulumState<Precision> &state, double *components)
+{
+    using Scalar = typename Precision::Scalar;
+    components[0] = stateCoordinate(state);
+    components[1] = static_cast<double>(Scalar(state.y));
+    components[2] = static_cast<double>(Scalar(state.z));
+    components[3] = static_cast<double>(state.vx);
+    components[4] = static_cast<double>(state.vy);
+    components[5] = static_cast<double>(state.vz);
+}
+
+// Положение x, y и скорость vx, vy
+template <typename Precision>
+void writeState(const ElasticPendulumState<Precision> &state, double *components)
+{
+    using Scalar = typename Precision::Scalar;
+    components[0] = stateCoordinate(state);
+    components[1] = static_cast<double>(Scalar(state.y));
+    components[2] = static_cast<double>(state.vx);
+    components[3] = static_cast<double>(state.vy);
+}
+
+// Применение правки к ядру. Общий вариант — для ядер, которые на ходу
+// ничего не меняют; перегрузки ниже — для остальных.
+template <typename Kernel>
+bool applyParameter(Kernel &kernel, PhysicsParameter parameter, double value)
+{
+    (void)kernel;
+    (void)parameter;
+    (void)value;
+    return false;
+}
+
+template <typename Precision, typename Damping, typename Integrator, bool Linearised>
+bool applyParameter(MathPendulumKernel<Precision, Damping, Integrator, Linearised> &kernel,
+                    PhysicsParameter parameter, double value)
+{
+    using Scalar = typename Precision::Scalar;
+    switch (parameter) {
+    case PhysicsParameter::Length: kernel.length = Scalar(value); return true;
+    case PhysicsParameter::Mass: kernel.mass = Scalar(value); return true;
+    default: return false;
+    }
+}
+
+template <typename Precision, bool Averaged, typename Damping>
+bool applyParameter(KapitzaPendulumKernel<Precision, Averaged, Damping> &kernel, PhysicsParameter parameter, double value)
+{
+    using Scalar = typename Precision::Scalar;
+    switch (parameter) {
+    case PhysicsParameter::Length: kernel.length = Scalar(value); return true;
+    case PhysicsParameter::Mass: kernel.mass = Scalar(value); return true;
+    default: return false;
+    }
+}
+
+// Смещение отсчитывается от равновесия, поэтому вместе с массой или
+// жесткостью интерфейс передает и новый упор
+template <typename Precision, typename Damping>
+bool applyParameter(SpringPendulumKernel<Precision, Damping> &kernel, PhysicsParameter parameter, double value)
+{
+    using Scalar = typename Precision::Scalar;
+    switch (parameter) {
+    case PhysicsParameter::Mass: kernel.mass = Scalar(value); return true;
+    case PhysicsParameter::SpringConstant: kernel.springConstant = Scalar(value); return true;
+    case PhysicsParameter::MinPosition: kernel.minPosition = Scalar(value); return true;
+    default: return false;
+    }
+}
+
+// Длина — длина пружины без нагрузки
+template <typename Precision>
+bool applyParameter(ElasticPendulumKernel<Precision> &kernel, PhysicsParameter parameter, double value)
+{
+    using Scalar = typename Precision::Scalar;
+    switch (parameter) {
+    case PhysicsParameter::Length: kernel.restLength = Scalar(value); return true;
+    case PhysicsParameter::Mass: kernel.mass = Scalar(value); return true;
+    case PhysicsParameter::SpringConstant: kernel.springConstant = Scalar(value); return true;
+    default: return false;
+    }
+}
+
+// Модель на основе ядра шага из PendulumPhysics.h. Каждый шаг подается
+// в спектральный анализатор, так что измеренный период и гармоники не
+// зависят от частоты кадров.
+template <typename Kernel>
+class KernelModel : public PhysicsModel
+{
+public:
+    using State = typename Kernel::State;
+    using Scalar = typename Kernel::Scalar;
+
+    KernelModel(const Kernel &kernel, const State &state) :
+        kernel(kernel), state(state), previousState(state) {}
+
+    void advance(long steps, double dt) override
+    {
+        if (dt != stepSize) {
+            analyzer.reset(dt);
+            stepSize = dt;
+        }
+        const Scalar step = Scalar(dt);
+        for (long i = 0; i + 1 < steps; ++i) {
+            stepOnce(step);
+        }
+        if (steps > 0) {
+            previousState = state;
+            stepOnce(step);
+        }
+        stepCount += steps;
+    }
+
+    void writeSnapshot(PhysicsSnapshot &snapshot) const override
+    {
+        snapshot.step = stepCount;
+        snapshot.simulatedTime = stepCount * stepSize;
+        snapshot.stepSize = stepSize;
+        writeState(previousState, snapshot.previousState);
+        writeState(state, snapshot.state);
+        snapshot.dissipatedEnergy = static_cast<double>(Scalar(state.dissipatedEnergy));
+        snapshot.stuckByFriction = kernel.isStuck(state);
+        snapshot.spectrum = analyzer.estimate();
+    }
+
+    std::unique_ptr<PhysicsModel> clone() const override
+    {
+        return std::make_unique<KernelModel>(*this);
+    }
+
+    bool setParameter(PhysicsParameter parameter, double value) override
+    {
+        return applyParameter(kernel, parameter, value);
+    }
+
+private:
+    void stepOnce(Scalar step)
+    {
+        kernel.step(state, step);
+        analyzer.addSample(stateCoordinate(state));
+    }
+
+    Kernel kernel;
+    State state;
+    State previousState;
+    long long stepCount = 0;
+    double stepSize = 0.0;
+    SpectralAnalyzer analyzer;
+};
+
+template <typename Kernel>
+std::unique_ptr<PhysicsModel> makeKernelModel(const Kernel &kernel, const typename Kernel::State &state)
+{
+    return std::make_unique<KernelModel<Kernel>>(kernel, state);
+}
+
+#endif
@@ -0,0 +1,277 @@
+#include "PhysicsWorker.h"
+#include <QMutexLocker>
+#include <cmath>
+
+// Конструктор потока физики
+PhysicsWorker::PhysicsWorker(QObject *parent) :
+    QThread(parent)
+{
+}
+
+// Деструктор: поток должен завершиться раньше модели
+PhysicsWorker::~PhysicsWorker()
+{
+    stopSimulation();
+}
+
+// Запуск новой модели. Начальное состояние публикуется сразу, до первого шага.
+void PhysicsWorker::startSimulation(std::unique_ptr<PhysicsModel> newModel, double dt)
+{
+    stopSimulation();
+
+    model = std::move(newModel);
+    stepSize = dt;
+    // Правки прошлой модели вошли в параметры новой
+    appliedRevision = queuedRevision;
+    publishSnapshot();
+    timeline.reset(*model);
+
+    stopRequested = false;
+    paused = false;
+    seekRequested = false;
+    pendingEdits.clear();
+    recordedSteps = 0;
+    simulatedTimeBase = 0.0;
+    clock.start();
+    start();
+}
+
+void PhysicsWorker::pauseSimulation()
+{
+    QMutexLocker locker(&mutex);
+    rebaseLocked();
+    paused = true;
+    commandChanged.wakeAll();
+}
+
+void PhysicsWorker::resumeSimulation()
+{
+    QMutexLocker locker(&mutex);
+    clock.restart();
+    paused = false;
+    commandChanged.wakeAll();
+}
+
+// Смена скорости: уже прошедшее модельное время сохраняется
+void PhysicsWorker::setTimeScale(double scale)
+{
+    QMutexLocker locker(&mutex);
+    rebaseLocked();
+    currentTimeScale = scale;
+    commandChanged.wakeAll();
+}
+
+void PhysicsWorker::skipAhead(double seconds)
+{
+    QMutexLocker locker(&mutex);
+    simulatedTimeBase += seconds;
+    commandChanged.wakeAll();
+}
+
+// Запрос перемотки; без запущенного потока его некому выполнить
+void PhysicsWorker::seek(double time)
+{
+    if (!isRunning()) {
+        return;
+    }
+    QMutexLocker locker(&mutex);
+    seekRequested = true;
+    seekTarget = qMax(time, 0.0);
+    commandChanged.wakeAll();
+}
+
+// Без запущенного потока правка войдет в следующую модель при ее создании
+long long PhysicsWorker::queueParameterEdits(const std::vector<ParameterEdit> &edits)
+{
+    if (!isRunning()) {
+        return 0;
+    }
+    QMutexLocker locker(&mutex);
+    pendingEdits.insert(pendingEdits.end(), edits.begin(), edits.end());
+    commandChanged.wakeAll();
+    return ++queuedRevision;
+}
+
+double PhysicsWorker::recordedTime() const
+{
+    QMutexLocker locker(&mutex);
+    return recordedSteps * stepSize;
+}
+
+double PhysicsWorker::timeScale() const
+{
+    QMutexLocker locker(&mutex);
+    return currentTimeScale;
+}
+
+double PhysicsWorker::simulatedTimeNow() const
+{
+    QMutexLocker locker(&mutex);
+    return targetTimeLocked();
+}
+
+// Модельное время, до которого нужно досчитать (мьютекс захвачен)
+double PhysicsWorker::targetTimeLocked() const
+{
+    if (paused || !clock.isValid()) {
+        return simulatedTimeBase;
+    }
+    return simulatedTimeBase + currentTimeScale * clock.nsecsElapsed() * 1e-9;
+}
+
+// Перенос начала отсчета в текущий момент (мьютекс захвачен)
+void PhysicsWorker::rebaseLocked()
+{
+    simulatedTimeBase = targetTimeLocked();
+    clock.restart();
+}
+
+// Остановка потока с ожиданием его завершения
+void PhysicsWorker::stopSimulation()
+{
+    {
+        QMutexLocker locker(&mutex);
+        stopRequested = true;
+        commandChanged.wakeAll();
+    }
+    wait();
+}
+
+bool PhysicsWorker::isPaused() const
+{
+    QMutexLocker locker(&mutex);
+    return paused;
+}
+
+// Снимок модели с номером примененных правок
+void PhysicsWorker::publishSnapshot()
+{
+    PhysicsSnapshot &snapshot = snapshots.writeBuffer();
+    model->writeSnapshot(snapshot);
+    snapshot.parameterRevision = appliedRevision;
+    snapshots.publish();
+}
+
+const PhysicsSnapshot &PhysicsWorker::latestSnapshot()
+{
+    snapshots.fetch();
+    return snapshots.readBuffer();
+}
+
+// Цикл интегрирования. Число выполненных шагов сравнивается с модельным
+// временем, пересчитанным из реального (за вычетом пауз), поэтому модельное
+// время не отстает и не убегает вперед, а шаг всегда равен stepSize.
+// При ускорении в одном пакете выполняется много шагов подряд, а
+// публикуется только конечное состояние.
+void PhysicsWorker::run()
+{
+    long long stepsDone = 0;
+
+    QMutexLocker locker(&mutex);
+    while (!stopRequested) {
+        if (seekRequested) {
+            seekRequested = false;
+            double time = seekTarget;
+            long long furthestStep = recordedSteps;
+            locker.unlock();
+            stepsDone = performSeek(time, furthestStep);
+            locker.relock();
+            simulatedTimeBase = qMin(time, stepsDone * stepSize);
+            clock.restart();
+            emit seekFinished();
+            continue;
+        }
+
+        // Правки применяются и на паузе, чтобы снимок отражал новые параметры
+        if (!pendingEdits.empty()) {
+            std::vector<ParameterEdit> edits;
+            edits.swap(pendingEdits);
+            recordedSteps = stepsDone;
+            const long long revision = queuedRevision;
+            locker.unlock();
+            timeline.recordEdits(stepsDone, edits);
+            timeline.applyEdits(stepsDone, *model);
+            appliedRevision = revision;
+            publishSnapshot();
+            locker.relock();
+            continue;
+        }
+
+        if (paused) {
+            commandChanged.wait(&mutex);
+            continue;
+        }
+
+        // Модель держится на шаг впереди модельного времени
+        double targetTime = targetTimeLocked();
+        long long targetSteps = static_cast<long long>(std::floor(targetTime / stepSize)) + 1;
+        long steps = static_cast<long>(qMin<long long>(targetSteps - stepsDone, MAX_BATCH_STEPS));
+        // Пакет заканчивается на шаге ключевого кадра или записанной правки
+        steps = static_cast<long>(qMin<long long>(steps, timeline.nextKeyframeStep(stepsDone) - stepsDone));
+        long long editStep = timeline.nextEditStep(stepsDone);
+        if (editStep > 0) {
+            steps = static_cast<long>(qMin<long long>(steps, editStep - stepsDone));
+        }
+
+        if (steps > 0) {
+            // Интегрирование идет без захвата мьютекса
+            locker.unlock();
+            model->advance(steps, stepSize);
+            stepsDone += steps;
+            // После перемотки назад записанные правки повторяются
+            timeline.applyEdits(stepsDone, *model);
+            publishSnapshot();
+            timeline.record(stepsDone, *model);
+            locker.relock();
+            recordedSteps = qMax(recordedSteps, stepsDone);
+            continue;
+        }
+
+        // Сон до момента, когда понадобится следующий шаг; команды
+        // управления будят поток раньше
+        double untilNextStep = (stepsDone * stepSize - targetTime) / currentTimeScale;
+        unsigned long waitMs = static_cast<unsigned long>(std::ceil(qMax(untilNextStep, 0.0) * 1000.0));
+        commandChanged.wait(&mutex, qMax(waitMs, 1UL));
+    }
+}
+
+// Восстановление модели на шаге, соответствующем времени time (не дальше
+// посчитанного), и публикация снимка. Возвращает номер шага модели.
+// Выполняется потоком физики без захвата мьютекса.
+long long PhysicsWorker::performSeek(double time, long long furthestStep)
+{
+    // Модель держится на шаг впереди модельного времени
+    long long targetStep = static_cast<long long>(std::floor(time / stepSize)) + 1;
+    targetStep = qMin(targetStep, furthestStep);
+
+    long long keyframeStep = 0;
+    std::unique_ptr<PhysicsModel> restored = timeline.restore(targetStep, keyframeStep);
+    if (!restored) {
+        return 0;
+    }
+
+    model = std::move(restored);
+    // Кадр мог быть сохранен до правки на том же шаге
+    timeline.applyEdits(keyframeStep, *model);
+    long long step = keyframeStep;
+    while (step < targetStep) {
+        long long editStep = timeline.nextEditStep(step);
+        long long nextStep = editStep > 0 ? qMin(editStep, targetStep) : targetStep;
+        advanceModel(step, nextStep);
+        step = nextStep;
+        timeline.applyEdits(step, *model);
+    }
+    publishSnapshot();
+    return targetStep;
+}
+
+// Досчет от шага fromStep до toStep пакетами
+void PhysicsWorker::advanceModel(long long fromStep, long long toStep)
+{
+    long long remaining = toStep - fromStep;
+    while (remaining > 0) {
+        long steps = static_cast<long>(qMin<long long>(remaining, MAX_BATCH_STEPS));
+        model->advance(steps, stepSize);
+        remaining -= steps;
+    }
+}
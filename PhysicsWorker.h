@@ -0,0 +1,108 @@
+#ifndef PHYSICSWORKER_H
+#define PHYSICSWORKER_H
+
+#include <QThread>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QElapsedTimer>
+#include <memory>
+#include <vector>
+#include "PhysicsModel.h"
+#include "KeyframeTimeline.h"
+#include "TripleBuffer.h"
+
+// Поток интегрирования. Модель продвигается фиксированными шагами в
+// темпе реального времени, умноженного на timeScale, независимо от того,
+// чем занят поток интерфейса (долгая отрисовка, модальный QMessageBox).
+// Каждый пакет шагов публикуется через тройной буфер; интерфейс читает
+// последний снимок при отрисовке и никогда не блокирует физику.
+// Модель всегда на шаг впереди текущего модельного времени, поэтому
+// интерфейс может интерполировать состояние между двумя последними
+// шагами (замедленное воспроизведение без пересчета).
+class PhysicsWorker : public QThread
+{
+    Q_OBJECT
+
+public:
+    explicit PhysicsWorker(QObject *parent = nullptr);
+    ~PhysicsWorker();
+
+    // Управление вызывается только из потока интерфейса
+    void startSimulation(std::unique_ptr<PhysicsModel> newModel, double dt);
+    void pauseSimulation();
+    void resumeSimulation();
+    void stopSimulation();
+    bool isPaused() const;
+
+    // Множитель модельного времени; меняется на лету
+    void setTimeScale(double scale);
+    double timeScale() const;
+
+    // Перемотка вперед: модельное время сдвигается на seconds, и поток
+    // досчитывает пропущенные шаги так быстро, как может
+    void skipAhead(double seconds);
+
+    // Переход к моменту time уже посчитанной части прогона: модель
+    // восстанавливается из ближайшего ключевого кадра и досчитывается.
+    // Пауза сохраняется; по готовности испускается seekFinished().
+    void seek(double time);
+    // Длительность посчитанной части прогона (с)
+    double recordedTime() const;
+
+    // Правки параметров на ходу. Все правки, поступившие до следующего
+    // пакета шагов, применяются вместе на границе шага и записываются в
+    // шкалу времени; посчитанное после этого шага отбрасывается.
+    // Возвращает номер пакета: снимки с parameterRevision не меньше этого
+    // номера показывают состояние уже после правки. 0 — поток не запущен.
+    long long queueParameterEdits(const std::vector<ParameterEdit> &edits);
+
+    // Текущее модельное время для интерполяции при отрисовке
+    double simulatedTimeNow() const;
+
+    // Последний опубликованный снимок (только поток интерфейса)
+    const PhysicsSnapshot &latestSnapshot();
+
+signals:
+    void seekFinished();
+
+protected:
+    void run() override;
+
+private:
+    // Ограничение пакета: при догоняющем счете снимки все равно
+    // публикуются регулярно
+    static constexpr long MAX_BATCH_STEPS = 1000;
+
+    std::unique_ptr<PhysicsModel> model;
+    TripleBuffer<PhysicsSnapshot> snapshots;
+    double stepSize = SIMULATION_STEP;
+
+    mutable QMutex mutex;
+    QWaitCondition commandChanged;
+    bool stopRequested = false;
+    bool paused = false;
+
+    // Соответствие реального и модельного времени: t = timeBase + scale · clock
+    double currentTimeScale = 1.0;
+    double simulatedTimeBase = 0.0;
+    QElapsedTimer clock;
+
+    // Перемотка: запрос обрабатывает поток физики, более поздний запрос
+    // заменяет еще не выполненный
+    bool seekRequested = false;
+    double seekTarget = 0.0;
+    long long recordedSteps = 0;
+    KeyframeTimeline timeline;
+    std::vector<ParameterEdit> pendingEdits;
+    // Номера пакетов правок: последний принятый и последний примененный
+    long long queuedRevision = 0;
+    long long appliedRevision = 0;
+
+    double targetTimeLocked() const;
+    void rebaseLocked();
+    long long performSeek(double time, long long furthestStep);
+    void advanceModel(long long fromStep, long long toStep);
+    void publishSnapshot();
+};
+
+#endif
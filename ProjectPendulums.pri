@@ -0,0 +1,59 @@
+# Окна и физика приложения без main.cpp: общие для ProjectPendulums.pro
+# и инструментов, которые запускают те же окна (tools/InteractionReplay)
+
+INCLUDEPATH += $$PWD
+
+SOURCES += \
+    $$PWD/BobDrag.cpp \
+    $$PWD/ComparisonModel.cpp \
+    $$PWD/ComparisonView.cpp \
+    $$PWD/ElasticPendulum.cpp \
+    $$PWD/FoucaultPendulum.cpp \
+    $$PWD/FrameScheduler.cpp \
+    $$PWD/InputLatencyMonitor.cpp \
+    $$PWD/InteractionRecorder.cpp \
+    $$PWD/KeyframeTimeline.cpp \
+    $$PWD/MathPendulum.cpp \
+    $$PWD/MotionTrail.cpp \
+    $$PWD/PhysicsWorker.cpp \
+    $$PWD/ResultCache.cpp \
+    $$PWD/SceneRenderer.cpp \
+    $$PWD/SimulationControlBar.cpp \
+    $$PWD/SpectralAnalyzer.cpp \
+    $$PWD/SpringPendulum.cpp \
+    $$PWD/TrajectoryCache.cpp \
+    $$PWD/mainwindow.cpp
+
+HEADERS += \
+    $$PWD/BobDrag.h \
+    $$PWD/ComparisonModel.h \
+    $$PWD/ComparisonView.h \
+    $$PWD/DampingModels.h \
+    $$PWD/ElasticPendulum.h \
+    $$PWD/FoucaultPendulum.h \
+    $$PWD/FrameScheduler.h \
+    $$PWD/InputLatencyMonitor.h \
+    $$PWD/InteractionRecorder.h \
+    $$PWD/KeyframeTimeline.h \
+    $$PWD/MathPendulum.h \
+    $$PWD/MotionTrail.h \
+    $$PWD/ParameterRegistry.h \
+    $$PWD/PendulumPhysics.h \
+    $$PWD/PhysicsModel.h \
+    $$PWD/PhysicsWorker.h \
+    $$PWD/ResultCache.h \
+    $$PWD/SceneRenderer.h \
+    $$PWD/SimulationControlBar.h \
+    $$PWD/SpectralAnalyzer.h \
+    $$PWD/SpringPendulum.h \
+    $$PWD/TrajectoryCache.h \
+    $$PWD/TripleBuffer.h \
+    $$PWD/mainwindow.h
+
+FORMS += \
+    $$PWD/ComparisonView.ui \
+    $$PWD/ElasticPendulum.ui \
+    $$PWD/FoucaultPendulum.ui \
+    $$PWD/MathPendulum.ui \
+    $$PWD/SpringPendulum.ui \
+    $$PWD/mainwindow.ui
@@ -8,21 +8,10 @@ CONFIG += c++17
 # In order to do so, uncomment the following line.
 #DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0x060000    # disables all the APIs deprecated before Qt 6.0.0
 
-SOURCES += \
-    MathPendulum.cpp \
-    SpringPendulum.cpp \
-    main.cpp \
-    mainwindow.cpp
-
-HEADERS += \
-    MathPendulum.h \
-    SpringPendulum.h \
-    mainwindow.h
+include(ProjectPendulums.pri)
 
-FORMS += \
-    MathPendulum.ui \
-    SpringPendulum.ui \
-    mainwindow.ui
+SOURCES += \
+    main.cpp
 
 # Default rules for deployment.
 qnx: target.path = /tmp/$${TARGET}/bin
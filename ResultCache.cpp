@@ -0,0 +1,155 @@
+#include "ResultCache.h"
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <cstring>
+
+// Заголовок файла записи: метка и длина данных
+static const char RESULT_MAGIC[4] = {'P', 'R', 'C', '1'};
+static const char *RESULT_SUFFIX = ".result";
+
+ResultKey::ResultKey(const char *kind) :
+    hash(QCryptographicHash::Sha256)
+{
+    add(QByteArray(kind));
+}
+
+// Числа хэшируются побитно: ключ различает даже соседние double
+ResultKey &ResultKey::add(double value)
+{
+    hash.addData(QByteArray::fromRawData(reinterpret_cast<const char *>(&value), sizeof(value)));
+    return *this;
+}
+
+ResultKey &ResultKey::add(qint64 value)
+{
+    hash.addData(QByteArray::fromRawData(reinterpret_cast<const char *>(&value), sizeof(value)));
+    return *this;
+}
+
+// Строка вместе с длиной, чтобы соседние поля не склеивались
+ResultKey &ResultKey::add(const QByteArray &value)
+{
+    add(static_cast<qint64>(value.size()));
+    hash.addData(value);
+    return *this;
+}
+
+QByteArray ResultKey::hex() const
+{
+    return hash.result().toHex();
+}
+
+ResultCache &ResultCache::instance()
+{
+    static ResultCache cache(QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation)
+                                 + "/ProjectPendulums/results",
+                             DEFAULT_CAPACITY);
+    return cache;
+}
+
+ResultCache::ResultCache(const QString &directory, qint64 capacityBytes) :
+    cacheDirectory(directory), capacity(capacityBytes)
+{
+}
+
+// Поиск записи; попадание делает запись самой свежей для вытеснения
+bool ResultCache::lookup(const QByteArray &key, QByteArray &data)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!enabled) {
+        return false;
+    }
+
+    QFile file(filePath(key));
+    if (!file.open(QIODevice::ReadWrite)) {
+        return false;
+    }
+    char magic[sizeof(RESULT_MAGIC)];
+    qint64 size = 0;
+    if (file.read(magic, sizeof(magic)) != sizeof(magic) || std::memcmp(magic, RESULT_MAGIC, sizeof(magic)) != 0 ||
+        file.read(reinterpret_cast<char *>(&size), sizeof(size)) != sizeof(size) ||
+        size != file.size() - static_cast<qint64>(sizeof(magic) + sizeof(size))) {
+        // Поврежденная запись
+        file.remove();
+        return false;
+    }
+    data = file.read(size);
+    file.setFileTime(QDateTime::currentDateTime(), QFileDevice::FileModificationTime);
+    return data.size() == size;
+}
+
+// Запись через временный файл; после записи кэш ужимается до предела
+void ResultCache::store(const QByteArray &key, const QByteArray &data)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!enabled || data.size() > capacity) {
+        return;
+    }
+    if (!QDir().mkpath(cacheDirectory)) {
+        return;
+    }
+
+    QSaveFile file(filePath(key));
+    if (!file.open(QIODevice::WriteOnly)) {
+        return;
+    }
+    qint64 size = data.size();
+    file.write(RESULT_MAGIC, sizeof(RESULT_MAGIC));
+    file.write(reinterpret_cast<const char *>(&size), sizeof(size));
+    file.write(data);
+    if (!file.commit()) {
+        return;
+    }
+    evict();
+}
+
+void ResultCache::setEnabled(bool enabled)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    this->enabled = enabled;
+}
+
+bool ResultCache::isEnabled() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return enabled;
+}
+
+QString ResultCache::directory() const
+{
+    return cacheDirectory;
+}
+
+qint64 ResultCache::capacityBytes() const
+{
+    return capacity;
+}
+
+QString ResultCache::filePath(const QByteArray &key) const
+{
+    return cacheDirectory + '/' + QString::fromLatin1(key) + RESULT_SUFFIX;
+}
+
+// Удаление самых давних записей, пока общий размер больше предела
+void ResultCache::evict()
+{
+    QDir dir(cacheDirectory);
+    const QFileInfoList files = dir.entryInfoList(QStringList{QString("*") + RESULT_SUFFIX}, QDir::Files,
+                                                  QDir::Time | QDir::Reversed);
+    qint64 total = 0;
+    for (const QFileInfo &info : files) {
+        total += info.size();
+    }
+    for (const QFileInfo &info : files) {
+        if (total <= capacity) {
+            break;
+        }
+        if (QFile::remove(info.absoluteFilePath())) {
+            total -= info.size();
+        }
+    }
+}
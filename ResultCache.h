@@ -0,0 +1,63 @@
+#ifndef RESULTCACHE_H
+#define RESULTCACHE_H
+
+#include <QByteArray>
+#include <QCryptographicHash>
+#include <QString>
+#include <mutex>
+
+// Ключ результата расчета: SHA-256 от вида результата и всех входных
+// данных — модели, параметров, интегратора, шага и длительности. В ключ
+// входят и версия физического кода (PHYSICS_CODE_VERSION), и отпечаток
+// кода, который результат посчитал (см. codeFingerprint у пользователей
+// кэша), поэтому после изменения физики старые записи просто перестают
+// находиться.
+class ResultKey
+{
+public:
+    explicit ResultKey(const char *kind);
+
+    ResultKey &add(double value);
+    ResultKey &add(qint64 value);
+    ResultKey &add(const QByteArray &value);
+
+    QByteArray hex() const;
+
+private:
+    QCryptographicHash hash;
+};
+
+// Кэш результатов на диске с адресацией по содержимому: файл записи
+// называется ключом. Размер ограничен; при переполнении удаляются записи,
+// к которым дольше всего не обращались (время изменения файла
+// обновляется при каждом попадании). Запись атомарна, поэтому кэш
+// могут одновременно использовать несколько процессов.
+class ResultCache
+{
+public:
+    // Общий кэш приложения и утилит
+    static ResultCache &instance();
+
+    ResultCache(const QString &directory, qint64 capacityBytes);
+
+    bool lookup(const QByteArray &key, QByteArray &data);
+    void store(const QByteArray &key, const QByteArray &data);
+
+    void setEnabled(bool enabled);
+    bool isEnabled() const;
+    QString directory() const;
+    qint64 capacityBytes() const;
+
+    static constexpr qint64 DEFAULT_CAPACITY = 512LL * 1024 * 1024;
+
+private:
+    QString filePath(const QByteArray &key) const;
+    void evict();
+
+    QString cacheDirectory;
+    qint64 capacity;
+    bool enabled = true;
+    mutable std::mutex mutex;
+};
+
+#endif
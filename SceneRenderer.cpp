@@ -0,0 +1,89 @@
+#include "SceneRenderer.h"
+#include <QMutexLocker>
+#include <QPainter>
+
+// Конструктор потока отрисовки
+SceneRenderer::SceneRenderer(QObject *parent) :
+    QThread(parent)
+{
+}
+
+// Деструктор: поток должен завершиться раньше буферов кадров
+SceneRenderer::~SceneRenderer()
+{
+    stopRendering();
+}
+
+// Постановка кадра в очередь; поток запускается при первом запросе
+void SceneRenderer::submit(const QSize &size, qreal devicePixelRatio, PaintFunction paint)
+{
+    {
+        QMutexLocker locker(&mutex);
+        stopRequested = false;
+        hasRequest = true;
+        requestSize = size;
+        requestPixelRatio = devicePixelRatio;
+        requestPaint = std::move(paint);
+        requestChanged.wakeAll();
+    }
+    if (!isRunning()) {
+        start();
+    }
+}
+
+// Остановка потока с ожиданием завершения текущего кадра
+void SceneRenderer::stopRendering()
+{
+    {
+        QMutexLocker locker(&mutex);
+        stopRequested = true;
+        hasRequest = false;
+        requestPaint = nullptr;
+        requestChanged.wakeAll();
+    }
+    wait();
+}
+
+const QImage &SceneRenderer::latestFrame()
+{
+    frames.fetch();
+    return frames.readBuffer();
+}
+
+// Цикл отрисовки: берется только самый свежий запрос
+void SceneRenderer::run()
+{
+    while (true) {
+        QSize size;
+        qreal pixelRatio;
+        PaintFunction paint;
+        {
+            QMutexLocker locker(&mutex);
+            while (!hasRequest && !stopRequested) {
+                requestChanged.wait(&mutex);
+            }
+            if (stopRequested) {
+                return;
+            }
+            size = requestSize;
+            pixelRatio = requestPixelRatio;
+            paint = std::move(requestPaint);
+            hasRequest = false;
+        }
+
+        // Буфер переиспользуется, пока размер окна не меняется
+        QImage &image = frames.writeBuffer();
+        QSize pixelSize = size * pixelRatio;
+        if (image.size() != pixelSize) {
+            image = QImage(pixelSize, QImage::Format_ARGB32_Premultiplied);
+        }
+        image.setDevicePixelRatio(pixelRatio);
+        image.fill(Qt::transparent);
+        {
+            QPainter painter(&image);
+            paint(painter);
+        }
+        frames.publish();
+        emit frameReady();
+    }
+}
@@ -0,0 +1,56 @@
+#ifndef SCENERENDERER_H
+#define SCENERENDERER_H
+
+#include <QThread>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QImage>
+#include <QSize>
+#include <functional>
+#include "TripleBuffer.h"
+
+class QPainter;
+
+// Растеризация сцены в QImage в отдельном потоке. Виджет передает функцию
+// рисования со скопированными параметрами сцены и на следующем кадре
+// выводит готовое изображение, то есть отстает от физики на один кадр.
+// Поток интерфейса только копирует пиксели и остается отзывчивым, даже если
+// сглаженная отрисовка на большом экране занимает весь кадр.
+class SceneRenderer : public QThread
+{
+    Q_OBJECT
+
+public:
+    using PaintFunction = std::function<void(QPainter &)>;
+
+    explicit SceneRenderer(QObject *parent = nullptr);
+    ~SceneRenderer();
+
+    // Запрос кадра; если предыдущий запрос еще не начат, он заменяется
+    void submit(const QSize &size, qreal devicePixelRatio, PaintFunction paint);
+    void stopRendering();
+
+    // Последний готовый кадр (только поток интерфейса); пустой, пока
+    // не готов ни один кадр
+    const QImage &latestFrame();
+
+signals:
+    // Готов новый кадр; доставляется в поток интерфейса через очередь
+    void frameReady();
+
+protected:
+    void run() override;
+
+private:
+    TripleBuffer<QImage> frames;
+
+    QMutex mutex;
+    QWaitCondition requestChanged;
+    bool stopRequested = false;
+    bool hasRequest = false;
+    QSize requestSize;
+    qreal requestPixelRatio = 1.0;
+    PaintFunction requestPaint;
+};
+
+#endif
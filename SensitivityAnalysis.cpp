@@ -0,0 +1,156 @@
+#include "SensitivityAnalysis.h"
+
+// Названия параметров для отчетов
+const char *sensitivityParameterName(int parameter)
+{
+    switch (parameter) {
+    case SENS_LENGTH: return "lengthForCalculations";
+    case SENS_MASS: return "mass";
+    case SENS_SPRING_CONSTANT: return "springConstant";
+    case SENS_AIR_FRICTION: return "airFrictionCoeff";
+    default: return "";
+    }
+}
+
+namespace {
+
+// Отслеживание переходов через ноль и максимумов с линейной интерполяцией
+// внутри шага. Интерполяция выполняется в дуальной арифметике, поэтому
+// производные момента перехода получаются по теореме о неявной функции.
+class OscillationTracker {
+public:
+    void sample(const SensitivityScalar &time, const SensitivityScalar &coordinate,
+                const SensitivityScalar &velocity)
+    {
+        if (hasPrevious) {
+            if (previousCoordinate < 0.0 && coordinate >= 0.0) {
+                SensitivityScalar fraction = -previousCoordinate / (coordinate - previousCoordinate);
+                SensitivityScalar crossing = previousTime + (time - previousTime) * fraction;
+                if (crossingCount == 0) firstCrossing = crossing;
+                lastCrossing = crossing;
+                ++crossingCount;
+            }
+            if (previousVelocity > 0.0 && velocity <= 0.0) {
+                SensitivityScalar fraction = previousVelocity / (previousVelocity - velocity);
+                SensitivityScalar peak = previousCoordinate + (coordinate - previousCoordinate) * fraction;
+                SensitivityScalar peakTime = previousTime + (time - previousTime) * fraction;
+                if (peak > 0.0) {
+                    if (peakCount == 0) {
+                        firstPeak = peak;
+                        firstPeakTime = peakTime;
+                    }
+                    lastPeak = peak;
+                    lastPeakTime = peakTime;
+                    ++peakCount;
+                }
+            }
+        }
+        previousTime = time;
+        previousCoordinate = coordinate;
+        previousVelocity = velocity;
+        hasPrevious = true;
+    }
+
+    void fill(SensitivityResult &result) const
+    {
+        if (crossingCount >= 2) {
+            result.period = (lastCrossing - firstCrossing) / double(crossingCount - 1);
+            result.periodValid = true;
+        }
+        if (peakCount >= 2) {
+            result.amplitudeDecay = log(firstPeak / lastPeak) / (lastPeakTime - firstPeakTime);
+            result.decayValid = true;
+        }
+    }
+
+private:
+    bool hasPrevious = false;
+    SensitivityScalar previousTime;
+    SensitivityScalar previousCoordinate;
+    SensitivityScalar previousVelocity;
+
+    int crossingCount = 0;
+    SensitivityScalar firstCrossing;
+    SensitivityScalar lastCrossing;
+
+    int peakCount = 0;
+    SensitivityScalar firstPeak;
+    SensitivityScalar firstPeakTime;
+    SensitivityScalar lastPeak;
+    SensitivityScalar lastPeakTime;
+};
+
+// Линейное сопротивление всегда включено в ядре: при выключенном трении коэффициент равен
+// нулю, и производная по нему — чувствительность к появлению трения
+SensitivityScalar frictionVariable(double coeff, bool enabled)
+{
+    return SensitivityScalar::variable(enabled ? coeff : 0.0, SENS_AIR_FRICTION);
+}
+
+}
+
+// Математический маятник: угол в градусах, как в MathPendulum
+SensitivityResult analyzeMathPendulum(const MathSensitivityInput &input)
+{
+    using Precision = DualPrecision<SENS_PARAMETER_COUNT>;
+    using Constants = PhysicsConstants<SensitivityScalar>;
+
+    MathPendulumKernel<Precision, DampingModel<SensitivityScalar, LinearDrag>> kernel;
+    kernel.length = SensitivityScalar::variable(input.lengthForCalculations, SENS_LENGTH);
+    kernel.mass = SensitivityScalar::variable(input.mass, SENS_MASS);
+    kernel.damping.term<LinearDrag>().coeff = frictionVariable(input.airFrictionCoeff, input.airFrictionEnabled);
+
+    MathPendulumState<Precision> state;
+    state.angle = SensitivityScalar(input.angle);
+
+    OscillationTracker tracker;
+    const long steps = static_cast<long>(input.duration / input.dt);
+    for (long i = 1; i <= steps; ++i) {
+        kernel.step(state, input.dt);
+        tracker.sample(SensitivityScalar(i * input.dt), state.angle, state.angularVelocity);
+    }
+
+    SensitivityResult result;
+    result.finalCoordinate = state.angle;
+    result.finalVelocity = state.angularVelocity;
+
+    SensitivityScalar angleRad = SensitivityScalar(state.angle) * Constants::degToRad();
+    SensitivityScalar speed = state.angularVelocity * Constants::degToRad() * kernel.length;
+    SensitivityScalar height = kernel.length * (1.0 - cos(angleRad));
+    result.finalEnergy = 0.5 * kernel.mass * speed * speed + kernel.mass * kernel.gravity * height;
+
+    tracker.fill(result);
+    return result;
+}
+
+// Пружинный маятник: смещение от положения равновесия в метрах
+SensitivityResult analyzeSpringPendulum(const SpringSensitivityInput &input)
+{
+    using Precision = DualPrecision<SENS_PARAMETER_COUNT>;
+
+    SpringPendulumKernel<Precision, DampingModel<SensitivityScalar, LinearDrag>> kernel;
+    kernel.mass = SensitivityScalar::variable(input.mass, SENS_MASS);
+    kernel.springConstant = SensitivityScalar::variable(input.springConstant, SENS_SPRING_CONSTANT);
+    kernel.damping.term<LinearDrag>().coeff = frictionVariable(input.airFrictionCoeff, input.airFrictionEnabled);
+
+    SpringPendulumState<Precision> state;
+    state.position = SensitivityScalar(input.position);
+
+    OscillationTracker tracker;
+    const long steps = static_cast<long>(input.duration / input.dt);
+    for (long i = 1; i <= steps; ++i) {
+        kernel.step(state, input.dt);
+        tracker.sample(SensitivityScalar(i * input.dt), state.position, state.velocity);
+    }
+
+    SensitivityResult result;
+    result.finalCoordinate = state.position;
+    result.finalVelocity = state.velocity;
+
+    SensitivityScalar position = state.position;
+    result.finalEnergy = 0.5 * kernel.mass * state.velocity * state.velocity
+                         + 0.5 * kernel.springConstant * position * position;
+
+    tracker.fill(result);
+    return result;
+}
@@ -0,0 +1,61 @@
+#ifndef SENSITIVITYANALYSIS_H
+#define SENSITIVITYANALYSIS_H
+
+#include "DualNumber.h"
+
+// Чувствительности характеристик движения к параметрам маятника.
+// Интегратор инстанцируется дуальными числами, поэтому один прогон дает
+// значения и производные по всем параметрам одновременно.
+
+// Полосы производных (одинаковые для обоих маятников)
+enum SensitivityParameter {
+    SENS_LENGTH = 0,
+    SENS_MASS,
+    SENS_SPRING_CONSTANT,
+    SENS_AIR_FRICTION,
+    SENS_PARAMETER_COUNT
+};
+
+using SensitivityScalar = Dual<double, SENS_PARAMETER_COUNT>;
+
+const char *sensitivityParameterName(int parameter);
+
+struct MathSensitivityInput {
+    double lengthForCalculations = 10.0;
+    double mass = 1.0;
+    double angle = 30.0;
+    double airFrictionCoeff = 0.02;
+    bool airFrictionEnabled = false;
+    double dt = SIMULATION_STEP;
+    double duration = 60.0;
+};
+
+struct SpringSensitivityInput {
+    double mass = 1.0;
+    double springConstant = 10.0;
+    double position = 1.0;
+    double airFrictionCoeff = 0.1;
+    bool airFrictionEnabled = false;
+    double dt = SIMULATION_STEP;
+    double duration = 60.0;
+};
+
+// Значения характеристик вместе с производными по параметрам.
+// Период и затухание измеряются по траектории: period — среднее время между
+// восходящими переходами через ноль, amplitudeDecay — логарифмический
+// декремент положительных максимумов в секунду. periodValid/decayValid
+// ложны, если за время прогона не набралось двух переходов/максимумов.
+struct SensitivityResult {
+    SensitivityScalar finalCoordinate;
+    SensitivityScalar finalVelocity;
+    SensitivityScalar finalEnergy;
+    SensitivityScalar period;
+    SensitivityScalar amplitudeDecay;
+    bool periodValid = false;
+    bool decayValid = false;
+};
+
+SensitivityResult analyzeMathPendulum(const MathSensitivityInput &input);
+SensitivityResult analyzeSpringPendulum(const SpringSensitivityInput &input);
+
+#endif
@@ -0,0 +1,104 @@
+#include "SimulationControlBar.h"
+#include <QSlider>
+#include <QLabel>
+#include <QHBoxLayout>
+#include <cmath>
+
+// Конструктор панели; начальная скорость — реальное время
+SimulationControlBar::SimulationControlBar(QWidget *parent) :
+    QWidget(parent)
+{
+    QHBoxLayout *layout = new QHBoxLayout(this);
+    layout->setContentsMargins(0, 0, 0, 0);
+
+    timelineSlider = new QSlider(Qt::Horizontal, this);
+    timelineSlider->setObjectName("timelineSlider");
+    timelineSlider->setRange(0, TIMELINE_RESOLUTION);
+    timelineSlider->setMinimumWidth(250);
+    timelineLabel = new QLabel(this);
+    timelineLabel->setMinimumWidth(110);
+
+    layout->addWidget(new QLabel("Time:", this));
+    layout->addWidget(timelineSlider);
+    layout->addWidget(timelineLabel);
+
+    timeScaleSlider = new QSlider(Qt::Horizontal, this);
+    timeScaleSlider->setObjectName("timeScaleSlider");
+    timeScaleSlider->setRange(scaleToSlider(MIN_TIME_SCALE), scaleToSlider(MAX_TIME_SCALE));
+    timeScaleSlider->setValue(scaleToSlider(1.0));
+    timeScaleSlider->setMinimumWidth(200);
+
+    timeScaleLabel = new QLabel(this);
+    timeScaleLabel->setMinimumWidth(60);
+
+    layout->addWidget(new QLabel("Speed:", this));
+    layout->addWidget(timeScaleSlider);
+    layout->addWidget(timeScaleLabel);
+
+    connect(timeScaleSlider, &QSlider::valueChanged, this, &SimulationControlBar::on_timeScaleSlider_valueChanged);
+    connect(timelineSlider, &QSlider::valueChanged, this, &SimulationControlBar::on_timelineSlider_valueChanged);
+    updateLabel();
+    updateTimelineLabel(0.0);
+}
+
+double SimulationControlBar::timeScale() const
+{
+    return currentScale;
+}
+
+void SimulationControlBar::setTimeScale(double scale)
+{
+    timeScaleSlider->setValue(scaleToSlider(scale));
+}
+
+// Перевод положения ползунка в множитель времени
+double SimulationControlBar::sliderToScale(int value) const
+{
+    return std::pow(10.0, static_cast<double>(value) / STEPS_PER_DECADE);
+}
+
+int SimulationControlBar::scaleToSlider(double scale) const
+{
+    return static_cast<int>(std::lround(std::log10(scale) * STEPS_PER_DECADE));
+}
+
+void SimulationControlBar::updateLabel()
+{
+    int decimals = currentScale < 1.0 ? 2 : (currentScale < 10.0 ? 1 : 0);
+    timeScaleLabel->setText(QString::number(currentScale, 'f', decimals) + "x");
+}
+
+void SimulationControlBar::on_timeScaleSlider_valueChanged(int value)
+{
+    currentScale = sliderToScale(value);
+    updateLabel();
+    emit timeScaleChanged(currentScale);
+}
+
+// Обновление шкалы из потока интерфейса; сигнал перемотки при этом не
+// испускается
+void SimulationControlBar::setTimeline(double position, double duration)
+{
+    if (timelineSlider->isSliderDown()) {
+        return;
+    }
+    timelineDuration = duration;
+    int value = duration > 0.0 ? static_cast<int>(std::lround(position / duration * TIMELINE_RESOLUTION)) : 0;
+    timelineSlider->blockSignals(true);
+    timelineSlider->setValue(qBound(0, value, TIMELINE_RESOLUTION));
+    timelineSlider->blockSignals(false);
+    updateTimelineLabel(position);
+}
+
+void SimulationControlBar::updateTimelineLabel(double position)
+{
+    timelineLabel->setText(QString::number(position, 'f', 1) + " / " +
+                           QString::number(timelineDuration, 'f', 1) + " s");
+}
+
+void SimulationControlBar::on_timelineSlider_valueChanged(int value)
+{
+    double time = timelineDuration * value / TIMELINE_RESOLUTION;
+    updateTimelineLabel(time);
+    emit seekRequested(time);
+}
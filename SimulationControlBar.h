@@ -0,0 +1,57 @@
+#ifndef SIMULATIONCONTROLBAR_H
+#define SIMULATIONCONTROLBAR_H
+
+#include <QWidget>
+
+class QSlider;
+class QLabel;
+
+// Панель управления модельным временем: шкала перемотки по уже
+// посчитанной части прогона и логарифмический ползунок скорости от 0.01×
+// до 1000×
+class SimulationControlBar : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit SimulationControlBar(QWidget *parent = nullptr);
+
+    double timeScale() const;
+    void setTimeScale(double scale);
+
+    // Положение на шкале и ее длина (модельные секунды); пока пользователь
+    // тянет ползунок, шкала не двигается
+    void setTimeline(double position, double duration);
+
+    static constexpr double MIN_TIME_SCALE = 0.01;
+    static constexpr double MAX_TIME_SCALE = 1000.0;
+
+signals:
+    void timeScaleChanged(double scale);
+    void seekRequested(double time);
+
+private slots:
+    void on_timeScaleSlider_valueChanged(int value);
+    void on_timelineSlider_valueChanged(int value);
+
+private:
+    // Деления ползунка на один порядок величины
+    static constexpr int STEPS_PER_DECADE = 20;
+    // Деления шкалы перемотки
+    static constexpr int TIMELINE_RESOLUTION = 1000;
+
+    double sliderToScale(int value) const;
+    int scaleToSlider(double scale) const;
+    void updateLabel();
+    void updateTimelineLabel(double position);
+
+    QSlider *timeScaleSlider;
+    QLabel *timeScaleLabel;
+    double currentScale = 1.0;
+
+    QSlider *timelineSlider;
+    QLabel *timelineLabel;
+    double timelineDuration = 0.0;
+};
+
+#endif
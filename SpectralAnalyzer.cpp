@@ -0,0 +1,114 @@
+#include "SpectralAnalyzer.h"
+#include <cmath>
+
+namespace {
+const double TWO_PI = 6.283185307179586;
+}
+
+// Сброс анализа; dt — шаг между отсчетами
+void SpectralAnalyzer::reset(double newDt)
+{
+    *this = SpectralAnalyzer();
+    dt = newDt;
+}
+
+// Обработка очередного отсчета координаты
+void SpectralAnalyzer::addSample(double value)
+{
+    const double time = sampleIndex * dt;
+
+    if (windowActive) {
+        for (int k = 0; k < SPECTRAL_HARMONICS; ++k) {
+            double s0 = value + coefficients[k] * state1[k] - state2[k];
+            state2[k] = state1[k];
+            state1[k] = s0;
+        }
+    }
+
+    if (history >= 1 && previous < 0.0 && value >= 0.0) {
+        double fraction = -previous / (value - previous);
+        onUpwardCrossing(time - dt + fraction * dt);
+    }
+
+    if (history >= 2 && previous > beforePrevious && previous >= value && previous > 0.0) {
+        // Вершина параболы через три отсчета
+        double curvature = beforePrevious - 2.0 * previous + value;
+        double offset = curvature != 0.0 ? 0.5 * (beforePrevious - value) / curvature : 0.0;
+        double peak = previous - 0.25 * (beforePrevious - value) * offset;
+        onPeak(peak, time - dt + offset * dt);
+    }
+
+    beforePrevious = previous;
+    previous = value;
+    if (history < 2) ++history;
+    ++sampleIndex;
+}
+
+void SpectralAnalyzer::onUpwardCrossing(double crossingTime)
+{
+    if (hasCrossing) {
+        result.period = crossingTime - lastCrossingTime;
+        result.periodValid = true;
+        ++result.cycles;
+    }
+    hasCrossing = true;
+    lastCrossingTime = crossingTime;
+
+    if (windowActive) {
+        finishHarmonicWindow();
+    }
+    if (result.periodValid) {
+        startHarmonicWindow();
+    }
+}
+
+void SpectralAnalyzer::onPeak(double peak, double peakTime)
+{
+    if (hasPeak && peakTime > lastPeakTime) {
+        result.dampingRate = std::log(lastPeak / peak) / (peakTime - lastPeakTime);
+        result.dampingValid = true;
+    }
+    hasPeak = true;
+    lastPeak = peak;
+    lastPeakTime = peakTime;
+}
+
+// Настройка банка на гармоники последнего измеренного периода
+void SpectralAnalyzer::startHarmonicWindow()
+{
+    if (result.period < 4 * SPECTRAL_HARMONICS * dt) {
+        // Слишком мало отсчетов на период для высших гармоник
+        windowActive = false;
+        return;
+    }
+    for (int k = 0; k < SPECTRAL_HARMONICS; ++k) {
+        coefficients[k] = 2.0 * std::cos(TWO_PI * (k + 1) * dt / result.period);
+        state1[k] = 0.0;
+        state2[k] = 0.0;
+    }
+    windowActive = true;
+}
+
+// Амплитуды гармоник за завершившийся период
+void SpectralAnalyzer::finishHarmonicWindow()
+{
+    windowActive = false;
+
+    double amplitudes[SPECTRAL_HARMONICS];
+    for (int k = 0; k < SPECTRAL_HARMONICS; ++k) {
+        double power = state1[k] * state1[k] + state2[k] * state2[k]
+                       - coefficients[k] * state1[k] * state2[k];
+        amplitudes[k] = std::sqrt(power > 0.0 ? power : 0.0);
+    }
+    if (amplitudes[0] <= 0.0) {
+        return;
+    }
+
+    double distortion = 0.0;
+    for (int k = 0; k < SPECTRAL_HARMONICS; ++k) {
+        result.harmonics[k] = amplitudes[k] / amplitudes[0];
+        if (k > 0) distortion += result.harmonics[k] * result.harmonics[k];
+    }
+    result.harmonicDistortion = std::sqrt(distortion);
+    result.harmonicsValid = true;
+}
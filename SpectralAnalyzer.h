@@ -0,0 +1,71 @@
+#ifndef SPECTRALANALYZER_H
+#define SPECTRALANALYZER_H
+
+// Число анализируемых гармоник, включая основную
+constexpr int SPECTRAL_HARMONICS = 5;
+
+// Оценки, полученные по живому сигналу координаты
+struct SpectralEstimate {
+    long long cycles = 0;
+
+    // Период между соседними переходами через ноль снизу вверх (с)
+    bool periodValid = false;
+    double period = 0.0;
+
+    // Скорость затухания амплитуды A(t) ~ exp(-dampingRate · t) (1/с)
+    bool dampingValid = false;
+    double dampingRate = 0.0;
+
+    // Амплитуды гармоник относительно основной (harmonics[0] = 1)
+    // и коэффициент гармонических искажений sqrt(Σ A_k²) / A_1 по k ≥ 2
+    bool harmonicsValid = false;
+    double harmonics[SPECTRAL_HARMONICS] = {};
+    double harmonicDistortion = 0.0;
+};
+
+// Потоковый анализ колебаний за O(1) на шаг.
+// Период измеряется по переходам через ноль с линейной интерполяцией
+// внутри шага, затухание — по соседним максимумам с параболической
+// интерполяцией. Гармоники считаются банком фильтров Гёрцеля на частотах,
+// кратных последней измеренной частоте. Банк работает ровно один период,
+// от перехода через ноль до следующего: на концах окна сигнал близок к
+// нулю, поэтому утечка основной частоты в высшие гармоники мала без
+// оконной функции.
+class SpectralAnalyzer
+{
+public:
+    void reset(double dt);
+    void addSample(double value);
+
+    const SpectralEstimate &estimate() const { return result; }
+
+private:
+    void onUpwardCrossing(double crossingTime);
+    void onPeak(double peak, double peakTime);
+    void startHarmonicWindow();
+    void finishHarmonicWindow();
+
+    SpectralEstimate result;
+    double dt = 0.0;
+    long long sampleIndex = 0;
+
+    // Два предыдущих отсчета
+    int history = 0;
+    double previous = 0.0;
+    double beforePrevious = 0.0;
+
+    bool hasCrossing = false;
+    double lastCrossingTime = 0.0;
+
+    bool hasPeak = false;
+    double lastPeak = 0.0;
+    double lastPeakTime = 0.0;
+
+    // Банк Гёрцеля для текущего периода
+    bool windowActive = false;
+    double coefficients[SPECTRAL_HARMONICS] = {};
+    double state1[SPECTRAL_HARMONICS] = {};
+    double state2[SPECTRAL_HARMONICS] = {};
+};
+
+#endif
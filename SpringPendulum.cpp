@@ -1,13 +1,20 @@
 #include "SpringPendulum.h"
 #include "ui_SpringPendulum.h"
 #include "mainwindow.h"
+#include "FrameScheduler.h"
+#include "PhysicsWorker.h"
+#include "SceneRenderer.h"
+#include "SimulationControlBar.h"
+#include "InputLatencyMonitor.h"
 #include <QMenuBar>
 #include <QMenu>
 #include <QAction>
 #include <QPainter>
 #include <QPainterPath>
+#include <QMouseEvent>
 #include <QMessageBox>
 #include <QVBoxLayout>
+#include <QInputDialog>
 
 // Конструктор класса SpringPendulum
 SpringPendulum::SpringPendulum(QWidget *parent) :
@@ -16,33 +23,39 @@ SpringPendulum::SpringPendulum(QWidget *parent) :
     ui->setupUi(this);
     this->showFullScreen();
 
+    dampingSettings = defaultDampingSettings();
     setupMenu();
+    setupDampingMenu();
+    // Кнопки ввода подключает setupUi по именам слотов on_<кнопка>_clicked
+    defineParameters();
     calculateEquilibrium();
 
-    timer = new QTimer(this);
-    connect(timer, &QTimer::timeout, this, &SpringPendulum::updateAnimation);
+    // Кадры анимации запрашиваются только пока груз движется;
+    // интегрирование идет в отдельном потоке
+    frameScheduler = new FrameScheduler(this);
+    connect(frameScheduler, &FrameScheduler::frame, this, &SpringPendulum::updateAnimation);
+    physicsWorker = new PhysicsWorker(this);
+    sceneRenderer = new SceneRenderer(this);
+    connect(sceneRenderer, &SceneRenderer::frameReady, this, [this]() { update(); });
+    connect(physicsWorker, &PhysicsWorker::seekFinished, this, &SpringPendulum::on_physicsWorker_seekFinished);
+
+    // Управление скоростью модельного времени в углу строки меню
+    controlBar = new SimulationControlBar(this);
+    menuBar->setCornerWidget(controlBar);
+    connect(controlBar, &SimulationControlBar::timeScaleChanged, this, &SpringPendulum::on_controlBar_timeScaleChanged);
+    connect(controlBar, &SimulationControlBar::seekRequested, this, &SpringPendulum::on_controlBar_seekRequested);
+    labelClock.start();
 
     QVBoxLayout *mainLayout = new QVBoxLayout(this);
     mainLayout->setContentsMargins(0, 0, 0, 0);
     mainLayout->setMenuBar(menuBar);
     setLayout(mainLayout);
 
-    // Подключение кнопок интерфейса
-    connect(ui->ButtonOKMass, &QPushButton::clicked, this, &SpringPendulum::on_ButtonOKMass_clicked);
-    connect(ui->ButtonResetMass, &QPushButton::clicked, this, &SpringPendulum::on_ButtonResetMass_clicked);
-    connect(ui->ButtonOKPosition, &QPushButton::clicked, this, &SpringPendulum::on_ButtonOKPosition_clicked);
-    connect(ui->ButtonResetPosition, &QPushButton::clicked, this, &SpringPendulum::on_ButtonResetPosition_clicked);
-    connect(ui->ButtonOKElasticity, &QPushButton::clicked, this, &SpringPendulum::on_ButtonOKElasticity_clicked);
-    connect(ui->ButtonResetElasticity, &QPushButton::clicked, this, &SpringPendulum::on_ButtonResetElasticity_clicked);
-    connect(ui->ButtonOKAirFriction, &QPushButton::clicked, this, &SpringPendulum::on_ButtonOKAirFriction_clicked);
-    connect(ui->ButtonOffAirFriction, &QPushButton::clicked, this, &SpringPendulum::on_ButtonOffAirFriction_clicked);
-
     ui->ButtonOffAirFriction->setStyleSheet("background-color: red");
     setInputsEnabled(true);
 
     isInitialState = true;
-    maxStretch = DEFAULT_POSITION;
-    position = DEFAULT_POSITION;
+    position = maxStretch;
 }
 
 // Деструктор класса
@@ -58,9 +71,13 @@ void SpringPendulum::setupMenu()
     QMenu *fileMenu = menuBar->addMenu("Functions");
 
     QAction *startAction = new QAction("Start", this);
+    startAction->setObjectName("actionStart");
     QAction *pauseAction = new QAction("Pause", this);
+    pauseAction->setObjectName("actionPause");
     QAction *resetAction = new QAction("Reset", this);
+    resetAction->setObjectName("actionReset");
     QAction *exitAction = new QAction("Exit", this);
+    exitAction->setObjectName("actionExit");
 
     fileMenu->addAction(startAction);
     fileMenu->addAction(pauseAction);
@@ -72,50 +89,121 @@ void SpringPendulum::setupMenu()
     connect(pauseAction, &QAction::triggered, this, &SpringPendulum::on_actionPause_triggered);
     connect(resetAction, &QAction::triggered, this, &SpringPendulum::on_actionReset_triggered);
     connect(exitAction, &QAction::triggered, this, &SpringPendulum::on_actionExit_triggered);
+
+    // Отрисовка сцены в фоновом потоке для больших экранов
+    QMenu *viewMenu = menuBar->addMenu("View");
+    QAction *backgroundRenderingAction = new QAction("Background rendering", this);
+    backgroundRenderingAction->setObjectName("actionBackgroundRendering");
+    backgroundRenderingAction->setCheckable(true);
+    viewMenu->addAction(backgroundRenderingAction);
+    connect(backgroundRenderingAction, &QAction::toggled, this, &SpringPendulum::on_actionBackgroundRendering_toggled);
+    QAction *motionTrailAction = new QAction("Motion trail", this);
+    motionTrailAction->setObjectName("actionMotionTrail");
+    motionTrailAction->setCheckable(true);
+    viewMenu->addAction(motionTrailAction);
+    connect(motionTrailAction, &QAction::toggled, this, &SpringPendulum::on_actionMotionTrail_toggled);
+}
+
+// Меню выбора нелинейных сил сопротивления
+void SpringPendulum::setupDampingMenu()
+{
+    dampingMenu = menuBar->addMenu("Damping");
+
+    quadraticDragAction = new QAction("Quadratic drag", this);
+    quadraticDragAction->setObjectName("actionQuadraticDrag");
+    quadraticDragAction->setCheckable(true);
+    dryFrictionAction = new QAction("Dry (Coulomb) friction", this);
+    dryFrictionAction->setObjectName("actionDryFriction");
+    dryFrictionAction->setCheckable(true);
+    QAction *coefficientsAction = new QAction("Set coefficients...", this);
+    coefficientsAction->setObjectName("actionDampingCoefficients");
+
+    dampingMenu->addAction(quadraticDragAction);
+    dampingMenu->addAction(dryFrictionAction);
+    dampingMenu->addSeparator();
+    dampingMenu->addAction(coefficientsAction);
+
+    connect(quadraticDragAction, &QAction::toggled, this, &SpringPendulum::on_actionQuadraticDrag_toggled);
+    connect(dryFrictionAction, &QAction::toggled, this, &SpringPendulum::on_actionDryFriction_toggled);
+    connect(coefficientsAction, &QAction::triggered, this, &SpringPendulum::on_actionDampingCoefficients_triggered);
 }
 
-// Отрисовка пружинного маятника
+// Значения коэффициентов сопротивления по умолчанию (все силы выключены)
+DampingSettings SpringPendulum::defaultDampingSettings() const
+{
+    DampingSettings settings;
+    settings.linearCoeff = DEFAULT_LINEAR_DRAG;
+    settings.quadraticCoeff = DEFAULT_QUADRATIC_DRAG;
+    settings.dryLevel = DEFAULT_DRY_FRICTION;
+    return settings;
+}
+
+// Отрисовка пружинного маятника. В режиме фоновой отрисовки сцена
+// растеризуется в потоке SceneRenderer, а здесь выводится последний готовый
+// кадр; новый кадр заказывается только при изменении сцены.
 void SpringPendulum::paintEvent(QPaintEvent *event)
 {
     Q_UNUSED(event);
     QPainter painter(this);
-    painter.setRenderHint(QPainter::Antialiasing);
-
-    int width = this->width();
-    int pivotX = width / 2;
-    int pivotY = height() / 8 - supportHeight;
-
-    // Если колебания отключены, рисуем статичное состояние
-    if (!oscillationsEnabled) {
-        double currentSpringLength = equilibriumLength;
-        int bobY = pivotY + currentSpringLength;
+    Scene scene = currentScene();
 
-        // Отрисовка опоры
-        painter.setPen(Qt::blue);
-        painter.drawLine(pivotX - 20, pivotY, pivotX + 20, pivotY);
-
-        // Отрисовка пружины
-        drawSpring(painter, pivotX, pivotY, bobY - bobRadius);
-
-        // Отрисовка груза
-        painter.setBrush(QBrush(Qt::white));
-        painter.drawEllipse(pivotX - bobRadius, bobY - bobRadius, bobRadius*2, bobRadius*2);
-        return;
+    // Изображение сцены прозрачно вне маятника, поэтому след рисуется под ним
+    if (motionTrailEnabled) {
+        motionTrail.draw(painter);
     }
 
-    // Обычная отрисовка для активных колебаний
-    double currentSpringLength;
-    if (isInitialState) {
-        currentSpringLength = compressedLength;
+    // Перетаскиваемый груз рисуется сразу: готовый кадр из потока
+    // отрисовки отставал бы от указателя еще на кадр
+    if (!backgroundRendering || bobDrag.isActive()) {
+        drawScene(painter, scene);
     } else {
-        currentSpringLength = equilibriumLength + position;
+        if (scene != submittedScene) {
+            submittedScene = scene;
+            sceneRenderer->submit(size(), devicePixelRatioF(),
+                                  [scene](QPainter &imagePainter) { drawScene(imagePainter, scene); });
+        }
 
-        if (pivotY + currentSpringLength < pivotY + bobRadius) {
-            currentSpringLength = pivotY + bobRadius - pivotY;
+        const QImage &frame = sceneRenderer->latestFrame();
+        if (frame.isNull()) {
+            // Первый кадр еще не готов
+            drawScene(painter, scene);
+        } else {
+            painter.drawImage(0, 0, frame);
         }
     }
 
-    int bobY = pivotY + currentSpringLength;
+    InputLatencyMonitor &latencyMonitor = InputLatencyMonitor::instance();
+    latencyMonitor.drawOverlay(painter, rect());
+    latencyMonitor.frameDrawn();
+}
+
+// Параметры сцены на текущий момент
+SpringPendulum::Scene SpringPendulum::currentScene() const
+{
+    Scene scene;
+    scene.width = width();
+    scene.height = height();
+    scene.oscillationsEnabled = oscillationsEnabled;
+    scene.isInitialState = isInitialState;
+    scene.equilibriumLength = equilibriumLength;
+    scene.position = position;
+    scene.compressedLength = compressedLength;
+    scene.bobRadius = bobRadius;
+    scene.supportHeight = supportHeight;
+    return scene;
+}
+
+// Рисование маятника; не обращается к членам виджета, поэтому может
+// выполняться в потоке отрисовки
+void SpringPendulum::drawScene(QPainter &painter, const Scene &scene)
+{
+    painter.setRenderHint(QPainter::Antialiasing);
+
+    const int bobRadius = scene.bobRadius;
+    int pivotX = scene.width / 2;
+    int pivotY = scene.height / 8 - scene.supportHeight;
+
+    int bobY = bobPosition(scene).y();
 
     // Отрисовка опоры
     painter.setPen(Qt::blue);
@@ -129,6 +217,128 @@ void SpringPendulum::paintEvent(QPaintEvent *event)
     painter.drawEllipse(pivotX - bobRadius, bobY - bobRadius, bobRadius*2, bobRadius*2);
 }
 
+// Положение центра груза на экране
+QPoint SpringPendulum::bobPosition(const Scene &scene)
+{
+    int pivotX = scene.width / 2;
+    int pivotY = scene.height / 8 - scene.supportHeight;
+
+    // Если колебания отключены, груз висит в положении равновесия
+    double currentSpringLength;
+    if (!scene.oscillationsEnabled) {
+        currentSpringLength = scene.equilibriumLength;
+    } else if (scene.isInitialState) {
+        currentSpringLength = scene.compressedLength;
+    } else {
+        currentSpringLength = scene.equilibriumLength + scene.position;
+
+        if (currentSpringLength < scene.bobRadius) {
+            currentSpringLength = scene.bobRadius;
+        }
+    }
+
+    return QPoint(pivotX, pivotY + currentSpringLength);
+}
+
+// Захват груза мышью или касанием (касание приходит как событие мыши).
+// Поток физики останавливается, груз следует за указателем по вертикали,
+// а кадры продолжают идти: след и энергии обновляются вживую. Если само
+// равновесие вне безопасного диапазона длины, груз не захватывается.
+void SpringPendulum::mousePressEvent(QMouseEvent *event)
+{
+    const Scene scene = currentScene();
+    const QPoint bob = bobPosition(scene);
+    QPointF offset = pointerPosition(event) - QPointF(bob);
+    if (event->button() != Qt::LeftButton || bobDrag.isActive() ||
+        hypot(offset.x(), offset.y()) > bobRadius + GRAB_MARGIN ||
+        equilibriumLength <= MIN_OSCILLATION_LENGTH || equilibriumLength >= MAX_OSCILLATION_LENGTH) {
+        QWidget::mousePressEvent(event);
+        return;
+    }
+
+    physicsWorker->stopSimulation();
+    isAnimating = false;
+    isPaused = false;
+    isSettled = false;
+
+    // Груз берется там, где он нарисован
+    const int pivotY = scene.height / 8 - scene.supportHeight;
+    position = qBound(MIN_OSCILLATION_LENGTH - equilibriumLength, bob.y() - pivotY - equilibriumLength,
+                      MAX_OSCILLATION_LENGTH - equilibriumLength);
+    velocity = 0.0;
+    isInitialState = false;
+    oscillationsEnabled = true;
+    dragPositionOffset = position - pointerPosition(event).y();
+    bobDrag.start(position, event->timestamp());
+    frameScheduler->start();
+    labelClock.restart();
+    event->accept();
+}
+
+// Груз переставляется сразу при обработке события, кадр покажет его без
+// ожидания потока физики. Длина пружины остается в безопасном диапазоне.
+void SpringPendulum::mouseMoveEvent(QMouseEvent *event)
+{
+    if (!bobDrag.isActive()) {
+        QWidget::mouseMoveEvent(event);
+        return;
+    }
+
+    position = qBound(MIN_OSCILLATION_LENGTH - equilibriumLength, pointerPosition(event).y() + dragPositionOffset,
+                      MAX_OSCILLATION_LENGTH - equilibriumLength);
+    bobDrag.addSample(position, event->timestamp());
+    velocity = bobDrag.velocity();
+    InputLatencyMonitor::instance().inputHandled();
+    update();
+}
+
+void SpringPendulum::mouseReleaseEvent(QMouseEvent *event)
+{
+    if (!bobDrag.isActive() || event->button() != Qt::LeftButton) {
+        QWidget::mouseReleaseEvent(event);
+        return;
+    }
+
+    bobDrag.addSample(position, event->timestamp());
+    velocity = bobDrag.velocity();
+    bobDrag.stop();
+    releaseBob();
+}
+
+// Запуск колебаний из точки отпускания со скоростью отпускания. Скорость
+// ограничена так, чтобы размах оставался в безопасном диапазоне длины
+// пружины, как и при запуске с введенным растяжением.
+void SpringPendulum::releaseBob()
+{
+    const double maxAmplitude = qMin(equilibriumLength - MIN_OSCILLATION_LENGTH,
+                                     MAX_OSCILLATION_LENGTH - equilibriumLength);
+    const double omega = sqrt(springConstant / mass);
+    const double maxVelocity = omega * sqrt(qMax(0.0, maxAmplitude * maxAmplitude - position * position));
+    velocity = qBound(-maxVelocity, velocity, maxVelocity);
+
+    // Растяжение — амплитуда колебаний с той же энергией
+    maxStretch = sqrt(position * position + velocity * velocity / (omega * omega));
+    ui->PositionInpEdit->setPlainText(QString::number(maxStretch, 'f', 2));
+
+    totalMechanicalEnergy = calculateKineticEnergy() + calculatePotentialEnergy();
+    initialMechanicalEnergy = totalMechanicalEnergy;
+    dissipatedEnergy = 0.0;
+    ui->OutputPeriodValue->setText(QString::number(calculatePeriod(), 'f', 5));
+    updateOutputValues();
+
+    // Отпущенный в равновесии груз просто висит
+    if (maxStretch < MIN_STRETCH) {
+        frameScheduler->stop();
+        update();
+        return;
+    }
+
+    setInputsEnabled(false);
+    physicsWorker->startSimulation(createPhysicsModel(), simulationStep());
+    isAnimating = true;
+    frameScheduler->start();
+}
+
 // Проверка допустимого диапазона колебаний
 bool SpringPendulum::checkOscillationRange()
 {
@@ -168,20 +378,31 @@ void SpringPendulum::drawSpring(QPainter &painter, int x1, int y1, int y2)
     painter.drawPath(path);
 }
 
-// Включение/отключение элементов ввода
+// Включение/отключение элементов ввода. Параметры, которые меняются на
+// ходу, остаются доступны в пределах LIVE_EDIT_RANGE от текущих значений.
 void SpringPendulum::setInputsEnabled(bool enabled)
 {
-    ui->MassInpEdit->setEnabled(enabled);
-    ui->PositionInpEdit->setEnabled(enabled);
-    ui->ElasticityInpEdit->setEnabled(enabled);
-    ui->ButtonOKMass->setEnabled(enabled);
-    ui->ButtonResetMass->setEnabled(enabled);
-    ui->ButtonOKPosition->setEnabled(enabled);
-    ui->ButtonResetPosition->setEnabled(enabled);
-    ui->ButtonOKElasticity->setEnabled(enabled);
-    ui->ButtonResetElasticity->setEnabled(enabled);
+    const bool massEnabled = enabled || parameters.isLiveEditable(Parameter::Mass);
+    const bool positionEnabled = enabled || parameters.isLiveEditable(Parameter::Position);
+    const bool elasticityEnabled = enabled || parameters.isLiveEditable(Parameter::Elasticity);
+    parameters.setRange(Parameter::Mass, enabled ? MIN_MASS : qMax(MIN_MASS, mass / LIVE_EDIT_RANGE),
+                        enabled ? MAX_MASS : qMin(MAX_MASS, mass * LIVE_EDIT_RANGE));
+    parameters.setRange(Parameter::Elasticity,
+                        enabled ? MIN_SPRING_CONST : qMax(MIN_SPRING_CONST, springConstant / LIVE_EDIT_RANGE),
+                        enabled ? MAX_SPRING_CONST : qMin(MAX_SPRING_CONST, springConstant * LIVE_EDIT_RANGE));
+
+    ui->MassInpEdit->setEnabled(massEnabled);
+    ui->PositionInpEdit->setEnabled(positionEnabled);
+    ui->ElasticityInpEdit->setEnabled(elasticityEnabled);
+    ui->ButtonOKMass->setEnabled(massEnabled);
+    ui->ButtonResetMass->setEnabled(massEnabled);
+    ui->ButtonOKPosition->setEnabled(positionEnabled);
+    ui->ButtonResetPosition->setEnabled(positionEnabled);
+    ui->ButtonOKElasticity->setEnabled(elasticityEnabled);
+    ui->ButtonResetElasticity->setEnabled(elasticityEnabled);
     ui->ButtonOKAirFriction->setEnabled(enabled);
     ui->ButtonOffAirFriction->setEnabled(enabled);
+    dampingMenu->setEnabled(enabled);
 }
 
 // Расчет положения равновесия
@@ -190,6 +411,40 @@ void SpringPendulum::calculateEquilibrium()
     equilibriumLength = compressedLength + (mass * gravity) / springConstant;
 }
 
+// Ядро уравнений движения с текущими параметрами маятника
+template <typename Damping>
+SpringPendulumKernel<DoublePrecision, Damping> SpringPendulum::physicsKernel(const Damping &damping) const
+{
+    SpringPendulumKernel<DoublePrecision, Damping> kernel;
+    kernel.mass = mass;
+    kernel.springConstant = springConstant;
+    kernel.damping = damping;
+    // Груз не поднимается выше точки подвеса
+    kernel.minPosition = bobRadius - equilibriumLength;
+    return kernel;
+}
+
+// Шаг интегрирования: короткий период требует более мелкого шага
+double SpringPendulum::simulationStep() const
+{
+    return qMin(SIMULATION_STEP, calculatePeriod() / STEPS_PER_PERIOD);
+}
+
+// Модель для потока физики с текущими параметрами и состоянием груза.
+// Модель сопротивления выбирается здесь, один раз на запуск.
+std::unique_ptr<PhysicsModel> SpringPendulum::createPhysicsModel() const
+{
+    SpringPendulumState<DoublePrecision> state;
+    state.position = position;
+    state.velocity = velocity;
+
+    std::unique_ptr<PhysicsModel> model;
+    withDampingModel<double>(dampingSettings, [&](const auto &damping) {
+        model = makeKernelModel(physicsKernel(damping), state);
+    });
+    return model;
+}
+
 // Расчет периода колебаний
 double SpringPendulum::calculatePeriod() const
 {
@@ -242,10 +497,24 @@ void SpringPendulum::updateOutputValues()
     ui->OutputAmplitudeVlaue->setText(QString::number(calculateAmplitude(), 'f', 5));
 }
 
+// Измеренные по живому сигналу период, гармоники и затухание
+void SpringPendulum::updateSpectrumValues(const SpectralEstimate &spectrum)
+{
+    if (spectrum.periodValid) {
+        ui->OutputMeasuredPeriodValue->setText(QString::number(spectrum.period, 'f', 5));
+    }
+    if (spectrum.harmonicsValid) {
+        ui->OutputHarmonicsValue->setText(QString::number(spectrum.harmonicDistortion, 'e', 3));
+    }
+    if (spectrum.dampingValid) {
+        ui->OutputDampingRateValue->setText(QString::number(spectrum.dampingRate, 'e', 3));
+    }
+}
+
 // Запуск анимации
 void SpringPendulum::startAnimation()
 {
-    if (timer->isActive() && !isPaused) {
+    if ((frameScheduler->isActive() || isSettled) && !isPaused) {
         return;
     }
 
@@ -255,13 +524,16 @@ void SpringPendulum::startAnimation()
     }
 
     if (isPaused) {
-        timer->start(16);
+        physicsWorker->resumeSimulation();
+        frameScheduler->start();
         isAnimating = true;
         isPaused = false;
         return;
     }
 
     totalMechanicalEnergy = calculatePotentialEnergy();
+    initialMechanicalEnergy = totalMechanicalEnergy;
+    dissipatedEnergy = 0.0;
 
     ui->OutputPeriodValue->setText(QString::number(calculatePeriod(), 'f', 5));
     ui->OutputMechEnVlaue->setText(QString::number(totalMechanicalEnergy, 'f', 5));
@@ -280,7 +552,7 @@ void SpringPendulum::startAnimation()
                                  QString("Pendulum parameters are outside the safe oscillation range.\n"
                                          "Oscillations are disabled.\n\n"));
 
-        timer->stop();
+        frameScheduler->stop();
         isAnimating = false;
 
         ui->OutputPeriodValue->setText(QString::number(calculatePeriod(), 'f', 6));
@@ -297,37 +569,88 @@ void SpringPendulum::startAnimation()
 
     oscillationsEnabled = true;
     setInputsEnabled(false);
-    timer->start(16);
+    physicsWorker->startSimulation(createPhysicsModel(), simulationStep());
+    frameScheduler->start();
     isAnimating = true;
     isInitialState = false;
 }
 
-// Обновление анимации
-void SpringPendulum::updateAnimation()
+// Обновление анимации (вызывается на каждом кадре)
+void SpringPendulum::updateAnimation(double elapsedSeconds)
 {
+    // Во время перетаскивания состояние задает указатель, физика стоит
+    if (bobDrag.isActive()) {
+        totalMechanicalEnergy = calculateKineticEnergy() + calculatePotentialEnergy();
+        if (motionTrailEnabled) {
+            motionTrail.addPoint(bobPosition(currentScene()), elapsedSeconds, size(), devicePixelRatioF());
+            update();
+        }
+        if (labelClock.hasExpired(LABEL_UPDATE_INTERVAL_MS)) {
+            updateOutputValues();
+            labelClock.restart();
+        }
+        return;
+    }
+
     if(!isAnimating || isInitialState || !oscillationsEnabled) {
+        // Статичное состояние: кадры не нужны
+        frameScheduler->stop();
         updateOutputValues();
         return;
     }
 
-    double force = -springConstant * position;
-    if(airFrictionEnabled) {
-        force -= airFrictionCoeff * velocity;
+    // Физика считается в потоке PhysicsWorker; берем последний снимок и
+    // интерполируем состояние на текущий момент модельного времени
+    const PhysicsSnapshot &snapshot = physicsWorker->latestSnapshot();
+    const double displayTime = physicsWorker->simulatedTimeNow();
+    position = interpolateState(snapshot, 0, displayTime);
+    velocity = interpolateState(snapshot, 1, displayTime);
+    dissipatedEnergy = snapshot.dissipatedEnergy;
+    // После правки энергия отсчитывается от точного состояния шага, с
+    // которого модель продолжила движение с новыми параметрами
+    if (energyRevision > 0 && snapshot.parameterRevision >= energyRevision) {
+        initialMechanicalEnergy = 0.5 * mass * snapshot.state[1] * snapshot.state[1] +
+                                  0.5 * springConstant * snapshot.state[0] * snapshot.state[0] + dissipatedEnergy;
+        energyRevision = 0;
     }
+    totalMechanicalEnergy = initialMechanicalEnergy - dissipatedEnergy;
 
-    double acceleration = force / mass;
-    velocity += acceleration * 0.016;
-    position += velocity * 0.016;
-
-    int pivotY = height() / 8 - supportHeight;
-    double currentLength = equilibriumLength + position;
-    if (pivotY + currentLength < pivotY + bobRadius) {
-        position = (pivotY + bobRadius - pivotY) - equilibriumLength;
-        velocity = 0;
+    if (motionTrailEnabled) {
+        motionTrail.addPoint(bobPosition(currentScene()), elapsedSeconds, size(), devicePixelRatioF());
     }
 
-    updateOutputValues();
+    // При ускоренном времени подписи обновляются не на каждом кадре
+    bool atRest = isAtRest(snapshot.stuckByFriction);
+    if (atRest || controlBar->timeScale() <= 1.0 || labelClock.hasExpired(LABEL_UPDATE_INTERVAL_MS)) {
+        updateOutputValues();
+        updateSpectrumValues(snapshot.spectrum);
+        controlBar->setTimeline(qMin(displayTime, snapshot.simulatedTime), physicsWorker->recordedTime());
+        labelClock.restart();
+    }
     update();
+
+    // Затухшие или залипшие колебания больше не требуют кадров. Поток
+    // физики только приостанавливается, чтобы прогон можно было перемотать.
+    if (atRest) {
+        physicsWorker->pauseSimulation();
+        frameScheduler->stop();
+        isAnimating = false;
+        isSettled = true;
+    }
+}
+
+// Проверка, что сопротивление погасило колебания или сухое трение
+// удерживает груз в покое
+bool SpringPendulum::isAtRest(bool stuckByFriction) const
+{
+    if (!dampingSettings.anyEnabled()) {
+        return false;
+    }
+    if (stuckByFriction) {
+        return true;
+    }
+    double energy = calculateKineticEnergy() + calculatePotentialEnergy();
+    return energy <= REST_ENERGY_FRACTION * initialMechanicalEnergy;
 }
 
 // Слоты меню
@@ -341,13 +664,15 @@ void SpringPendulum::on_actionStart_triggered()
 // Обработчик кнопки Pause
 void SpringPendulum::on_actionPause_triggered()
 {
-    if(timer->isActive()) {
-        timer->stop();
+    if(frameScheduler->isActive()) {
+        physicsWorker->pauseSimulation();
+        frameScheduler->stop();
         isAnimating = false;
         isPaused = true;
     }
     else if (isPaused) {
-        timer->start(16);
+        physicsWorker->resumeSimulation();
+        frameScheduler->start();
         isAnimating = true;
         isPaused = false;
     }
@@ -356,19 +681,26 @@ void SpringPendulum::on_actionPause_triggered()
 // Обработчик кнопки Reset
 void SpringPendulum::on_actionReset_triggered()
 {
-    timer->stop();
+    bobDrag.stop();
+    physicsWorker->stopSimulation();
+    frameScheduler->stop();
     isAnimating = false;
     isPaused = false;
+    isSettled = false;
     isInitialState = true;
     oscillationsEnabled = true;
 
-    mass = DEFAULT_MASS;
-    springConstant = DEFAULT_ELASTICITY;
-    maxStretch = DEFAULT_POSITION;
-    position = DEFAULT_POSITION;
+    parameters.reset(Parameter::Mass);
+    parameters.reset(Parameter::Elasticity);
+    parameters.reset(Parameter::Position);
+    position = maxStretch;
     velocity = 0.0;
-    airFrictionEnabled = false;
+    dampingSettings = defaultDampingSettings();
+    quadraticDragAction->setChecked(false);
+    dryFrictionAction->setChecked(false);
     totalMechanicalEnergy = 0.0;
+    initialMechanicalEnergy = 0.0;
+    dissipatedEnergy = 0.0;
     maxPotentialEnergy = 0.0;
     maxKineticEnergy = 0.0;
 
@@ -383,20 +715,74 @@ void SpringPendulum::on_actionReset_triggered()
     ui->OutputKinEnValue->clear();
     ui->OutputVelosityValue->clear();
     ui->OutputDisplacementValue->clear();
+    ui->OutputMeasuredPeriodValue->clear();
+    ui->OutputHarmonicsValue->clear();
+    ui->OutputDampingRateValue->clear();
 
     ui->ButtonOKAirFriction->setStyleSheet("");
     ui->ButtonOffAirFriction->setStyleSheet("background-color: red");
 
+    motionTrail.clear();
+    controlBar->setTimeScale(1.0);
+    controlBar->setTimeline(0.0, 0.0);
     setInputsEnabled(true);
     calculateEquilibrium();
     update();
 }
 
+// Обработчик переключения фоновой отрисовки
+void SpringPendulum::on_actionBackgroundRendering_toggled(bool checked)
+{
+    backgroundRendering = checked;
+    submittedScene = Scene();
+    if (!checked) {
+        sceneRenderer->stopRendering();
+    }
+    update();
+}
+
+// Обработчик переключения следа груза
+void SpringPendulum::on_actionMotionTrail_toggled(bool checked)
+{
+    motionTrailEnabled = checked;
+    motionTrail.clear();
+    update();
+}
+
+// Обработчик изменения скорости модельного времени
+void SpringPendulum::on_controlBar_timeScaleChanged(double scale)
+{
+    physicsWorker->setTimeScale(scale);
+}
+
+// Перемотка по шкале времени
+void SpringPendulum::on_controlBar_seekRequested(double time)
+{
+    physicsWorker->seek(time);
+}
+
+// Результат перемотки. Во время анимации его покажет очередной кадр;
+// остановленный маятник после перемотки стоит на паузе
+void SpringPendulum::on_physicsWorker_seekFinished()
+{
+    if (frameScheduler->isActive()) {
+        return;
+    }
+    if (isSettled) {
+        isSettled = false;
+        isPaused = true;
+    }
+    motionTrail.clear();
+    updateAnimation(0.0);
+}
+
 // Обработчик кнопки Exit
 void SpringPendulum::on_actionExit_triggered()
 {
-    if (timer->isActive()) {
-        timer->stop();
+    physicsWorker->stopSimulation();
+    sceneRenderer->stopRendering();
+    if (frameScheduler->isActive()) {
+        frameScheduler->stop();
     }
 
     MainWindow *mainWindow = new MainWindow();
@@ -405,107 +791,102 @@ void SpringPendulum::on_actionExit_triggered()
     this->close();
 }
 
-// Обработчик кнопки OK для массы
-void SpringPendulum::on_ButtonOKMass_clicked()
+// Описание вводимых параметров; значения по умолчанию записываются в поля
+void SpringPendulum::defineParameters()
 {
-    QString data = ui->MassInpEdit->toPlainText();
-    bool ok;
-    double newMass = data.toDouble(&ok);
+    parameters.define(Parameter::Mass, {"Mass", "kg", MIN_MASS, MAX_MASS, DEFAULT_MASS, true}, mass);
+    parameters.define(Parameter::Position, {"Stretch", "m", MIN_STRETCH, MAX_STRETCH, DEFAULT_POSITION, false},
+                      maxStretch);
+    parameters.define(Parameter::Elasticity,
+                      {"Spring constant", "N/m", MIN_SPRING_CONST, MAX_SPRING_CONST, DEFAULT_ELASTICITY, true},
+                      springConstant);
+}
 
-    if(!ok || data.isEmpty()) {
-        newMass = DEFAULT_MASS;
+// Единый путь ввода: проверка реестром, затем применение
+void SpringPendulum::editParameter(Parameter parameter, const QString &text)
+{
+    QString error;
+    if (!parameters.set(parameter, text, error)) {
+        QMessageBox::warning(this, "Warning", error);
+        return;
     }
-    else if(newMass <= MIN_MASS || newMass > MAX_MASS) {
-        QMessageBox::warning(this, "Warning",
-                             QString("Mass should be in range [%1, %2] kg!").arg(MIN_MASS).arg(MAX_MASS));
+    applyParameterChange(parameter);
+}
+
+// Применение нового значения. Растяжение задает начальное положение груза;
+// масса и жесткость сдвигают равновесие. Во время движения правка вместе
+// с новым упором уходит в поток физики и вступает в силу на ближайшей
+// границе шага; смещение от равновесия и скорость при этом сохраняются, а
+// энергия отсчитывается заново от состояния после правки.
+void SpringPendulum::applyParameterChange(Parameter parameter)
+{
+    if (parameter == Parameter::Position) {
+        isInitialState = qFuzzyIsNull(maxStretch);
+        position = maxStretch;
+        update();
         return;
     }
 
-    mass = newMass;
     calculateEquilibrium();
+    if (physicsWorker->isRunning()) {
+        PhysicsParameter physicsParameter = parameter == Parameter::Mass ? PhysicsParameter::Mass
+                                                                         : PhysicsParameter::SpringConstant;
+        energyRevision = physicsWorker->queueParameterEdits({{physicsParameter, parameters.value(parameter)},
+                                                             {PhysicsParameter::MinPosition, bobRadius - equilibriumLength}});
+        initialMechanicalEnergy = calculateKineticEnergy() + calculatePotentialEnergy() + dissipatedEnergy;
+        totalMechanicalEnergy = initialMechanicalEnergy - dissipatedEnergy;
+        ui->OutputPeriodValue->setText(QString::number(calculatePeriod(), 'f', 5));
+        updateOutputValues();
+    }
     update();
 }
 
+// Обработчик кнопки OK для массы
+void SpringPendulum::on_ButtonOKMass_clicked()
+{
+    editParameter(Parameter::Mass, ui->MassInpEdit->toPlainText());
+}
+
 // Обработчик кнопки Reset для массы
 void SpringPendulum::on_ButtonResetMass_clicked()
 {
-    mass = DEFAULT_MASS;
+    parameters.reset(Parameter::Mass);
     ui->MassInpEdit->clear();
-    calculateEquilibrium();
-    checkOscillationRange();
-    update();
+    applyParameterChange(Parameter::Mass);
 }
 
 // Обработчик кнопки OK для позиции
 void SpringPendulum::on_ButtonOKPosition_clicked()
 {
-    QString data = ui->PositionInpEdit->toPlainText();
-    bool ok;
-    double newPos = data.toDouble(&ok);
-
-    if(!ok || data.isEmpty()) {
-        newPos = DEFAULT_POSITION;
-    }
-    else {
-        if (newPos < MIN_STRETCH || newPos > MAX_STRETCH) {
-            QMessageBox::warning(this, "Warning",
-                                 QString("Stretch should be in range [%1, %2] m!").arg(MIN_STRETCH).arg(MAX_STRETCH));
-            return;
-        }
-    }
-
-    maxStretch = newPos;
-    isInitialState = false;
-    position = maxStretch;
-    update();
+    editParameter(Parameter::Position, ui->PositionInpEdit->toPlainText());
 }
 
 // Обработчик кнопки Reset для позиции
 void SpringPendulum::on_ButtonResetPosition_clicked()
 {
-    maxStretch = DEFAULT_POSITION;
-    isInitialState = true;
-    position = DEFAULT_POSITION;
+    parameters.reset(Parameter::Position);
     ui->PositionInpEdit->clear();
-    checkOscillationRange();
-    update();
+    applyParameterChange(Parameter::Position);
 }
 
 // Обработчик кнопки OK для упругости
 void SpringPendulum::on_ButtonOKElasticity_clicked()
 {
-    QString data = ui->ElasticityInpEdit->toPlainText();
-    bool ok;
-    double newK = data.toDouble(&ok);
-
-    if(!ok || data.isEmpty()) {
-        newK = DEFAULT_ELASTICITY;
-    }
-    else if(newK < MIN_SPRING_CONST || newK > MAX_SPRING_CONST) {
-        QMessageBox::warning(this, "Warning",
-                             QString("Spring constant should be in range [%1, %2] N/m!").arg(MIN_SPRING_CONST).arg(MAX_SPRING_CONST));
-        return;
-    }
-
-    springConstant = newK;
-    calculateEquilibrium();
-    update();
+    editParameter(Parameter::Elasticity, ui->ElasticityInpEdit->toPlainText());
 }
 
 // Обработчик кнопки Reset для упругости
 void SpringPendulum::on_ButtonResetElasticity_clicked()
 {
-    springConstant = DEFAULT_ELASTICITY;
+    parameters.reset(Parameter::Elasticity);
     ui->ElasticityInpEdit->clear();
-    calculateEquilibrium();
-    checkOscillationRange();
-    update();
+    applyParameterChange(Parameter::Elasticity);
 }
 
 // Обработчик кнопки включения сопротивления воздуха
 void SpringPendulum::on_ButtonOKAirFriction_clicked()
 {
-    airFrictionEnabled = true;
+    dampingSettings.linearEnabled = true;
     ui->ButtonOKAirFriction->setStyleSheet("background-color: green");
     ui->ButtonOffAirFriction->setStyleSheet("");
 }
@@ -513,7 +894,38 @@ void SpringPendulum::on_ButtonOKAirFriction_clicked()
 // Обработчик кнопки выключения сопротивления воздуха
 void SpringPendulum::on_ButtonOffAirFriction_clicked()
 {
-    airFrictionEnabled = false;
+    dampingSettings.linearEnabled = false;
     ui->ButtonOKAirFriction->setStyleSheet("");
     ui->ButtonOffAirFriction->setStyleSheet("background-color: red");
 }
+
+// Обработчик включения квадратичного сопротивления
+void SpringPendulum::on_actionQuadraticDrag_toggled(bool checked)
+{
+    dampingSettings.quadraticEnabled = checked;
+}
+
+// Обработчик включения сухого трения
+void SpringPendulum::on_actionDryFriction_toggled(bool checked)
+{
+    dampingSettings.dryEnabled = checked;
+}
+
+// Обработчик ввода коэффициентов сопротивления
+void SpringPendulum::on_actionDampingCoefficients_triggered()
+{
+    bool ok;
+    double linear = QInputDialog::getDouble(this, "Damping", "Linear drag coefficient [N*s/m]:",
+                                            dampingSettings.linearCoeff, 0.0, 1000.0, 6, &ok);
+    if (!ok) return;
+    double quadratic = QInputDialog::getDouble(this, "Damping", "Quadratic drag coefficient [N*s^2/m^2]:",
+                                               dampingSettings.quadraticCoeff, 0.0, 1000.0, 6, &ok);
+    if (!ok) return;
+    double dry = QInputDialog::getDouble(this, "Damping", "Dry friction force [N]:",
+                                         dampingSettings.dryLevel, 0.0, 1000.0, 6, &ok);
+    if (!ok) return;
+
+    dampingSettings.linearCoeff = linear;
+    dampingSettings.quadraticCoeff = quadratic;
+    dampingSettings.dryLevel = dry;
+}
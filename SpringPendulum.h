@@ -3,9 +3,22 @@
 
 #include <QWidget>
 #include <QMenuBar>
-#include <QTimer>
+#include <QElapsedTimer>
+#include <QMenu>
+#include <QAction>
 #include <QMessageBox>
 #include <cmath>
+#include <memory>
+#include "PendulumPhysics.h"
+#include "PhysicsModel.h"
+#include "MotionTrail.h"
+#include "ParameterRegistry.h"
+#include "BobDrag.h"
+
+class FrameScheduler;
+class PhysicsWorker;
+class SceneRenderer;
+class SimulationControlBar;
 
 namespace Ui {
 class SpringPendulum;
@@ -19,13 +32,64 @@ public:
     explicit SpringPendulum(QWidget *parent = nullptr);
     ~SpringPendulum();
 
+    // Пружина вдоль оси y от y1 до y2 на x1. Для наклонной пружины
+    // (ElasticPendulum) painter заранее поворачивается вдоль стержня.
+    static void drawSpring(QPainter &painter, int x1, int y1, int y2);
+
 protected:
     void paintEvent(QPaintEvent *event) override;
+    void mousePressEvent(QMouseEvent *event) override;
+    void mouseMoveEvent(QMouseEvent *event) override;
+    void mouseReleaseEvent(QMouseEvent *event) override;
 
 private:
     Ui::SpringPendulum *ui;
     QMenuBar *menuBar;
-    QTimer *timer;
+    QMenu *dampingMenu;
+    QAction *quadraticDragAction;
+    QAction *dryFrictionAction;
+    FrameScheduler *frameScheduler;
+    PhysicsWorker *physicsWorker;
+    SceneRenderer *sceneRenderer;
+    SimulationControlBar *controlBar;
+    QElapsedTimer labelClock;
+
+    // Параметры сцены, скопированные для отрисовки в потоке SceneRenderer
+    struct Scene {
+        int width = 0;
+        int height = 0;
+        bool oscillationsEnabled = true;
+        bool isInitialState = true;
+        double equilibriumLength = 0.0;
+        double position = 0.0;
+        double compressedLength = 0.0;
+        int bobRadius = 0;
+        int supportHeight = 0;
+
+        bool operator==(const Scene &other) const {
+            return width == other.width && height == other.height &&
+                   oscillationsEnabled == other.oscillationsEnabled &&
+                   isInitialState == other.isInitialState &&
+                   equilibriumLength == other.equilibriumLength && position == other.position &&
+                   compressedLength == other.compressedLength && bobRadius == other.bobRadius &&
+                   supportHeight == other.supportHeight;
+        }
+        bool operator!=(const Scene &other) const { return !(*this == other); }
+    };
+    Scene submittedScene;
+    bool backgroundRendering = false;
+    MotionTrail motionTrail;
+    bool motionTrailEnabled = false;
+
+    // Перетаскивание груза по вертикали: груз ниже указателя на
+    // dragPositionOffset, чтобы не прыгать к точке захвата
+    BobDrag bobDrag;
+    double dragPositionOffset = 0.0;
+
+    // Вводимые параметры: масса и жесткость меняются и во время движения,
+    // растяжение задает начальное состояние
+    enum class Parameter { Mass, Position, Elasticity };
+    ParameterRegistry<Parameter> parameters;
 
     // Параметры маятника
     double mass = 1.0;
@@ -35,21 +99,36 @@ private:
     double velocity = 0.0;
     double equilibriumLength = 200.0;
     bool isAnimating = false;
-    bool airFrictionEnabled = false;
+    DampingSettings dampingSettings;
     bool isInitialState = true;
     bool oscillationsEnabled = true;
+    bool isSettled = false;
 
     // Значения энергии маятника
     double totalMechanicalEnergy = 0.0;
+    double initialMechanicalEnergy = 0.0;
+    double dissipatedEnergy = 0.0;
+    // Пакет правок, после которого энергия отсчитывается заново по снимку
+    long long energyRevision = 0;
     double maxPotentialEnergy = 0.0;
     double maxKineticEnergy = 0.0;
 
     // Физические константы
     const double gravity = 9.81;
     const int bobRadius = 20;
-    const double airFrictionCoeff = 0.1;
+    // Груз захватывается и рядом с кругом: палец на сенсорном экране
+    // закрывает больше, чем сам груз
+    const int GRAB_MARGIN = 20;
+    const double DEFAULT_LINEAR_DRAG = 0.1;       // Н·с/м
+    const double DEFAULT_QUADRATIC_DRAG = 0.05;   // Н·с²/м²
+    const double DEFAULT_DRY_FRICTION = 0.05;     // Н
     const int supportHeight = 40;
     const double compressedLength = 100.0;
+    const double REST_ENERGY_FRACTION = 1e-6;
+    // Шаг интегрирования не крупнее периода / STEPS_PER_PERIOD
+    const double STEPS_PER_PERIOD = 400.0;
+    // Интервал обновления подписей при ускоренном времени
+    const int LABEL_UPDATE_INTERVAL_MS = 100;
 
     // Значения для корректной визуализации движения
     const double MIN_MASS = pow(10,-6);
@@ -60,6 +139,10 @@ private:
     const double MAX_STRETCH = pow(10,6);
     const double MIN_OSCILLATION_LENGTH = 50.0;
     const double MAX_OSCILLATION_LENGTH = 500.0;
+    // Во время движения масса и жесткость меняются не больше чем в
+    // LIVE_EDIT_RANGE раз от значений при запуске: период остается
+    // не короче нескольких десятков шагов интегрирования
+    const double LIVE_EDIT_RANGE = 10.0;
 
     // Начальные значения системы
     const double DEFAULT_MASS = 1.0;
@@ -68,15 +151,29 @@ private:
 
     // Вспомогательные методы
     void setupMenu();
-    void drawSpring(QPainter &painter, int x1, int y1, int y2);
+    void setupDampingMenu();
+    Scene currentScene() const;
+    static void drawScene(QPainter &painter, const Scene &scene);
+    static QPoint bobPosition(const Scene &scene);
     void setInputsEnabled(bool enabled);
+    void defineParameters();
+    void editParameter(Parameter parameter, const QString &text);
+    void applyParameterChange(Parameter parameter);
     void calculateEquilibrium();
     void updateOutputValues();
+    void updateSpectrumValues(const SpectralEstimate &spectrum);
     void startAnimation();
     bool checkOscillationRange();
+    void releaseBob();
+    bool isAtRest(bool stuckByFriction) const;
     bool isPaused = false;
 
     // Методы расчетов
+    template <typename Damping>
+    SpringPendulumKernel<DoublePrecision, Damping> physicsKernel(const Damping &damping) const;
+    DampingSettings defaultDampingSettings() const;
+    std::unique_ptr<PhysicsModel> createPhysicsModel() const;
+    double simulationStep() const;
     double calculatePeriod() const;
     double calculateKineticEnergy() const;
     double calculatePotentialEnergy() const;
@@ -90,6 +187,14 @@ private slots:
     void on_actionPause_triggered();
     void on_actionReset_triggered();
     void on_actionExit_triggered();
+    void on_actionBackgroundRendering_toggled(bool checked);
+    void on_actionMotionTrail_toggled(bool checked);
+    void on_controlBar_timeScaleChanged(double scale);
+    void on_controlBar_seekRequested(double time);
+    void on_physicsWorker_seekFinished();
+    void on_actionQuadraticDrag_toggled(bool checked);
+    void on_actionDryFriction_toggled(bool checked);
+    void on_actionDampingCoefficients_triggered();
 
     // Слоты для кнопок
     void on_ButtonOKMass_clicked();
@@ -102,7 +207,7 @@ private slots:
     void on_ButtonOffAirFriction_clicked();
 
     // Анимация
-    void updateAnimation();
+    void updateAnimation(double elapsedSeconds);
 };
 
 #endif
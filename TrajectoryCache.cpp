@@ -0,0 +1,367 @@
+#include "TrajectoryCache.h"
+#include "ResultCache.h"
+#include <cmath>
+#include <cstring>
+
+namespace {
+
+// Правая часть безразмерного уравнения
+inline double normalizedAcceleration(double angle, double velocity, double damping)
+{
+    return -std::sin(angle) - damping * velocity;
+}
+
+inline double normalizedEnergy(double angle, double velocity)
+{
+    return 0.5 * velocity * velocity + 1.0 - std::cos(angle);
+}
+
+}
+
+// Кубическая эрмитова интерполяция по значениям и производным в узлах
+void NormalizedTrajectory::sample(double tau, double &angle, double &velocity) const
+{
+    if (periodic) {
+        tau = std::fmod(tau, period);
+    }
+    double position = tau / step;
+    std::size_t index = static_cast<std::size_t>(position);
+    if (index + 1 >= angles.size()) {
+        angle = angles.back();
+        velocity = velocities.back();
+        return;
+    }
+
+    double u = position - index;
+    double a0 = angles[index], a1 = angles[index + 1];
+    double v0 = velocities[index], v1 = velocities[index + 1];
+    double accel0 = normalizedAcceleration(a0, v0, damping);
+    double accel1 = normalizedAcceleration(a1, v1, damping);
+
+    double u2 = u * u, u3 = u2 * u;
+    angle = (2 * u3 - 3 * u2 + 1) * a0 + (u3 - 2 * u2 + u) * step * v0 +
+            (-2 * u3 + 3 * u2) * a1 + (u3 - u2) * step * v1;
+    velocity = (2 * u3 - 3 * u2 + 1) * v0 + (u3 - 2 * u2 + u) * step * accel0 +
+               (-2 * u3 + 3 * u2) * v1 + (u3 - u2) * step * accel1;
+}
+
+TrajectoryCache &TrajectoryCache::instance()
+{
+    static TrajectoryCache cache;
+    return cache;
+}
+
+// Поиск траектории; при промахе она берется с диска или считается и вытесняет самую старую
+std::shared_ptr<const NormalizedTrajectory> TrajectoryCache::trajectory(double initialAngle, double normalizedDamping)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    for (auto it = entries.begin(); it != entries.end(); ++it) {
+        if ((*it)->initialAngle == initialAngle && (*it)->damping == normalizedDamping) {
+            entries.splice(entries.begin(), entries, it);
+            return entries.front();
+        }
+    }
+
+    const QByteArray key = diskKey(initialAngle, normalizedDamping);
+    std::shared_ptr<const NormalizedTrajectory> loaded = load(key);
+    if (loaded) {
+        entries.push_front(loaded);
+    } else {
+        entries.push_front(compute(initialAngle, normalizedDamping));
+        save(key, *entries.front());
+    }
+    if (entries.size() > MAX_ENTRIES) {
+        entries.pop_back();
+    }
+    return entries.front();
+}
+
+// Расчет траектории методом Рунге–Кутты 4-го порядка из состояния покоя
+std::shared_ptr<const NormalizedTrajectory> TrajectoryCache::compute(double initialAngle, double normalizedDamping)
+{
+    auto result = std::make_shared<NormalizedTrajectory>();
+    result->initialAngle = initialAngle;
+    result->damping = normalizedDamping;
+    result->step = TABLE_STEP;
+    result->periodic = normalizedDamping == 0.0;
+
+    const double h = TABLE_STEP;
+    const double c = normalizedDamping;
+    const double restEnergy = REST_ENERGY_FRACTION * normalizedEnergy(initialAngle, 0.0);
+    const std::size_t maxSamples = static_cast<std::size_t>(MAX_DURATION / h) + 1;
+
+    double angle = initialAngle;
+    double velocity = 0.0;
+    result->angles.push_back(angle);
+    result->velocities.push_back(velocity);
+    if (initialAngle == 0.0) {
+        // Маятник в положении равновесия
+        result->periodic = false;
+        result->settled = true;
+        return result;
+    }
+    // Знак скорости при возврате в начальный угол
+    const double direction = initialAngle > 0.0 ? 1.0 : -1.0;
+
+    while (result->angles.size() < maxSamples) {
+        double k1a = velocity;
+        double k1v = normalizedAcceleration(angle, velocity, c);
+        double k2a = velocity + 0.5 * h * k1v;
+        double k2v = normalizedAcceleration(angle + 0.5 * h * k1a, k2a, c);
+        double k3a = velocity + 0.5 * h * k2v;
+        double k3v = normalizedAcceleration(angle + 0.5 * h * k2a, k3a, c);
+        double k4a = velocity + h * k3v;
+        double k4v = normalizedAcceleration(angle + h * k3a, k4a, c);
+
+        double previousVelocity = velocity;
+        angle += h / 6.0 * (k1a + 2 * k2a + 2 * k3a + k4a);
+        velocity += h / 6.0 * (k1v + 2 * k2v + 2 * k3v + k4v);
+        result->angles.push_back(angle);
+        result->velocities.push_back(velocity);
+
+        if (result->periodic) {
+            // Период — момент, когда скорость снова обращается в ноль
+            // в начальном угле
+            if (direction * previousVelocity > 0.0 && direction * velocity <= 0.0) {
+                double fraction = previousVelocity / (previousVelocity - velocity);
+                result->period = (result->angles.size() - 2 + fraction) * h;
+                break;
+            }
+        } else if (normalizedEnergy(angle, velocity) < restEnergy) {
+            result->settled = true;
+            break;
+        }
+    }
+
+    if (result->periodic && result->period == 0.0) {
+        // Период длиннее таблицы (угол около 180°) — без повторения
+        result->periodic = false;
+    }
+    return result;
+}
+
+// Заголовок сохраненной траектории, за ним углы и скорости подряд
+struct StoredTrajectoryHeader {
+    double initialAngle;
+    double damping;
+    double step;
+    double period;
+    qint64 periodic;
+    qint64 settled;
+    qint64 count;
+};
+
+// Ключ на диске: вход расчета, параметры таблицы, версия физического
+// кода и отпечаток расчета
+QByteArray TrajectoryCache::diskKey(double initialAngle, double normalizedDamping)
+{
+    return ResultKey("normalized-trajectory")
+        .add(initialAngle)
+        .add(normalizedDamping)
+        .add(TABLE_STEP)
+        .add(MAX_DURATION)
+        .add(REST_ENERGY_FRACTION)
+        .add(PHYSICS_CODE_VERSION)
+        .add(codeFingerprint())
+        .hex();
+}
+
+// Отпечаток расчета — хэш двух коротких эталонных траекторий (с
+// сопротивлением и без). Любая правка compute(), меняющая результат,
+// меняет отпечаток, и записи старой версии больше не находятся.
+const QByteArray &TrajectoryCache::codeFingerprint()
+{
+    static const QByteArray fingerprint = [] {
+        ResultKey key("normalized-trajectory-code");
+        for (double damping : {0.0, 0.5}) {
+            std::shared_ptr<const NormalizedTrajectory> reference = compute(1.0, damping);
+            key.add(reference->period).add(static_cast<qint64>(reference->periodic));
+            for (std::size_t i = 0; i < reference->angles.size(); ++i) {
+                key.add(reference->angles[i]).add(reference->velocities[i]);
+            }
+        }
+        return key.hex();
+    }();
+    return fingerprint;
+}
+
+std::shared_ptr<const NormalizedTrajectory> TrajectoryCache::load(const QByteArray &key)
+{
+    QByteArray data;
+    if (!ResultCache::instance().lookup(key, data) || data.size() < static_cast<qint64>(sizeof(StoredTrajectoryHeader))) {
+        return nullptr;
+    }
+    StoredTrajectoryHeader header;
+    std::memcpy(&header, data.constData(), sizeof(header));
+    const qint64 arrayBytes = header.count * static_cast<qint64>(sizeof(double));
+    if (header.count <= 0 || data.size() != static_cast<qint64>(sizeof(header)) + 2 * arrayBytes) {
+        return nullptr;
+    }
+
+    auto result = std::make_shared<NormalizedTrajectory>();
+    result->initialAngle = header.initialAngle;
+    result->damping = header.damping;
+    result->step = header.step;
+    result->period = header.period;
+    result->periodic = header.periodic != 0;
+    result->settled = header.settled != 0;
+    result->angles.resize(header.count);
+    result->velocities.resize(header.count);
+    const char *arrays = data.constData() + sizeof(header);
+    std::memcpy(result->angles.data(), arrays, arrayBytes);
+    std::memcpy(result->velocities.data(), arrays + arrayBytes, arrayBytes);
+    return result;
+}
+
+void TrajectoryCache::save(const QByteArray &key, const NormalizedTrajectory &trajectory)
+{
+    StoredTrajectoryHeader header;
+    header.initialAngle = trajectory.initialAngle;
+    header.damping = trajectory.damping;
+    header.step = trajectory.step;
+    header.period = trajectory.period;
+    header.periodic = trajectory.periodic ? 1 : 0;
+    header.settled = trajectory.settled ? 1 : 0;
+    header.count = static_cast<qint64>(trajectory.angles.size());
+
+    const qint64 arrayBytes = header.count * static_cast<qint64>(sizeof(double));
+    QByteArray data;
+    data.reserve(sizeof(header) + 2 * arrayBytes);
+    data.append(reinterpret_cast<const char *>(&header), sizeof(header));
+    data.append(reinterpret_cast<const char *>(trajectory.angles.data()), arrayBytes);
+    data.append(reinterpret_cast<const char *>(trajectory.velocities.data()), arrayBytes);
+    ResultCache::instance().store(key, data);
+}
+
+// Модель с масштабом времени для заданных длины и массы. Таблицы еще
+// нет, но начальное состояние известно и без нее.
+CachedTrajectoryModel::CachedTrajectoryModel(double initialAngle, double normalizedDamping,
+                                             double gravity, double length, double mass) :
+    initialAngle(initialAngle), normalizedDamping(normalizedDamping),
+    gravity(gravity), length(length), mass(mass), timeScale(std::sqrt(gravity / length))
+{
+    initialEnergy = mechanicalEnergy(initialAngle * PhysicsConstants<double>::radToDeg(), 0.0);
+}
+
+// Продвижение по таблице — только счет шагов; состояние каждого шага
+// читается из таблицы для спектрального анализа
+void CachedTrajectoryModel::advance(long steps, double dt)
+{
+    if (dt != stepSize) {
+        analyzer.reset(dt);
+        stepSize = dt;
+    }
+    if (!trajectory && !continued) {
+        trajectory = TrajectoryCache::instance().trajectory(initialAngle, normalizedDamping);
+    }
+    for (long i = 0; i < steps; ++i) {
+        if (!continued && !trajectory->periodic && !trajectory->settled &&
+            tauAt(stepCount + 1) > trajectory->endTau()) {
+            continueWithKernel();
+        }
+        ++stepCount;
+        if (continued) {
+            previousKernelState = kernelState;
+            kernel.step(kernelState, dt);
+            analyzer.addSample(stateCoordinate(kernelState));
+        } else {
+            double angle, angularVelocity;
+            stateAt(stepCount, angle, angularVelocity);
+            analyzer.addSample(angle);
+        }
+    }
+}
+
+// Ядро получает состояние последнего шага по таблице, те же длину, массу
+// и коэффициент сопротивления c = c̃·sqrt(g/L), а также уже рассеянную
+// энергию
+void CachedTrajectoryModel::continueWithKernel()
+{
+    kernel.gravity = gravity;
+    kernel.length = length;
+    kernel.mass = mass;
+    kernel.damping.term<LinearDrag>().coeff = normalizedDamping * timeScale;
+
+    double angle, angularVelocity;
+    stateAt(stepCount, angle, angularVelocity);
+    kernelState.angle = angle;
+    kernelState.angularVelocity = angularVelocity;
+    kernelState.dissipatedEnergy = initialEnergy - mechanicalEnergy(angle, angularVelocity);
+    previousKernelState = kernelState;
+    continued = true;
+}
+
+void CachedTrajectoryModel::writeSnapshot(PhysicsSnapshot &snapshot) const
+{
+    snapshot.step = stepCount;
+    snapshot.simulatedTime = stepCount * stepSize;
+    snapshot.stepSize = stepSize;
+    snapshot.stuckByFriction = false;
+    snapshot.spectrum = analyzer.estimate();
+    if (continued) {
+        writeState(previousKernelState, snapshot.previousState);
+        writeState(kernelState, snapshot.state);
+        snapshot.dissipatedEnergy = kernelState.dissipatedEnergy;
+        return;
+    }
+    stateAt(stepCount > 0 ? stepCount - 1 : 0, snapshot.previousState[0], snapshot.previousState[1]);
+    stateAt(stepCount, snapshot.state[0], snapshot.state[1]);
+    // Вязкое сопротивление — единственный неконсервативный член
+    snapshot.dissipatedEnergy = initialEnergy - mechanicalEnergy(snapshot.state[0], snapshot.state[1]);
+}
+
+// Копия разделяет ту же траекторию из кэша
+std::unique_ptr<PhysicsModel> CachedTrajectoryModel::clone() const
+{
+    return std::make_unique<CachedTrajectoryModel>(*this);
+}
+
+// Правка на границе шага. Угол и угловая скорость не меняются,
+// рассеянная энергия сохраняется.
+bool CachedTrajectoryModel::setParameter(PhysicsParameter parameter, double value)
+{
+    if (!continued && parameter == PhysicsParameter::Length) {
+        continueWithKernel();
+    }
+    if (continued) {
+        return applyParameter(kernel, parameter, value);
+    }
+    if (parameter != PhysicsParameter::Mass) {
+        return false;
+    }
+
+    double angle, angularVelocity;
+    stateAt(stepCount, angle, angularVelocity);
+    double dissipated = initialEnergy - mechanicalEnergy(angle, angularVelocity);
+    mass = value;
+    initialEnergy = mechanicalEnergy(angle, angularVelocity) + dissipated;
+    return true;
+}
+
+double CachedTrajectoryModel::tauAt(long long step) const
+{
+    return step * stepSize * timeScale;
+}
+
+// Состояние на шаге step в единицах MathPendulum. До первого продвижения
+// таблицы еще нет, и маятник стоит в начальном угле.
+void CachedTrajectoryModel::stateAt(long long step, double &angle, double &angularVelocity) const
+{
+    const double radToDeg = PhysicsConstants<double>::radToDeg();
+    if (!trajectory) {
+        angle = initialAngle * radToDeg;
+        angularVelocity = 0.0;
+        return;
+    }
+    double normalizedAngle, normalizedVelocity;
+    trajectory->sample(tauAt(step), normalizedAngle, normalizedVelocity);
+    angle = normalizedAngle * radToDeg;
+    angularVelocity = normalizedVelocity * timeScale * radToDeg;
+}
+
+double CachedTrajectoryModel::mechanicalEnergy(double angle, double angularVelocity) const
+{
+    const double degToRad = PhysicsConstants<double>::degToRad();
+    double speed = angularVelocity * degToRad * length;
+    return 0.5 * mass * speed * speed + mass * gravity * length * (1.0 - std::cos(angle * degToRad));
+}
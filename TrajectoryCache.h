@@ -0,0 +1,120 @@
+#ifndef TRAJECTORYCACHE_H
+#define TRAJECTORYCACHE_H
+
+#include <QByteArray>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "PhysicsModel.h"
+
+// Безразмерная траектория математического маятника с линейным
+// сопротивлением. В безразмерном времени τ = t·sqrt(g/L) уравнение
+// θ'' = -sin θ - c̃·θ' зависит только от начального угла и от
+// c̃ = c·sqrt(L/g); масса сокращается. Одна траектория подходит для любой
+// длины и массы — меняется только масштаб времени.
+struct NormalizedTrajectory {
+    double initialAngle = 0.0;      // рад
+    double damping = 0.0;           // c̃
+    double step = 0.0;              // шаг таблицы по τ
+    // Без сопротивления хранится ровно один период и τ берется по модулю
+    bool periodic = false;
+    double period = 0.0;
+    // Энергия упала до уровня покоя; иначе таблица оборвана на
+    // MAX_DURATION и за ее концом движение продолжается интегрированием
+    bool settled = false;
+    std::vector<double> angles;     // θ, рад
+    std::vector<double> velocities; // dθ/dτ
+
+    // Эрмитова интерполяция по таблице; за концом успокоившейся таблицы
+    // маятник покоится
+    void sample(double tau, double &angle, double &velocity) const;
+    // Последний момент τ, который есть в таблице
+    double endTau() const { return (angles.size() - 1) * step; }
+};
+
+// Кэш безразмерных траекторий по ключу (начальный угол, c̃).
+// Траектории считаются один раз методом Рунге–Кутты 4-го порядка с
+// мелким шагом и разделяются между моделями через shared_ptr.
+class TrajectoryCache
+{
+public:
+    static TrajectoryCache &instance();
+
+    std::shared_ptr<const NormalizedTrajectory> trajectory(double initialAngle, double normalizedDamping);
+
+private:
+    static constexpr std::size_t MAX_ENTRIES = 16;
+    static constexpr double TABLE_STEP = 0.02;
+    // Длина таблицы с сопротивлением ограничена; слабо затухающее движение
+    // после MAX_DURATION досчитывает CachedTrajectoryModel
+    static constexpr double MAX_DURATION = 20000.0;
+    // Траектория обрывается, когда энергия упала в столько раз
+    static constexpr double REST_ENERGY_FRACTION = 1e-12;
+
+    static std::shared_ptr<const NormalizedTrajectory> compute(double initialAngle, double normalizedDamping);
+    // Траектории сохраняются и в ResultCache, так что повторный запуск с
+    // теми же углом и c̃ не считает их заново даже после перезапуска
+    static std::shared_ptr<const NormalizedTrajectory> load(const QByteArray &key);
+    static void save(const QByteArray &key, const NormalizedTrajectory &trajectory);
+    static QByteArray diskKey(double initialAngle, double normalizedDamping);
+    static const QByteArray &codeFingerprint();
+
+    std::mutex mutex;
+    // Недавно использованные записи — в начале списка
+    std::list<std::shared_ptr<const NormalizedTrajectory>> entries;
+};
+
+// Модель, которая не интегрирует, а пересчитывает время в τ и читает
+// состояние из кэшированной траектории. Состояние и единицы — как у
+// MathPendulumKernel (градусы, градусы/с).
+// Таблица запрашивается у TrajectoryCache при первом продвижении, то есть
+// в потоке физики: расчет и запись в ResultCache не задерживают интерфейс.
+// Если таблица оборвана раньше, чем маятник успокоился, или изменилась
+// длина, движение с текущего состояния продолжает ядро MathPendulumKernel.
+class CachedTrajectoryModel : public PhysicsModel
+{
+public:
+    // initialAngle — в радианах, normalizedDamping — c̃ = c·sqrt(L/g)
+    CachedTrajectoryModel(double initialAngle, double normalizedDamping,
+                          double gravity, double length, double mass);
+
+    void advance(long steps, double dt) override;
+    void writeSnapshot(PhysicsSnapshot &snapshot) const override;
+    std::unique_ptr<PhysicsModel> clone() const override;
+    // Масса меняется в таблице. Смена длины, как и в KernelModel,
+    // сохраняет угол и угловую скорость; из такого состояния маятник уже
+    // не движется по таблице, и дальше его ведет ядро.
+    bool setParameter(PhysicsParameter parameter, double value) override;
+
+private:
+    using ContinuationKernel = MathPendulumKernel<DoublePrecision, DampingModel<double, LinearDrag>>;
+
+    void stateAt(long long step, double &angle, double &angularVelocity) const;
+    double mechanicalEnergy(double angle, double angularVelocity) const;
+    // τ на шаге step
+    double tauAt(long long step) const;
+    // Переход от таблицы к интегрированию с текущего шага
+    void continueWithKernel();
+
+    double initialAngle;
+    double normalizedDamping;
+    std::shared_ptr<const NormalizedTrajectory> trajectory;
+    double gravity;
+    double length;
+    double mass;
+    double timeScale;       // sqrt(g/L): τ = t · timeScale
+    double initialEnergy;
+
+    // После конца оборванной таблицы или смены длины состояние ведет ядро
+    bool continued = false;
+    ContinuationKernel kernel;
+    ContinuationKernel::State kernelState;
+    ContinuationKernel::State previousKernelState;
+
+    long long stepCount = 0;
+    double stepSize = 0.0;
+    SpectralAnalyzer analyzer;
+};
+
+#endif
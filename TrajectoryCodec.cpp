@@ -0,0 +1,564 @@
+#include "TrajectoryCodec.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace {
+
+const char FILE_MAGIC[4] = {'P', 'T', 'R', 'C'};
+const char INDEX_MAGIC[4] = {'P', 'T', 'R', 'I'};
+const std::uint32_t FORMAT_VERSION = 1;
+// Квантованные значения по модулю не больше 2^50: дальше частное v/step
+// и произведение q·step теряют дробные биты, и граница ошибки держится
+// только случайно
+const double MAX_QUANTIZED = 1125899906842624.0;
+
+inline std::uint64_t lowMask(int count)
+{
+    return count >= 64 ? ~std::uint64_t(0) : (std::uint64_t(1) << count) - 1;
+}
+
+inline std::uint64_t doubleBits(double value)
+{
+    std::uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+inline double bitsToDouble(std::uint64_t bits)
+{
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+inline int leadingZeros(std::uint64_t value)
+{
+    return value == 0 ? 64 : __builtin_clzll(value);
+}
+
+inline int trailingZeros(std::uint64_t value)
+{
+    return value == 0 ? 64 : __builtin_ctzll(value);
+}
+
+// Линейный прогноз 2·a - b. Записан без умножения, чтобы компилятор не
+// превратил его в FMA по-разному в кодере и декодере.
+inline double predictValue(double previous, double beforePrevious)
+{
+    double twice = previous + previous;
+    double prediction = twice - beforePrevious;
+    return std::isfinite(prediction) ? prediction : previous;
+}
+
+// Запись бит старшими вперед. Выход заранее расширяется до худшего
+// случая, поэтому внутри цикла нет проверок емкости.
+class BitWriter
+{
+public:
+    BitWriter(std::vector<std::uint8_t> &out, std::size_t maxBits) : out(out), start(out.size())
+    {
+        out.resize(start + (maxBits + 63) / 64 * 8);
+        cursor = out.data() + start;
+    }
+
+    void write(std::uint64_t value, int count)
+    {
+        if (count == 0) {
+            return;
+        }
+        value &= lowMask(count);
+        int free = 64 - used;
+        if (count < free) {
+            buffer |= value << (free - count);
+            used += count;
+            return;
+        }
+        int rest = count - free;
+        buffer |= value >> rest;
+        emit();
+        buffer = rest > 0 ? value << (64 - rest) : 0;
+        used = rest;
+    }
+
+    void flush()
+    {
+        std::size_t bytes = (used + 7) / 8;
+        emit();
+        out.resize(cursor - out.data() - 8 + bytes);
+        buffer = 0;
+        used = 0;
+    }
+
+private:
+    void emit()
+    {
+        std::uint64_t bigEndian = __builtin_bswap64(buffer);
+        std::memcpy(cursor, &bigEndian, sizeof(bigEndian));
+        cursor += sizeof(bigEndian);
+    }
+
+    std::vector<std::uint8_t> &out;
+    std::size_t start;
+    std::uint8_t *cursor;
+    std::uint64_t buffer = 0;
+    int used = 0;
+};
+
+class BitReader
+{
+public:
+    BitReader(const std::uint8_t *data, std::size_t size) : data(data), end(data + size) {}
+
+    std::uint64_t read(int count)
+    {
+        std::uint64_t result = 0;
+        while (count > 0) {
+            if (available == 0 && !refill()) {
+                overrun = true;
+                return 0;
+            }
+            int take = std::min(count, available);
+            std::uint64_t bits = (buffer >> (available - take)) & lowMask(take);
+            result = take == 64 ? bits : (result << take) | bits;
+            available -= take;
+            count -= take;
+        }
+        return result;
+    }
+
+    bool bit() { return read(1) != 0; }
+    bool failed() const { return overrun; }
+
+private:
+    bool refill()
+    {
+        std::size_t bytes = std::min<std::size_t>(8, end - data);
+        if (bytes == 0) {
+            return false;
+        }
+        buffer = 0;
+        for (std::size_t i = 0; i < bytes; ++i) {
+            buffer = (buffer << 8) | data[i];
+        }
+        data += bytes;
+        available = static_cast<int>(bytes * 8);
+        return true;
+    }
+
+    const std::uint8_t *data;
+    const std::uint8_t *end;
+    std::uint64_t buffer = 0;
+    int available = 0;
+    bool overrun = false;
+};
+
+// XOR с прогнозом: '0' — совпадение; '10' — значащие биты в прежнем
+// окне; '11' — новое окно (6 бит ведущих нулей, 6 бит длины - 1)
+void encodeXorChannel(BitWriter &writer, const double *values, std::size_t stride, std::size_t samples)
+{
+    int windowLeading = -1;
+    int windowTrailing = 0;
+    for (std::size_t i = 0; i < samples; ++i) {
+        double value = values[i * stride];
+        if (i == 0) {
+            writer.write(doubleBits(value), 64);
+            continue;
+        }
+        double previous = values[(i - 1) * stride];
+        double prediction = i == 1 ? previous : predictValue(previous, values[(i - 2) * stride]);
+        std::uint64_t delta = doubleBits(value) ^ doubleBits(prediction);
+        if (delta == 0) {
+            writer.write(0, 1);
+            continue;
+        }
+
+        int leading = std::min(leadingZeros(delta), 63);
+        int trailing = trailingZeros(delta);
+        if (windowLeading >= 0 && leading >= windowLeading && trailing >= windowTrailing) {
+            writer.write(0b10, 2);
+            writer.write(delta >> windowTrailing, 64 - windowLeading - windowTrailing);
+        } else {
+            int length = 64 - leading - trailing;
+            writer.write(0b11, 2);
+            writer.write(leading, 6);
+            writer.write(length - 1, 6);
+            writer.write(delta >> trailing, length);
+            windowLeading = leading;
+            windowTrailing = trailing;
+        }
+    }
+}
+
+bool decodeXorChannel(BitReader &reader, double *values, std::size_t stride, std::size_t samples)
+{
+    int windowLeading = -1;
+    int windowTrailing = 0;
+    for (std::size_t i = 0; i < samples; ++i) {
+        if (i == 0) {
+            values[0] = bitsToDouble(reader.read(64));
+            continue;
+        }
+        double previous = values[(i - 1) * stride];
+        double prediction = i == 1 ? previous : predictValue(previous, values[(i - 2) * stride]);
+        std::uint64_t delta = 0;
+        if (reader.bit()) {
+            if (reader.bit()) {
+                windowLeading = static_cast<int>(reader.read(6));
+                int length = static_cast<int>(reader.read(6)) + 1;
+                windowTrailing = 64 - windowLeading - length;
+                if (windowTrailing < 0) {
+                    return false;
+                }
+            } else if (windowLeading < 0) {
+                return false;
+            }
+            delta = reader.read(64 - windowLeading - windowTrailing) << windowTrailing;
+        }
+        values[i * stride] = bitsToDouble(doubleBits(prediction) ^ delta);
+    }
+    return !reader.failed();
+}
+
+inline std::uint64_t zigzag(std::uint64_t value)
+{
+    return (value << 1) ^ (static_cast<std::uint64_t>(static_cast<std::int64_t>(value) >> 63));
+}
+
+inline std::uint64_t unzigzag(std::uint64_t value)
+{
+    return (value >> 1) ^ (~(value & 1) + 1);
+}
+
+// Остаток прогноза: '0' — ноль, '10' + 6 бит, '110' + 13 бит,
+// '1110' + 20 бит, '1111' + 64 бита
+void writeResidual(BitWriter &writer, std::uint64_t residual)
+{
+    std::uint64_t code = zigzag(residual);
+    if (code == 0) {
+        writer.write(0, 1);
+    } else if (code < (1u << 6)) {
+        writer.write(0b10, 2);
+        writer.write(code, 6);
+    } else if (code < (1u << 13)) {
+        writer.write(0b110, 3);
+        writer.write(code, 13);
+    } else if (code < (1u << 20)) {
+        writer.write(0b1110, 4);
+        writer.write(code, 20);
+    } else {
+        writer.write(0b1111, 4);
+        writer.write(code, 64);
+    }
+}
+
+std::uint64_t readResidual(BitReader &reader)
+{
+    static const int widths[] = {6, 13, 20, 64};
+    if (!reader.bit()) {
+        return 0;
+    }
+    int bucket = 0;
+    while (bucket < 3 && reader.bit()) {
+        ++bucket;
+    }
+    return unzigzag(reader.read(widths[bucket]));
+}
+
+// Квантование канала. Каждое значение восстанавливается так же, как в
+// decodeQuantizedChannel, и сравнивается с исходным; false — значение не
+// конечно, слишком велико или не укладывается в tolerance.
+bool quantizeChannel(const double *values, std::size_t stride, std::size_t samples, double step,
+                     double tolerance, std::vector<std::int64_t> &quantized)
+{
+    const double inverseStep = 1.0 / step;
+    quantized.resize(samples);
+    for (std::size_t i = 0; i < samples; ++i) {
+        const double value = values[i * stride];
+        const double scaled = value * inverseStep;
+        // Сравнение ложно и для NaN
+        if (!(std::abs(scaled) <= MAX_QUANTIZED)) {
+            return false;
+        }
+        // Округление до ближайшего без вызова библиотеки
+        std::int64_t rounded = static_cast<std::int64_t>(scaled + std::copysign(0.5, scaled));
+        if (!(std::abs(static_cast<double>(rounded) * step - value) <= tolerance)) {
+            return false;
+        }
+        quantized[i] = rounded;
+    }
+    return true;
+}
+
+// Целые прогнозируются по модулю 2^64, поэтому переполнение не искажает
+// восстановление
+void encodeQuantizedChannel(BitWriter &writer, const std::vector<std::int64_t> &values)
+{
+    std::uint64_t previous = 0, beforePrevious = 0;
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        std::uint64_t quantized = static_cast<std::uint64_t>(values[i]);
+        std::uint64_t prediction = i == 0 ? 0 : i == 1 ? previous : 2 * previous - beforePrevious;
+        writeResidual(writer, quantized - prediction);
+        beforePrevious = previous;
+        previous = quantized;
+    }
+}
+
+bool decodeQuantizedChannel(BitReader &reader, double *values, std::size_t stride,
+                            std::size_t samples, double step)
+{
+    std::uint64_t previous = 0, beforePrevious = 0;
+    for (std::size_t i = 0; i < samples; ++i) {
+        std::uint64_t prediction = i == 0 ? 0 : i == 1 ? previous : 2 * previous - beforePrevious;
+        std::uint64_t quantized = prediction + readResidual(reader);
+        values[i * stride] = static_cast<double>(static_cast<std::int64_t>(quantized)) * step;
+        beforePrevious = previous;
+        previous = quantized;
+    }
+    return !reader.failed();
+}
+
+template <typename T>
+void appendValue(std::vector<std::uint8_t> &out, const T &value)
+{
+    const std::uint8_t *bytes = reinterpret_cast<const std::uint8_t *>(&value);
+    out.insert(out.end(), bytes, bytes + sizeof(T));
+}
+
+template <typename T>
+bool readValue(std::FILE *file, T &value)
+{
+    return std::fread(&value, sizeof(T), 1, file) == 1;
+}
+
+}
+
+// Каналы блока подряд; перед каждым бит режима (1 — квантование)
+void encodeTrajectoryChunk(const double *values, std::size_t samples,
+                           const std::vector<TrajectoryChannel> &channels,
+                           std::vector<std::uint8_t> &out)
+{
+    // Худший случай: бит режима и 64 + 14 бит на значение
+    BitWriter writer(out, channels.size() * (1 + samples * 78) + 64);
+    const std::size_t stride = channels.size();
+    std::vector<std::int64_t> quantized;
+    for (std::size_t c = 0; c < channels.size(); ++c) {
+        const double tolerance = channels[c].tolerance;
+        const double step = 2.0 * tolerance;
+        if (step > 0.0 && quantizeChannel(values + c, stride, samples, step, tolerance, quantized)) {
+            writer.write(1, 1);
+            encodeQuantizedChannel(writer, quantized);
+        } else {
+            writer.write(0, 1);
+            encodeXorChannel(writer, values + c, stride, samples);
+        }
+    }
+    writer.flush();
+}
+
+bool decodeTrajectoryChunk(const std::uint8_t *data, std::size_t size, std::size_t samples,
+                           const std::vector<TrajectoryChannel> &channels,
+                           std::vector<double> &values)
+{
+    BitReader reader(data, size);
+    const std::size_t stride = channels.size();
+    values.assign(samples * stride, 0.0);
+    if (samples == 0) {
+        return true;
+    }
+    for (std::size_t c = 0; c < channels.size(); ++c) {
+        bool ok = reader.bit()
+                      ? decodeQuantizedChannel(reader, values.data() + c, stride, samples, 2.0 * channels[c].tolerance)
+                      : decodeXorChannel(reader, values.data() + c, stride, samples);
+        if (!ok) {
+            return false;
+        }
+    }
+    return true;
+}
+
+TrajectoryWriter::~TrajectoryWriter()
+{
+    if (file) {
+        close();
+    }
+}
+
+// Заголовок: метка, версия, число каналов, размер блока, шаг и начало
+// времени, затем допуск и имя каждого канала
+bool TrajectoryWriter::open(const std::string &fileName, const std::vector<TrajectoryChannel> &channels,
+                            double sampleInterval, double startTime, std::size_t chunkSamples)
+{
+    if (channels.empty() || chunkSamples == 0) {
+        return false;
+    }
+    file = std::fopen(fileName.c_str(), "wb");
+    if (!file) {
+        return false;
+    }
+    this->channels = channels;
+    this->chunkSamples = chunkSamples;
+    pending.clear();
+    pending.reserve(chunkSamples * channels.size());
+    index.clear();
+    samples = 0;
+    offset = 0;
+    failed = false;
+
+    std::vector<std::uint8_t> header(FILE_MAGIC, FILE_MAGIC + sizeof(FILE_MAGIC));
+    appendValue(header, FORMAT_VERSION);
+    appendValue(header, static_cast<std::uint32_t>(channels.size()));
+    appendValue(header, static_cast<std::uint32_t>(chunkSamples));
+    appendValue(header, sampleInterval);
+    appendValue(header, startTime);
+    for (const TrajectoryChannel &channel : channels) {
+        appendValue(header, channel.tolerance);
+        appendValue(header, static_cast<std::uint32_t>(channel.name.size()));
+        header.insert(header.end(), channel.name.begin(), channel.name.end());
+    }
+    return writeBytes(header.data(), header.size());
+}
+
+bool TrajectoryWriter::append(const double *values)
+{
+    if (!file || failed) {
+        return false;
+    }
+    pending.insert(pending.end(), values, values + channels.size());
+    ++samples;
+    if (pending.size() == chunkSamples * channels.size()) {
+        return flushChunk();
+    }
+    return true;
+}
+
+bool TrajectoryWriter::flushChunk()
+{
+    std::size_t count = pending.size() / channels.size();
+    if (count == 0) {
+        return true;
+    }
+    encoded.clear();
+    encodeTrajectoryChunk(pending.data(), count, channels, encoded);
+    index.push_back({offset, encoded.size(), static_cast<std::uint32_t>(count)});
+    pending.clear();
+    return writeBytes(encoded.data(), encoded.size());
+}
+
+// Последний неполный блок, оглавление и хвост: число блоков, смещение
+// оглавления и метка
+bool TrajectoryWriter::close()
+{
+    if (!file) {
+        return false;
+    }
+    flushChunk();
+
+    std::vector<std::uint8_t> footer;
+    std::uint64_t indexOffset = offset;
+    for (const ChunkEntry &entry : index) {
+        appendValue(footer, entry.offset);
+        appendValue(footer, entry.size);
+        appendValue(footer, entry.samples);
+    }
+    appendValue(footer, static_cast<std::uint64_t>(index.size()));
+    appendValue(footer, indexOffset);
+    footer.insert(footer.end(), INDEX_MAGIC, INDEX_MAGIC + sizeof(INDEX_MAGIC));
+    writeBytes(footer.data(), footer.size());
+
+    bool ok = std::fclose(file) == 0 && !failed;
+    file = nullptr;
+    return ok;
+}
+
+bool TrajectoryWriter::writeBytes(const void *data, std::size_t size)
+{
+    if (std::fwrite(data, 1, size, file) != size) {
+        failed = true;
+        return false;
+    }
+    offset += size;
+    return true;
+}
+
+TrajectoryReader::~TrajectoryReader()
+{
+    if (file) {
+        std::fclose(file);
+    }
+}
+
+bool TrajectoryReader::open(const std::string &fileName)
+{
+    file = std::fopen(fileName.c_str(), "rb");
+    if (!file) {
+        return false;
+    }
+
+    char magic[4];
+    std::uint32_t version, channelCount, chunkSamples;
+    if (std::fread(magic, 1, sizeof(magic), file) != sizeof(magic) ||
+        std::memcmp(magic, FILE_MAGIC, sizeof(magic)) != 0 ||
+        !readValue(file, version) || version != FORMAT_VERSION ||
+        !readValue(file, channelCount) || !readValue(file, chunkSamples) ||
+        !readValue(file, interval) || !readValue(file, start)) {
+        return false;
+    }
+    channelList.resize(channelCount);
+    for (TrajectoryChannel &channel : channelList) {
+        std::uint32_t nameLength;
+        if (!readValue(file, channel.tolerance) || !readValue(file, nameLength)) {
+            return false;
+        }
+        channel.name.resize(nameLength);
+        if (nameLength > 0 && std::fread(&channel.name[0], 1, nameLength, file) != nameLength) {
+            return false;
+        }
+    }
+
+    // Хвост файла: число блоков, смещение оглавления, метка
+    std::uint64_t chunkCount, indexOffset;
+    if (std::fseek(file, -static_cast<long>(2 * sizeof(std::uint64_t) + sizeof(INDEX_MAGIC)), SEEK_END) != 0 ||
+        !readValue(file, chunkCount) || !readValue(file, indexOffset) ||
+        std::fread(magic, 1, sizeof(magic), file) != sizeof(magic) ||
+        std::memcmp(magic, INDEX_MAGIC, sizeof(magic)) != 0 ||
+        std::fseek(file, static_cast<long>(indexOffset), SEEK_SET) != 0) {
+        return false;
+    }
+    index.resize(chunkCount);
+    std::uint64_t firstSample = 0;
+    for (ChunkEntry &entry : index) {
+        if (!readValue(file, entry.offset) || !readValue(file, entry.size) || !readValue(file, entry.samples)) {
+            return false;
+        }
+        entry.firstSample = firstSample;
+        firstSample += entry.samples;
+    }
+    return true;
+}
+
+std::uint64_t TrajectoryReader::sampleCount() const
+{
+    return index.empty() ? 0 : index.back().firstSample + index.back().samples;
+}
+
+std::size_t TrajectoryReader::chunkForSample(std::uint64_t sample) const
+{
+    auto it = std::upper_bound(index.begin(), index.end(), sample,
+                               [](std::uint64_t value, const ChunkEntry &entry) { return value < entry.firstSample; });
+    return it == index.begin() ? 0 : static_cast<std::size_t>(it - index.begin() - 1);
+}
+
+bool TrajectoryReader::readChunk(std::size_t chunk, std::vector<double> &values) const
+{
+    if (chunk >= index.size()) {
+        return false;
+    }
+    const ChunkEntry &entry = index[chunk];
+    std::vector<std::uint8_t> data(entry.size);
+    if (std::fseek(file, static_cast<long>(entry.offset), SEEK_SET) != 0 ||
+        std::fread(data.data(), 1, data.size(), file) != data.size()) {
+        return false;
+    }
+    return decodeTrajectoryChunk(data.data(), data.size(), entry.samples, channelList, values);
+}
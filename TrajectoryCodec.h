@@ -0,0 +1,120 @@
+#ifndef TRAJECTORYCODEC_H
+#define TRAJECTORYCODEC_H
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// Сжатие записей траектории: несколько каналов (угол, скорость, энергии)
+// с постоянным шагом по времени. Запись делится на блоки; каждый блок
+// кодируется независимо, поэтому любой участок читается без распаковки
+// предыдущих. Внутри блока значения канала идут подряд и кодируются
+// относительно линейного прогноза по двум предыдущим:
+//   - без потерь (tolerance = 0) — XOR с прогнозом в стиле Gorilla:
+//     у гладкой траектории совпадают знак, порядок и старшие биты
+//     мантиссы, и хранится только короткое окно значащих бит;
+//   - с ограниченной ошибкой (tolerance > 0) — значение квантуется с шагом
+//     2·tolerance, хранится остаток прогноза целого числа кодом
+//     переменной длины. Кодер проверяет каждое восстановленное значение;
+//     если хоть одно отличается от исходного больше чем на tolerance
+//     (значения порядка 2^50 шагов и больше), канал блока пишется без
+//     потерь. Поэтому ошибка восстановления никогда не больше tolerance.
+// Формат предполагает little-endian порядок байт.
+
+struct TrajectoryChannel {
+    std::string name;
+    // Допустимая абсолютная ошибка; 0 — без потерь
+    double tolerance = 0.0;
+};
+
+// Кодирование блока. values — samples строк по channels.size() значений.
+void encodeTrajectoryChunk(const double *values, std::size_t samples,
+                           const std::vector<TrajectoryChannel> &channels,
+                           std::vector<std::uint8_t> &out);
+bool decodeTrajectoryChunk(const std::uint8_t *data, std::size_t size, std::size_t samples,
+                           const std::vector<TrajectoryChannel> &channels,
+                           std::vector<double> &values);
+
+// Потоковая запись в файл: значения накапливаются до полного блока,
+// оглавление блоков пишется в конец файла при close()
+class TrajectoryWriter
+{
+public:
+    static constexpr std::size_t DEFAULT_CHUNK_SAMPLES = 4096;
+
+    TrajectoryWriter() = default;
+    ~TrajectoryWriter();
+    TrajectoryWriter(const TrajectoryWriter &) = delete;
+    TrajectoryWriter &operator=(const TrajectoryWriter &) = delete;
+
+    bool open(const std::string &fileName, const std::vector<TrajectoryChannel> &channels,
+              double sampleInterval, double startTime = 0.0,
+              std::size_t chunkSamples = DEFAULT_CHUNK_SAMPLES);
+    // Одна строка: по значению на канал
+    bool append(const double *values);
+    bool close();
+
+    std::uint64_t sampleCount() const { return samples; }
+    std::uint64_t bytesWritten() const { return offset; }
+
+private:
+    struct ChunkEntry {
+        std::uint64_t offset;
+        std::uint64_t size;
+        std::uint32_t samples;
+    };
+
+    bool flushChunk();
+    bool writeBytes(const void *data, std::size_t size);
+
+    std::FILE *file = nullptr;
+    std::vector<TrajectoryChannel> channels;
+    std::size_t chunkSamples = DEFAULT_CHUNK_SAMPLES;
+    std::vector<double> pending;
+    std::vector<std::uint8_t> encoded;
+    std::vector<ChunkEntry> index;
+    std::uint64_t samples = 0;
+    std::uint64_t offset = 0;
+    bool failed = false;
+};
+
+// Чтение с произвольным доступом по блокам
+class TrajectoryReader
+{
+public:
+    TrajectoryReader() = default;
+    ~TrajectoryReader();
+    TrajectoryReader(const TrajectoryReader &) = delete;
+    TrajectoryReader &operator=(const TrajectoryReader &) = delete;
+
+    bool open(const std::string &fileName);
+
+    const std::vector<TrajectoryChannel> &channels() const { return channelList; }
+    double sampleInterval() const { return interval; }
+    double startTime() const { return start; }
+    std::uint64_t sampleCount() const;
+    std::size_t chunkCount() const { return index.size(); }
+    std::uint64_t chunkFirstSample(std::size_t chunk) const { return index[chunk].firstSample; }
+    std::size_t chunkSamples(std::size_t chunk) const { return index[chunk].samples; }
+    std::size_t chunkForSample(std::uint64_t sample) const;
+
+    // Значения блока строками, как в TrajectoryWriter::append
+    bool readChunk(std::size_t chunk, std::vector<double> &values) const;
+
+private:
+    struct ChunkEntry {
+        std::uint64_t offset;
+        std::uint64_t size;
+        std::uint32_t samples;
+        std::uint64_t firstSample;
+    };
+
+    std::FILE *file = nullptr;
+    std::vector<TrajectoryChannel> channelList;
+    double interval = 0.0;
+    double start = 0.0;
+    std::vector<ChunkEntry> index;
+};
+
+#endif
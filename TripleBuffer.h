@@ -0,0 +1,51 @@
+#ifndef TRIPLEBUFFER_H
+#define TRIPLEBUFFER_H
+
+#include <atomic>
+
+// Тройной буфер без блокировок для передачи состояния от одного писателя
+// одному читателю. Писатель всегда пишет в свой буфер и публикует его
+// атомарным обменом индекса; читатель забирает последний опубликованный
+// буфер тем же обменом. Ни одна из сторон никогда не ждет другую, а
+// читатель не может увидеть наполовину записанное состояние.
+template <typename T>
+class TripleBuffer
+{
+public:
+    // Буфер писателя: заполняется перед publish()
+    T &writeBuffer() { return buffers[writeIndex]; }
+
+    // Публикация буфера писателя; писатель получает освободившийся буфер
+    void publish()
+    {
+        int previous = shared.exchange(writeIndex | FRESH_FLAG, std::memory_order_acq_rel);
+        writeIndex = previous & INDEX_MASK;
+    }
+
+    // Забрать последнее опубликованное состояние. Возвращает false,
+    // если с прошлого вызова ничего нового не публиковалось.
+    bool fetch()
+    {
+        if (!(shared.load(std::memory_order_relaxed) & FRESH_FLAG)) {
+            return false;
+        }
+        int previous = shared.exchange(readIndex, std::memory_order_acq_rel);
+        readIndex = previous & INDEX_MASK;
+        return true;
+    }
+
+    // Буфер читателя: действителен до следующего fetch()
+    const T &readBuffer() const { return buffers[readIndex]; }
+
+private:
+    static constexpr int INDEX_MASK = 3;
+    static constexpr int FRESH_FLAG = 4;
+
+    T buffers[3]{};
+    // Индексы писателя и читателя лежат в разных строках кэша
+    alignas(64) std::atomic<int> shared{1};
+    alignas(64) int writeIndex = 0;
+    alignas(64) int readIndex = 2;
+};
+
+#endif
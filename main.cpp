@@ -1,12 +1,45 @@
 #include "mainwindow.h"
+#include "InteractionRecorder.h"
+#include "InputLatencyMonitor.h"
 #include <QApplication>
+#include <QCommandLineParser>
+#include <QMessageBox>
+#include <cstdio>
+#include <memory>
 
 
 
 int main(int argc, char *argv[])
 {
     QApplication a(argc, argv);
+
+    // --record FILE: запись действий пользователя для tools/InteractionReplay
+    // --measure-latency: задержка от перетаскивания груза до кадра на экране
+    // и в сводке при выходе
+    QCommandLineParser parser;
+    QCommandLineOption recordOption("record", "Record user interactions to <file>.", "file");
+    QCommandLineOption latencyOption("measure-latency", "Measure input-to-frame latency while dragging the bob.");
+    parser.addHelpOption();
+    parser.addOption(recordOption);
+    parser.addOption(latencyOption);
+    parser.process(a);
+    InputLatencyMonitor::instance().setEnabled(parser.isSet(latencyOption));
+
+    std::unique_ptr<InteractionRecorder> recorder;
+    if (parser.isSet(recordOption)) {
+        recorder.reset(new InteractionRecorder(parser.value(recordOption)));
+        if (!recorder->isOpen()) {
+            QMessageBox::warning(nullptr, "Error", "Cannot open record file: " + recorder->errorString());
+            recorder.reset();
+        }
+    }
+
     MainWindow w;
     w.show();
-    return a.exec();
+    int result = a.exec();
+
+    if (InputLatencyMonitor::instance().isEnabled()) {
+        std::printf("%s\n", qPrintable(InputLatencyMonitor::instance().summary()));
+    }
+    return result;
 }
@@ -2,12 +2,14 @@
 #include "ui_mainwindow.h"
 #include "MathPendulum.h"
 #include "SpringPendulum.h"
+#include "ElasticPendulum.h"
 
 MainWindow::MainWindow(QWidget *parent)
     : QMainWindow(parent)
     , ui(new Ui::MainWindow)
     , mathpen(nullptr)
     , springpen(nullptr)
+    , elasticpen(nullptr)
 {
     ui->setupUi(this);
     setWindowTitle("Pendulum Simulator");
@@ -24,6 +26,10 @@ MainWindow::~MainWindow()
     if (springpen) {
         delete springpen;
     }
+
+    if (elasticpen) {
+        delete elasticpen;
+    }
 }
 
 void MainWindow::on_MathButtoon_clicked()
@@ -43,3 +49,12 @@ void MainWindow::on_SprPenButton_clicked()
     springpen->show();
     this->hide();
 }
+
+void MainWindow::on_ElasticPenButton_clicked()
+{
+    if (!elasticpen) {
+        elasticpen = new ElasticPendulum();
+    }
+    elasticpen->show();
+    this->hide();
+}
@@ -5,6 +5,7 @@
 
 class MathPendulum;
 class SpringPendulum;
+class ElasticPendulum;
 
 QT_BEGIN_NAMESPACE
 namespace Ui { class MainWindow; }
@@ -21,11 +22,13 @@ public:
 private slots:
     void on_MathButtoon_clicked();
     void on_SprPenButton_clicked();
+    void on_ElasticPenButton_clicked();
 
 private:
     Ui::MainWindow *ui;
     MathPendulum *mathpen;
     SpringPendulum *springpen;
+    ElasticPendulum *elasticpen;
 };
 
 #endif
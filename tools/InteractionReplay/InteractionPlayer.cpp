@@ -0,0 +1,277 @@
+#include "InteractionPlayer.h"
+#include "FrameScheduler.h"
+#include <QAbstractButton>
+#include <QAbstractSlider>
+#include <QAction>
+#include <QApplication>
+#include <QEvent>
+#include <QFile>
+#include <QInputDialog>
+#include <QMessageBox>
+#include <QPushButton>
+#include <QTextEdit>
+#include <QTextStream>
+#include <QTimer>
+#include <algorithm>
+
+InteractionPlayer::InteractionPlayer(QObject *parent) :
+    QObject(parent)
+{
+}
+
+// Загрузка записи; нераспознанная строка — ошибка
+bool InteractionPlayer::load(const QString &fileName, QString &error)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        error = file.errorString();
+        return false;
+    }
+
+    interactions.clear();
+    QTextStream stream(&file);
+    int lineNumber = 0;
+    while (!stream.atEnd()) {
+        const QString line = stream.readLine();
+        ++lineNumber;
+        RecordedInteraction interaction;
+        if (RecordedInteraction::fromLine(line, interaction)) {
+            interactions.push_back(interaction);
+        } else if (!line.trimmed().isEmpty() && !line.startsWith('#')) {
+            error = QString("line %1: malformed interaction").arg(lineNumber);
+            return false;
+        }
+    }
+    return true;
+}
+
+void InteractionPlayer::start(double speed, bool skipIdle)
+{
+    this->speed = speed;
+    this->skipIdle = skipIdle;
+    skippedTime = 0;
+    nextInteraction = 0;
+    stats = ReplayStatistics();
+    running = true;
+    clock.start();
+    qApp->installEventFilter(this);
+    watchFrameSchedulers();
+    sampleMemory();
+    scheduleNext();
+}
+
+const ReplayStatistics &InteractionPlayer::statistics() const
+{
+    return stats;
+}
+
+// Модальные окна отвечаются из очереди событий, когда их цикл уже запущен
+bool InteractionPlayer::eventFilter(QObject *watched, QEvent *event)
+{
+    if (running && event->type() == QEvent::Show) {
+        if (QDialog *dialog = qobject_cast<QDialog *>(watched)) {
+            QTimer::singleShot(0, dialog, [this, dialog]() {
+                answerDialog(dialog);
+            });
+        }
+    }
+    return QObject::eventFilter(watched, event);
+}
+
+void InteractionPlayer::scheduleNext()
+{
+    if (nextInteraction >= interactions.size()) {
+        finish();
+        return;
+    }
+
+    // Действия идут по времени записи, деленному на speed. Пауза перед
+    // действием, пока ничего не анимируется, кадров не дает, и с skipIdle
+    // ее можно не ждать.
+    const qint64 time = interactions[nextInteraction].time;
+    const qint64 previousTime = nextInteraction > 0 ? interactions[nextInteraction - 1].time : 0;
+    if (skipIdle && !isAnimating()) {
+        skippedTime += std::max<qint64>(0, time - previousTime);
+    }
+    qint64 due = static_cast<qint64>((time - skippedTime) / speed);
+    qint64 delay = std::max<qint64>(0, due - clock.elapsed());
+    QTimer::singleShot(delay, this, &InteractionPlayer::dispatchNext);
+}
+
+// Очередное действие. Копия нужна потому, что открытый действием диалог
+// забирает из записи свой ответ, пока действие еще выполняется.
+void InteractionPlayer::dispatchNext()
+{
+    if (!running) {
+        return;
+    }
+    const RecordedInteraction interaction = interactions[nextInteraction++];
+    if (interaction.kind == "end") {
+        finish();
+        return;
+    }
+
+    if (dispatch(interaction)) {
+        ++stats.dispatched;
+    } else {
+        ++stats.skipped;
+        std::fprintf(stderr, "skipped: %lld %s %s %s\n", interaction.time,
+                     qPrintable(interaction.window), qPrintable(interaction.kind),
+                     qPrintable(interaction.object));
+    }
+    watchFrameSchedulers();
+    sampleMemory();
+    scheduleNext();
+}
+
+bool InteractionPlayer::dispatch(const RecordedInteraction &interaction)
+{
+    QWidget *window = nullptr;
+    for (QWidget *widget : QApplication::topLevelWidgets()) {
+        if (widget->isVisible() && interaction.window == widget->metaObject()->className()) {
+            window = widget;
+            break;
+        }
+    }
+    if (!window) {
+        return false;
+    }
+
+    if (interaction.kind == "text") {
+        QTextEdit *edit = window->findChild<QTextEdit *>(interaction.object);
+        if (!edit) {
+            return false;
+        }
+        edit->setPlainText(interaction.value);
+        return true;
+    }
+    if (interaction.kind == "click") {
+        QAbstractButton *button = window->findChild<QAbstractButton *>(interaction.object);
+        if (!button || !button->isEnabled()) {
+            return false;
+        }
+        button->click();
+        return true;
+    }
+    if (interaction.kind == "action") {
+        QAction *action = window->findChild<QAction *>(interaction.object);
+        if (!action || !action->isEnabled()) {
+            return false;
+        }
+        action->trigger();
+        return true;
+    }
+    if (interaction.kind == "slider") {
+        QAbstractSlider *slider = window->findChild<QAbstractSlider *>(interaction.object);
+        if (!slider || !slider->isEnabled()) {
+            return false;
+        }
+        slider->setValue(interaction.value.toInt());
+        return true;
+    }
+    // Ответ диалогу, который так и не открылся
+    return false;
+}
+
+// Окно сообщения закрывается кнопкой по умолчанию; диалог ввода получает
+// записанный ответ, а если его нет — соглашается со значением по умолчанию
+void InteractionPlayer::answerDialog(QWidget *widget)
+{
+    if (QInputDialog *dialog = qobject_cast<QInputDialog *>(widget)) {
+        ++stats.inputDialogs;
+        if (nextInteraction < interactions.size() && interactions[nextInteraction].kind == "input") {
+            const QString value = interactions[nextInteraction++].value;
+            if (value.isEmpty()) {
+                dialog->reject();
+                return;
+            }
+            switch (dialog->inputMode()) {
+            case QInputDialog::DoubleInput:
+                dialog->setDoubleValue(value.toDouble());
+                break;
+            case QInputDialog::IntInput:
+                dialog->setIntValue(value.toInt());
+                break;
+            case QInputDialog::TextInput:
+                dialog->setTextValue(value);
+                break;
+            }
+        }
+        dialog->accept();
+        return;
+    }
+
+    if (QMessageBox *box = qobject_cast<QMessageBox *>(widget)) {
+        ++stats.messageBoxes;
+        if (QPushButton *button = box->defaultButton()) {
+            button->click();
+            return;
+        }
+    }
+    static_cast<QDialog *>(widget)->accept();
+}
+
+// Кадры считаются во всех окнах, в том числе открытых во время сеанса
+void InteractionPlayer::watchFrameSchedulers()
+{
+    for (QWidget *widget : QApplication::topLevelWidgets()) {
+        for (FrameScheduler *scheduler : widget->findChildren<FrameScheduler *>()) {
+            if (scheduler->property("replayWatched").toBool()) {
+                continue;
+            }
+            scheduler->setProperty("replayWatched", true);
+            connect(scheduler, &FrameScheduler::frame, this, [this](double elapsedSeconds) {
+                if (running && elapsedSeconds > 0.0) {
+                    stats.frameIntervals.push_back(elapsedSeconds);
+                }
+            });
+        }
+    }
+}
+
+// Анимация идет хотя бы в одном окне
+bool InteractionPlayer::isAnimating() const
+{
+    for (QWidget *widget : QApplication::topLevelWidgets()) {
+        for (FrameScheduler *scheduler : widget->findChildren<FrameScheduler *>()) {
+            if (scheduler->isActive()) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+// Текущая и пиковая резидентная память процесса (только Linux)
+void InteractionPlayer::sampleMemory()
+{
+    QFile status("/proc/self/status");
+    if (!status.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        return;
+    }
+    QTextStream stream(&status);
+    while (!stream.atEnd()) {
+        const QString line = stream.readLine();
+        const QStringList fields = line.simplified().split(' ');
+        if (fields.size() < 2) {
+            continue;
+        }
+        if (fields[0] == "VmRSS:") {
+            stats.finalResidentKiB = fields[1].toLongLong();
+        } else if (fields[0] == "VmHWM:") {
+            stats.peakResidentKiB = std::max(stats.peakResidentKiB, fields[1].toLongLong());
+        }
+    }
+}
+
+void InteractionPlayer::finish()
+{
+    if (!running) {
+        return;
+    }
+    sampleMemory();
+    stats.wallSeconds = clock.elapsed() / 1000.0;
+    running = false;
+    qApp->removeEventFilter(this);
+    emit finished();
+}
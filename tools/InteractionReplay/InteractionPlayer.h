@@ -0,0 +1,73 @@
+#ifndef INTERACTIONPLAYER_H
+#define INTERACTIONPLAYER_H
+
+#include <QObject>
+#include <QElapsedTimer>
+#include <QString>
+#include <vector>
+#include "InteractionRecorder.h"
+
+class QWidget;
+
+// Итоги воспроизведения
+struct ReplayStatistics {
+    int dispatched = 0;
+    // Действия, для которых не нашлось окна, объекта или кнопка недоступна
+    int skipped = 0;
+    int messageBoxes = 0;
+    int inputDialogs = 0;
+    double wallSeconds = 0.0;
+    // Интервалы между кадрами FrameScheduler всех окон (с)
+    std::vector<double> frameIntervals;
+    // Память процесса по /proc/self/status (КиБ), 0 — недоступно
+    long long finalResidentKiB = 0;
+    long long peakResidentKiB = 0;
+};
+
+// Воспроизведение записи InteractionRecorder. Окно ищется среди видимых
+// окон верхнего уровня по имени класса, объект — по objectName. Модальные
+// окна сообщений закрываются сразу, диалоги ввода получают записанный
+// ответ, поэтому сеанс идет без участия пользователя.
+class InteractionPlayer : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit InteractionPlayer(QObject *parent = nullptr);
+
+    bool load(const QString &fileName, QString &error);
+
+    // speed — во сколько раз быстрее записи. Паузы, пока идет анимация,
+    // сохраняются (деленные на speed): за них и набираются кадры.
+    // skipIdle — паузы, пока ни одно окно не анимирует, пропускаются.
+    void start(double speed, bool skipIdle);
+    const ReplayStatistics &statistics() const;
+
+signals:
+    void finished();
+
+protected:
+    bool eventFilter(QObject *watched, QEvent *event) override;
+
+private:
+    void scheduleNext();
+    void dispatchNext();
+    bool dispatch(const RecordedInteraction &interaction);
+    void answerDialog(QWidget *dialog);
+    void watchFrameSchedulers();
+    bool isAnimating() const;
+    void sampleMemory();
+    void finish();
+
+    std::vector<RecordedInteraction> interactions;
+    std::size_t nextInteraction = 0;
+    double speed = 1.0;
+    bool skipIdle = false;
+    // Пропущенные паузы сдвигают расписание оставшихся действий (мс записи)
+    qint64 skippedTime = 0;
+    QElapsedTimer clock;
+    ReplayStatistics stats;
+    bool running = false;
+};
+
+#endif
@@ -0,0 +1,16 @@
+TEMPLATE = app
+TARGET = InteractionReplay
+
+QT += core gui widgets
+
+CONFIG += console c++17
+CONFIG -= app_bundle
+
+include(../../ProjectPendulums.pri)
+
+SOURCES += \
+    InteractionPlayer.cpp \
+    main.cpp
+
+HEADERS += \
+    InteractionPlayer.h
@@ -0,0 +1,104 @@
+// Воспроизведение записанного сеанса (ProjectPendulums --record FILE) без
+// экрана, на платформе offscreen: нагрузочный прогон всего пути GUI —
+// ввода, меню, окон сообщений и анимации — со статистикой кадров и памяти.
+
+#include "InteractionPlayer.h"
+#include "mainwindow.h"
+
+#include <QApplication>
+#include <QCommandLineParser>
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+
+static double percentile(const std::vector<double> &sorted, double fraction)
+{
+    if (sorted.empty()) {
+        return 0.0;
+    }
+    std::size_t index = static_cast<std::size_t>(fraction * (sorted.size() - 1) + 0.5);
+    return sorted[std::min(index, sorted.size() - 1)];
+}
+
+static void printStatistics(const ReplayStatistics &stats)
+{
+    std::printf("interactions:   %d dispatched, %d skipped\n", stats.dispatched, stats.skipped);
+    std::printf("dialogs:        %d message boxes, %d input dialogs\n", stats.messageBoxes, stats.inputDialogs);
+    std::printf("wall time:      %.3f s\n", stats.wallSeconds);
+
+    std::vector<double> intervals = stats.frameIntervals;
+    std::sort(intervals.begin(), intervals.end());
+    if (intervals.empty()) {
+        std::printf("frames:         none\n");
+    } else {
+        double sum = 0.0;
+        for (double interval : intervals) {
+            sum += interval;
+        }
+        std::printf("frames:         %zu\n", intervals.size());
+        std::printf("frame time ms:  mean %.3f  p50 %.3f  p95 %.3f  p99 %.3f  max %.3f\n",
+                    1e3 * sum / intervals.size(), 1e3 * percentile(intervals, 0.50),
+                    1e3 * percentile(intervals, 0.95), 1e3 * percentile(intervals, 0.99),
+                    1e3 * intervals.back());
+    }
+
+    if (stats.peakResidentKiB > 0) {
+        std::printf("memory KiB:     final RSS %lld  peak RSS %lld\n", stats.finalResidentKiB, stats.peakResidentKiB);
+    } else {
+        std::printf("memory KiB:     n/a\n");
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    // Без экрана, если платформа не задана явно
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+
+    QApplication app(argc, argv);
+    app.setQuitOnLastWindowClosed(false);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Replays a recorded pendulum session and reports frame-time and memory statistics.");
+    parser.addHelpOption();
+    parser.addPositionalArgument("file", "Session recorded with ProjectPendulums --record.");
+    QCommandLineOption speedOption("speed", "Replay <factor> times faster than recorded.", "factor", "1");
+    parser.addOption(speedOption);
+    QCommandLineOption skipIdleOption("skip-idle", "Do not wait out pauses while no window is animating.");
+    parser.addOption(skipIdleOption);
+    parser.process(app);
+
+    if (parser.positionalArguments().size() != 1) {
+        parser.showHelp(1);
+    }
+    bool ok;
+    double speed = parser.value(speedOption).toDouble(&ok);
+    if (!ok || speed <= 0.0) {
+        std::fprintf(stderr, "Invalid speed: %s\n", qPrintable(parser.value(speedOption)));
+        return 1;
+    }
+
+    InteractionPlayer player;
+    QString error;
+    if (!player.load(parser.positionalArguments().first(), error)) {
+        std::fprintf(stderr, "Cannot load session: %s\n", qPrintable(error));
+        return 1;
+    }
+
+    MainWindow window;
+    window.show();
+
+    QObject::connect(&player, &InteractionPlayer::finished, &app, &QApplication::quit);
+    player.start(speed, parser.isSet(skipIdleOption));
+    app.exec();
+
+    printStatistics(player.statistics());
+    // Без кадров статистика ничего не говорит о производительности
+    if (player.statistics().frameIntervals.empty()) {
+        std::fprintf(stderr, "warning: no frames were collected; the session never kept an animation running "
+                             "(record one that starts a pendulum, or lower --speed)\n");
+    }
+    // Пропущенное действие значит, что интерфейс разошелся с записью
+    return player.statistics().skipped > 0 ? 1 : 0;
+}
@@ -0,0 +1,17 @@
+TEMPLATE = app
+TARGET = ParameterFit
+
+CONFIG += console c++17 thread
+CONFIG -= app_bundle qt
+
+INCLUDEPATH += ../..
+
+SOURCES += \
+    ../../ParameterFit.cpp \
+    main.cpp
+
+HEADERS += \
+    ../../DampingModels.h \
+    ../../DualNumber.h \
+    ../../ParameterFit.h \
+    ../../PendulumPhysics.h
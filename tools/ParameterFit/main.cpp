@@ -0,0 +1,77 @@
+// Подбор длины, затухания и жесткости по записанной траектории.
+
+#include "ParameterFit.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+static void printUsage(const char *program)
+{
+    std::printf("Usage: %s --model math|spring [--mass KG] [--step S] [--iterations N]\n"
+                "          [--threads N] recording.csv\n"
+                "Math recordings hold (t, angle in degrees), spring recordings hold\n"
+                "(t, displacement from equilibrium in metres).\n", program);
+}
+
+int main(int argc, char *argv[])
+{
+    FitOptions options;
+    const char *path = nullptr;
+    bool modelSet = false;
+
+    for (int i = 1; i < argc; ++i) {
+        const char *arg = argv[i];
+        if (arg[0] != '-') {
+            path = arg;
+            continue;
+        }
+        if (i + 1 >= argc) {
+            printUsage(argv[0]);
+            return 1;
+        }
+        const char *value = argv[++i];
+        if (std::strcmp(arg, "--model") == 0) {
+            if (std::strcmp(value, "math") == 0) options.model = FitModel::Math;
+            else if (std::strcmp(value, "spring") == 0) options.model = FitModel::Spring;
+            else {
+                printUsage(argv[0]);
+                return 1;
+            }
+            modelSet = true;
+        }
+        else if (std::strcmp(arg, "--mass") == 0) options.mass = std::atof(value);
+        else if (std::strcmp(arg, "--step") == 0) options.maxStep = std::atof(value);
+        else if (std::strcmp(arg, "--iterations") == 0) options.maxIterations = std::atoi(value);
+        else if (std::strcmp(arg, "--threads") == 0) options.threads = std::atoi(value);
+        else {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (!path || !modelSet || options.mass <= 0 || options.maxStep <= 0 || options.maxIterations <= 0) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    Recording recording;
+    std::string error;
+    if (!loadRecording(path, recording, error)) {
+        std::fprintf(stderr, "Error: %s\n", error.c_str());
+        return 1;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    FitResult result = fitRecording(recording, options);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::printf("Samples: %zu, iterations: %d, time: %.3f s (%s)\n",
+                recording.time.size(), result.iterations, seconds, result.message.c_str());
+    std::printf("Residual RMS: %.6e\n", result.residualRms);
+    for (const FitParameter &parameter : result.parameters) {
+        std::printf("%-24s %16.8g +/- %.3g\n", parameter.name.c_str(), parameter.value, parameter.uncertainty);
+    }
+    return result.converged ? 0 : 2;
+}
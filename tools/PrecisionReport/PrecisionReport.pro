@@ -0,0 +1,14 @@
+TEMPLATE = app
+TARGET = PrecisionReport
+
+CONFIG += console c++17
+CONFIG -= app_bundle qt
+
+INCLUDEPATH += ../..
+
+SOURCES += \
+    main.cpp
+
+HEADERS += \
+    ../../DampingModels.h \
+    ../../PendulumPhysics.h
@@ -0,0 +1,286 @@
+// Отчет об ошибке округления для каждой политики точности.
+// Все варианты интегрируются одним и тем же методом с одним и тем же шагом,
+// поэтому отличие от эталона (long double + Кэхэн) — это чистая ошибка
+// арифметики, а не ошибка метода.
+
+#include "PendulumPhysics.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+struct Options {
+    long steps = 1000000;
+    double dt = SIMULATION_STEP;
+    double angle = 30.0;
+    double length = 10.0;
+    double position = 1.0;
+    double mass = 1.0;
+    double springConstant = 10.0;
+    bool friction = false;
+    double tolerance = 1e-6;
+    int ensembleSize = 4096;
+};
+
+struct ErrorReport {
+    const char *name = "";
+    double maxError = 0.0;
+    double finalError = 0.0;
+    double nsPerStep = 0.0;
+};
+
+// Коэффициенты линейного сопротивления, как в приложении
+const double MATH_FRICTION_COEFF = 0.02;
+const double SPRING_FRICTION_COEFF = 0.1;
+
+// Вызов function(kernel) с ядром без сопротивления или с линейным
+// сопротивлением — выбор делается до цикла интегрирования
+template <typename Precision, typename Function>
+static void withMathKernel(const Options &options, Function &&function)
+{
+    using Scalar = typename Precision::Scalar;
+    auto run = [&](auto kernel) {
+        kernel.length = Scalar(options.length);
+        function(kernel);
+    };
+    if (options.friction) {
+        MathPendulumKernel<Precision, DampingModel<Scalar, LinearDrag>> kernel;
+        kernel.damping.template term<LinearDrag>().coeff = Scalar(MATH_FRICTION_COEFF);
+        run(kernel);
+    } else {
+        run(MathPendulumKernel<Precision>());
+    }
+}
+
+template <typename Precision, typename Function>
+static void withSpringKernel(const Options &options, Function &&function)
+{
+    using Scalar = typename Precision::Scalar;
+    auto run = [&](auto kernel) {
+        kernel.mass = Scalar(options.mass);
+        kernel.springConstant = Scalar(options.springConstant);
+        function(kernel);
+    };
+    if (options.friction) {
+        SpringPendulumKernel<Precision, DampingModel<Scalar, LinearDrag>> kernel;
+        kernel.damping.template term<LinearDrag>().coeff = Scalar(SPRING_FRICTION_COEFF);
+        run(kernel);
+    } else {
+        run(SpringPendulumKernel<Precision>());
+    }
+}
+
+// Эталонная траектория хранится целиком, чтобы сравнивать на каждом шаге
+static std::vector<long double> referenceMathTrajectory(const Options &options)
+{
+    std::vector<long double> trajectory(options.steps);
+    withMathKernel<ReferencePrecision>(options, [&](const auto &kernel) {
+        MathPendulumState<ReferencePrecision> state;
+        state.angle = options.angle;
+
+        for (long i = 0; i < options.steps; ++i) {
+            kernel.step(state, options.dt);
+            trajectory[i] = state.angle;
+        }
+    });
+
+    return trajectory;
+}
+
+static std::vector<long double> referenceSpringTrajectory(const Options &options)
+{
+    std::vector<long double> trajectory(options.steps);
+    withSpringKernel<ReferencePrecision>(options, [&](const auto &kernel) {
+        SpringPendulumState<ReferencePrecision> state;
+        state.position = options.position;
+
+        for (long i = 0; i < options.steps; ++i) {
+            kernel.step(state, options.dt);
+            trajectory[i] = state.position;
+        }
+    });
+
+    return trajectory;
+}
+
+template <typename Precision>
+static ErrorReport measureMath(const Options &options, const std::vector<long double> &reference)
+{
+    using Scalar = typename Precision::Scalar;
+    ErrorReport report;
+    report.name = Precision::name;
+    withMathKernel<Precision>(options, [&](const auto &kernel) {
+        MathPendulumState<Precision> state;
+        state.angle = Scalar(options.angle);
+
+        const Scalar dt = Scalar(options.dt);
+        auto start = std::chrono::steady_clock::now();
+        for (long i = 0; i < options.steps; ++i) {
+            kernel.step(state, dt);
+            long double error = static_cast<long double>(Scalar(state.angle)) - reference[i];
+            double absError = static_cast<double>(error < 0 ? -error : error);
+            if (absError > report.maxError) report.maxError = absError;
+            report.finalError = absError;
+        }
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        report.nsPerStep = std::chrono::duration<double, std::nano>(elapsed).count() / options.steps;
+    });
+
+    return report;
+}
+
+template <typename Precision>
+static ErrorReport measureSpring(const Options &options, const std::vector<long double> &reference)
+{
+    using Scalar = typename Precision::Scalar;
+    ErrorReport report;
+    report.name = Precision::name;
+    withSpringKernel<Precision>(options, [&](const auto &kernel) {
+        SpringPendulumState<Precision> state;
+        state.position = Scalar(options.position);
+
+        const Scalar dt = Scalar(options.dt);
+        auto start = std::chrono::steady_clock::now();
+        for (long i = 0; i < options.steps; ++i) {
+            kernel.step(state, dt);
+            long double error = static_cast<long double>(Scalar(state.position)) - reference[i];
+            double absError = static_cast<double>(error < 0 ? -error : error);
+            if (absError > report.maxError) report.maxError = absError;
+            report.finalError = absError;
+        }
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        report.nsPerStep = std::chrono::duration<double, std::nano>(elapsed).count() / options.steps;
+    });
+
+    return report;
+}
+
+// Пропускная способность ансамблевого ядра (маятников-шагов в секунду)
+template <typename Precision>
+static double measureEnsembleThroughput(const Options &options)
+{
+    using Scalar = typename Precision::Scalar;
+    const long ensembleSteps = 1000;
+    double seconds = 0.0;
+    withMathKernel<Precision>(options, [&](const auto &kernel) {
+        std::vector<Scalar> angles(options.ensembleSize);
+        std::vector<Scalar> velocities(options.ensembleSize, Scalar(0));
+        for (int i = 0; i < options.ensembleSize; ++i) {
+            angles[i] = Scalar(options.angle * (i + 1) / options.ensembleSize);
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        for (long i = 0; i < ensembleSteps; ++i) {
+            stepMathPendulumEnsemble(kernel, angles.data(), velocities.data(),
+                                     angles.size(), Scalar(options.dt));
+        }
+        auto elapsed = std::chrono::steady_clock::now() - start;
+
+        // Не даем компилятору выбросить вычисления
+        volatile Scalar sink = angles[options.ensembleSize / 2];
+        (void)sink;
+
+        seconds = std::chrono::duration<double>(elapsed).count();
+    });
+
+    return ensembleSteps * static_cast<double>(options.ensembleSize) / seconds;
+}
+
+static void printTable(const char *title, const std::vector<ErrorReport> &reports, double tolerance)
+{
+    std::printf("\n%s\n", title);
+    std::printf("%-22s %16s %16s %12s\n", "precision", "max error", "final error", "ns/step");
+    const ErrorReport *cheapest = nullptr;
+    for (const ErrorReport &report : reports) {
+        std::printf("%-22s %16.6e %16.6e %12.2f\n",
+                    report.name, report.maxError, report.finalError, report.nsPerStep);
+        if (!cheapest && report.maxError <= tolerance) {
+            cheapest = &report;
+        }
+    }
+    if (cheapest) {
+        std::printf("Cheapest precision within tolerance %g: %s\n", tolerance, cheapest->name);
+    } else {
+        std::printf("No precision meets tolerance %g\n", tolerance);
+    }
+}
+
+static void printUsage(const char *program)
+{
+    std::printf("Usage: %s [--steps N] [--dt S] [--angle DEG] [--length M] [--position M]\n"
+                "          [--mass KG] [--spring N/M] [--friction] [--tolerance T] [--ensemble N]\n",
+                program);
+}
+
+static bool parseOptions(int argc, char *argv[], Options &options)
+{
+    for (int i = 1; i < argc; ++i) {
+        const char *arg = argv[i];
+        const char *value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+
+        if (std::strcmp(arg, "--friction") == 0) {
+            options.friction = true;
+            continue;
+        }
+        if (!value) {
+            return false;
+        }
+
+        if (std::strcmp(arg, "--steps") == 0) options.steps = std::atol(value);
+        else if (std::strcmp(arg, "--dt") == 0) options.dt = std::atof(value);
+        else if (std::strcmp(arg, "--angle") == 0) options.angle = std::atof(value);
+        else if (std::strcmp(arg, "--length") == 0) options.length = std::atof(value);
+        else if (std::strcmp(arg, "--position") == 0) options.position = std::atof(value);
+        else if (std::strcmp(arg, "--mass") == 0) options.mass = std::atof(value);
+        else if (std::strcmp(arg, "--spring") == 0) options.springConstant = std::atof(value);
+        else if (std::strcmp(arg, "--tolerance") == 0) options.tolerance = std::atof(value);
+        else if (std::strcmp(arg, "--ensemble") == 0) options.ensembleSize = std::atoi(value);
+        else return false;
+        ++i;
+    }
+    return options.steps > 0 && options.dt > 0 && options.length > 0 &&
+           options.mass > 0 && options.springConstant > 0 && options.ensembleSize > 0;
+}
+
+int main(int argc, char *argv[])
+{
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    std::printf("Steps: %ld, dt: %g s, simulated time: %g s, friction: %s\n",
+                options.steps, options.dt, options.steps * options.dt,
+                options.friction ? "on" : "off");
+
+    // Варианты перечислены в порядке возрастания стоимости
+    std::vector<long double> mathReference = referenceMathTrajectory(options);
+    printTable("Mathematical pendulum, angle error [deg]", {
+        measureMath<FloatPrecision>(options, mathReference),
+        measureMath<KahanFloatPrecision>(options, mathReference),
+        measureMath<DoublePrecision>(options, mathReference),
+        measureMath<KahanDoublePrecision>(options, mathReference),
+        measureMath<LongDoublePrecision>(options, mathReference),
+    }, options.tolerance);
+
+    std::vector<long double> springReference = referenceSpringTrajectory(options);
+    printTable("Spring pendulum, position error [m]", {
+        measureSpring<FloatPrecision>(options, springReference),
+        measureSpring<KahanFloatPrecision>(options, springReference),
+        measureSpring<DoublePrecision>(options, springReference),
+        measureSpring<KahanDoublePrecision>(options, springReference),
+        measureSpring<LongDoublePrecision>(options, springReference),
+    }, options.tolerance);
+
+    std::printf("\nEnsemble kernel throughput (%d pendulums)\n", options.ensembleSize);
+    std::printf("%-22s %16.3e pendulum-steps/s\n", FloatPrecision::name,
+                measureEnsembleThroughput<FloatPrecision>(options));
+    std::printf("%-22s %16.3e pendulum-steps/s\n", DoublePrecision::name,
+                measureEnsembleThroughput<DoublePrecision>(options));
+    std::printf("%-22s %16.3e pendulum-steps/s\n", LongDoublePrecision::name,
+                measureEnsembleThroughput<LongDoublePrecision>(options));
+    return 0;
+}
@@ -0,0 +1,17 @@
+TEMPLATE = app
+TARGET = Sensitivity
+
+CONFIG += console c++17
+CONFIG -= app_bundle qt
+
+INCLUDEPATH += ../..
+
+SOURCES += \
+    ../../SensitivityAnalysis.cpp \
+    main.cpp
+
+HEADERS += \
+    ../../DampingModels.h \
+    ../../DualNumber.h \
+    ../../PendulumPhysics.h \
+    ../../SensitivityAnalysis.h
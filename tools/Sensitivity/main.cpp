@@ -0,0 +1,87 @@
+// Чувствительности периода, затухания и конечного состояния к параметрам
+// маятника за один прогон интегратора в дуальных числах.
+
+#include "SensitivityAnalysis.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+static void printRow(const char *name, const SensitivityScalar &quantity, bool valid = true)
+{
+    if (!valid) {
+        std::printf("%-16s %14s\n", name, "n/a");
+        return;
+    }
+    std::printf("%-16s %14.6e", name, quantity.value);
+    for (int i = 0; i < SENS_PARAMETER_COUNT; ++i) {
+        std::printf(" %22.6e", quantity.grad[i]);
+    }
+    std::printf("\n");
+}
+
+static void printResult(const char *title, const SensitivityResult &result)
+{
+    std::printf("\n%s (derivatives by column)\n%-16s %14s", title, "quantity", "value");
+    for (int i = 0; i < SENS_PARAMETER_COUNT; ++i) {
+        std::printf(" %22s", sensitivityParameterName(i));
+    }
+    std::printf("\n");
+    printRow("final coordinate", result.finalCoordinate);
+    printRow("final velocity", result.finalVelocity);
+    printRow("final energy", result.finalEnergy);
+    printRow("period", result.period, result.periodValid);
+    printRow("amplitude decay", result.amplitudeDecay, result.decayValid);
+}
+
+static void printUsage(const char *program)
+{
+    std::printf("Usage: %s [--length M] [--angle DEG] [--mass KG] [--spring N/M] [--position M]\n"
+                "          [--friction] [--math-friction C] [--spring-friction C]\n"
+                "          [--duration S] [--dt S]\n", program);
+}
+
+int main(int argc, char *argv[])
+{
+    MathSensitivityInput math;
+    SpringSensitivityInput spring;
+
+    for (int i = 1; i < argc; ++i) {
+        const char *arg = argv[i];
+        if (std::strcmp(arg, "--friction") == 0) {
+            math.airFrictionEnabled = true;
+            spring.airFrictionEnabled = true;
+            continue;
+        }
+        if (i + 1 >= argc) {
+            printUsage(argv[0]);
+            return 1;
+        }
+        double value = std::atof(argv[++i]);
+        if (std::strcmp(arg, "--length") == 0) math.lengthForCalculations = value;
+        else if (std::strcmp(arg, "--angle") == 0) math.angle = value;
+        else if (std::strcmp(arg, "--mass") == 0) math.mass = spring.mass = value;
+        else if (std::strcmp(arg, "--spring") == 0) spring.springConstant = value;
+        else if (std::strcmp(arg, "--position") == 0) spring.position = value;
+        else if (std::strcmp(arg, "--math-friction") == 0) math.airFrictionCoeff = value;
+        else if (std::strcmp(arg, "--spring-friction") == 0) spring.airFrictionCoeff = value;
+        else if (std::strcmp(arg, "--duration") == 0) math.duration = spring.duration = value;
+        else if (std::strcmp(arg, "--dt") == 0) math.dt = spring.dt = value;
+        else {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (math.lengthForCalculations <= 0 || math.mass <= 0 || spring.springConstant <= 0 ||
+        math.dt <= 0 || math.duration <= 0) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    std::printf("Duration: %g s, dt: %g s, air friction: %s\n", math.duration, math.dt,
+                math.airFrictionEnabled ? "on" : "off (derivatives taken at zero friction)");
+    printResult("Mathematical pendulum (angle in degrees)", analyzeMathPendulum(math));
+    printResult("Spring pendulum (position in metres)", analyzeSpringPendulum(spring));
+    return 0;
+}
@@ -0,0 +1,272 @@
+#include "SweepCoordinator.h"
+#include "SweepTable.h"
+#include "ResultCache.h"
+#include <QCoreApplication>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+SweepCoordinator::SweepCoordinator(SweepTable &table, const QString &tableFile, QObject *parent) :
+    QObject(parent), table(table), tableFile(tableFile)
+{
+}
+
+void SweepCoordinator::setJobs(int jobs)
+{
+    this->jobs = std::max(1, jobs);
+}
+
+void SweepCoordinator::setNumaNodes(int nodes)
+{
+    numaNodes = nodes;
+}
+
+void SweepCoordinator::setCacheEnabled(bool enabled)
+{
+    cacheEnabled = enabled;
+}
+
+// Очередь — все неготовые шарды, которых нет в кэше; рабочих не больше,
+// чем шардов
+void SweepCoordinator::start()
+{
+    const SweepSpec spec = table.spec();
+    cacheStores = cacheEnabled &&
+                  spec.pointCount() * static_cast<qint64>(sizeof(SweepResult)) <= ResultCache::instance().capacityBytes();
+
+    pending.clear();
+    qint64 cachedShards = 0;
+    for (qint64 shard = 0; shard < table.shardCount(); ++shard) {
+        if (table.shardState(shard) == SweepTable::ShardDone) {
+            continue;
+        }
+        if (cacheEnabled && loadCachedShard(shard)) {
+            table.setShardState(shard, SweepTable::ShardDone);
+            ++cachedShards;
+        } else {
+            pending.push_back(shard);
+        }
+    }
+    if (cachedShards > 0) {
+        std::printf("%lld shards taken from the result cache\n", cachedShards);
+    }
+    shardsAtStart = table.completedShards();
+    clock.start();
+    printProgress(true);
+
+    if (pending.empty()) {
+        finish(true);
+        return;
+    }
+    workers.resize(std::min<std::size_t>(jobs, pending.size()));
+    for (int slot = 0; slot < static_cast<int>(workers.size()); ++slot) {
+        launchWorker(slot);
+    }
+}
+
+void SweepCoordinator::launchWorker(int slot)
+{
+    Worker &worker = workers[slot];
+    worker.process = new QProcess(this);
+    worker.shard = -1;
+    worker.output.clear();
+    worker.process->setProcessChannelMode(QProcess::ForwardedErrorChannel);
+    connect(worker.process, &QProcess::readyReadStandardOutput, this, [this, slot]() {
+        readWorkerOutput(slot);
+    });
+    connect(worker.process, qOverload<int, QProcess::ExitStatus>(&QProcess::finished), this, [this, slot]() {
+        workerFinished(slot);
+    });
+    // Незапустившийся процесс не присылает finished; обработка
+    // откладывается, чтобы шард успел попасть в рабочего и был учтен
+    connect(worker.process, &QProcess::errorOccurred, this, [this, slot](QProcess::ProcessError error) {
+        if (error == QProcess::FailedToStart) {
+            workerFinished(slot);
+        }
+    }, Qt::QueuedConnection);
+
+    const QString program = QCoreApplication::applicationFilePath();
+    const QStringList workerArguments = {"--worker", tableFile};
+    if (numaNodes > 0) {
+        int node = slot % numaNodes;
+        worker.process->start("numactl", QStringList{QString("--cpunodebind=%1").arg(node),
+                                                     QString("--membind=%1").arg(node), program}
+                                             + workerArguments);
+    } else {
+        worker.process->start(program, workerArguments);
+    }
+    assignShard(slot);
+}
+
+// Шард передается строкой в stdin; пустая очередь закрывает stdin, и
+// рабочий завершается
+void SweepCoordinator::assignShard(int slot)
+{
+    Worker &worker = workers[slot];
+    if (pending.empty() || stopping) {
+        worker.shard = -1;
+        worker.process->closeWriteChannel();
+        return;
+    }
+    worker.shard = pending.front();
+    pending.pop_front();
+    worker.process->write(QByteArray::number(worker.shard) + '\n');
+}
+
+// Рабочий отвечает строкой «done N» после того, как записал шард N
+void SweepCoordinator::readWorkerOutput(int slot)
+{
+    Worker &worker = workers[slot];
+    worker.output += worker.process->readAllStandardOutput();
+    int newline;
+    while ((newline = worker.output.indexOf('\n')) >= 0) {
+        const QByteArray line = worker.output.left(newline).trimmed();
+        worker.output.remove(0, newline + 1);
+
+        const QList<QByteArray> fields = line.split(' ');
+        bool ok = false;
+        qint64 shard = fields.size() == 2 && fields[0] == "done" ? fields[1].toLongLong(&ok) : -1;
+        if (!ok || shard != worker.shard) {
+            std::fprintf(stderr, "worker %d: unexpected output '%s'\n", slot, line.constData());
+            continue;
+        }
+        if (cacheStores) {
+            storeCachedShard(shard);
+        }
+        table.setShardState(shard, SweepTable::ShardDone);
+        printProgress(false);
+        assignShard(slot);
+    }
+}
+
+// Незавершенный шард возвращается в начало очереди, процесс перезапускается
+void SweepCoordinator::workerFinished(int slot)
+{
+    Worker &worker = workers[slot];
+    QProcess *process = worker.process;
+    if (!process) {
+        return;
+    }
+    worker.process = nullptr;
+    process->deleteLater();
+
+    if (worker.shard >= 0 && !stopping) {
+        qint64 shard = worker.shard;
+        worker.shard = -1;
+        int count = ++failures[shard];
+        std::fprintf(stderr, "worker %d failed on shard %lld (%s, exit code %d)\n", slot, shard,
+                     qPrintable(process->errorString()), process->exitCode());
+        if (count >= MAX_SHARD_FAILURES) {
+            std::fprintf(stderr, "shard %lld failed %d times, stopping\n", shard, count);
+            finish(false);
+            return;
+        }
+        pending.push_front(shard);
+    }
+
+    if (!pending.empty() && !stopping) {
+        launchWorker(slot);
+        return;
+    }
+    for (const Worker &other : workers) {
+        if (other.process) {
+            return;
+        }
+    }
+    if (!stopping) {
+        finish(table.completedShards() == table.shardCount());
+    }
+}
+
+// Ключ шарда: сетка, диапазон точек, версия физического кода
+// (PHYSICS_CODE_VERSION) и отпечаток кода расчета — хэш эталонных точек
+// обеих моделей с сопротивлением. Изменение интегратора или обработки
+// траектории меняет отпечаток, и старые шарды не находятся; ветви ядер,
+// которых эталоны не касаются, покрывает версия.
+static QByteArray shardKey(const SweepSpec &spec, qint64 begin, qint64 length)
+{
+    static const QByteArray fingerprint = [] {
+        ResultKey key("sweep-code");
+        for (SweepModel model : {SweepModel::Math, SweepModel::Spring}) {
+            SweepSpec reference;
+            reference.model = model;
+            reference.axes[0] = model == SweepModel::Math ? SweepAxis{2.0, 2.0, 1} : SweepAxis{10.0, 10.0, 1};
+            reference.axes[1] = model == SweepModel::Math ? SweepAxis{45.0, 45.0, 1} : SweepAxis{0.5, 0.5, 1};
+            reference.airFrictionCoeff = 0.05;
+            reference.duration = 10.0;
+            SweepResult result = evaluateSweepPoint(reference, 0);
+            key.add(result.finalCoordinate).add(result.finalVelocity).add(result.period).add(result.energyDrift);
+        }
+        return key.hex();
+    }();
+
+    ResultKey key("sweep-shard");
+    key.add(static_cast<qint64>(spec.model));
+    for (const SweepAxis &axis : spec.axes) {
+        key.add(axis.minimum).add(axis.maximum).add(static_cast<qint64>(axis.count));
+    }
+    key.add(spec.mass).add(spec.airFrictionCoeff).add(spec.duration).add(spec.dt);
+    return key.add(begin).add(length).add(PHYSICS_CODE_VERSION).add(fingerprint).hex();
+}
+
+bool SweepCoordinator::loadCachedShard(qint64 shard)
+{
+    const qint64 length = table.shardLength(shard);
+    QByteArray data;
+    if (!ResultCache::instance().lookup(shardKey(table.spec(), table.shardBegin(shard), length), data) ||
+        data.size() != length * static_cast<qint64>(sizeof(SweepResult))) {
+        return false;
+    }
+    SweepResult *results = table.mapShard(shard);
+    if (!results) {
+        return false;
+    }
+    std::memcpy(results, data.constData(), data.size());
+    table.unmapShard(results);
+    return true;
+}
+
+void SweepCoordinator::storeCachedShard(qint64 shard)
+{
+    const qint64 length = table.shardLength(shard);
+    SweepResult *results = table.mapShard(shard);
+    if (!results) {
+        return;
+    }
+    QByteArray data(reinterpret_cast<const char *>(results), length * static_cast<qint64>(sizeof(SweepResult)));
+    table.unmapShard(results);
+    ResultCache::instance().store(shardKey(table.spec(), table.shardBegin(shard), length), data);
+}
+
+void SweepCoordinator::printProgress(bool force)
+{
+    qint64 elapsed = clock.elapsed();
+    if (!force && elapsed - lastProgress < PROGRESS_INTERVAL_MS) {
+        return;
+    }
+    lastProgress = elapsed;
+
+    qint64 done = table.completedShards();
+    qint64 total = table.shardCount();
+    double rate = elapsed > 0 ? (done - shardsAtStart) * 1000.0 / elapsed : 0.0;
+    std::printf("shards %lld/%lld (%.1f%%)", done, total, total > 0 ? 100.0 * done / total : 100.0);
+    if (rate > 0.0) {
+        std::printf(", %.2f shards/s, eta %.0f s", rate, (total - done) / rate);
+    }
+    std::printf("\n");
+    std::fflush(stdout);
+}
+
+// При ошибке остальные рабочие останавливаются; готовые шарды остаются
+// отмеченными и при --resume не пересчитываются
+void SweepCoordinator::finish(bool success)
+{
+    stopping = true;
+    for (Worker &worker : workers) {
+        if (worker.process) {
+            worker.process->kill();
+        }
+    }
+    printProgress(true);
+    emit finished(success);
+}
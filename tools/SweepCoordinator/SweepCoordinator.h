@@ -0,0 +1,73 @@
+#ifndef SWEEPCOORDINATOR_H
+#define SWEEPCOORDINATOR_H
+
+#include <QObject>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QProcess>
+#include <deque>
+#include <vector>
+
+class SweepTable;
+
+// Раздача шардов рабочим процессам. Каждый рабочий — отдельный процесс
+// той же программы (--worker), так что падение одного не теряет ничего,
+// кроме его текущего шарда: шард возвращается в очередь, процесс
+// перезапускается. Шард считается готовым, только когда рабочий сообщил
+// о нем, поэтому убитый перебор продолжается с того же места.
+class SweepCoordinator : public QObject
+{
+    Q_OBJECT
+
+public:
+    SweepCoordinator(SweepTable &table, const QString &tableFile, QObject *parent = nullptr);
+
+    void setJobs(int jobs);
+    // Привязка рабочих к узлам NUMA по кругу через numactl; 0 — без привязки
+    void setNumaNodes(int nodes);
+    // Готовые шарды берутся из ResultCache и сохраняются в него
+    void setCacheEnabled(bool enabled);
+    void start();
+
+signals:
+    void finished(bool success);
+
+private:
+    struct Worker {
+        QProcess *process = nullptr;
+        qint64 shard = -1;
+        QByteArray output;
+    };
+
+    void launchWorker(int slot);
+    void assignShard(int slot);
+    void readWorkerOutput(int slot);
+    void workerFinished(int slot);
+    bool loadCachedShard(qint64 shard);
+    void storeCachedShard(qint64 shard);
+    void printProgress(bool force);
+    void finish(bool success);
+
+    SweepTable &table;
+    QString tableFile;
+    int jobs = 1;
+    int numaNodes = 0;
+    bool cacheEnabled = true;
+    // Перебор, который целиком не помещается в кэш, туда не пишется —
+    // его шарды только вытесняли бы друг друга
+    bool cacheStores = false;
+    std::vector<Worker> workers;
+    std::deque<qint64> pending;
+    // Число падений рабочих на каждом шарде
+    QHash<qint64, int> failures;
+    qint64 shardsAtStart = 0;
+    QElapsedTimer clock;
+    qint64 lastProgress = 0;
+    bool stopping = false;
+
+    // После стольких падений на одном шарде перебор прекращается
+    static constexpr int MAX_SHARD_FAILURES = 3;
+    static constexpr int PROGRESS_INTERVAL_MS = 1000;
+};
+
+#endif
@@ -0,0 +1,24 @@
+TEMPLATE = app
+TARGET = SweepCoordinator
+
+QT = core
+
+CONFIG += console c++17
+CONFIG -= app_bundle
+
+INCLUDEPATH += ../..
+
+SOURCES += \
+    ../../ParameterSweep.cpp \
+    ../../ResultCache.cpp \
+    SweepCoordinator.cpp \
+    SweepTable.cpp \
+    main.cpp
+
+HEADERS += \
+    ../../DampingModels.h \
+    ../../ParameterSweep.h \
+    ../../PendulumPhysics.h \
+    ../../ResultCache.h \
+    SweepCoordinator.h \
+    SweepTable.h
@@ -0,0 +1,157 @@
+#include "SweepTable.h"
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
+
+static_assert(std::is_trivially_copyable<SweepTableHeader>::value, "Header is stored as raw bytes");
+static_assert(std::is_trivially_copyable<SweepResult>::value, "Results are stored as raw bytes");
+
+static const char SWEEP_MAGIC[8] = {'P', 'S', 'W', 'E', 'E', 'P', '\0', '\0'};
+static const quint32 SWEEP_VERSION = 1;
+// Результаты начинаются с границы страницы
+static const qint64 RESULTS_ALIGNMENT = 4096;
+
+SweepTable::~SweepTable()
+{
+    if (headerMemory) {
+        file.unmap(headerMemory);
+    }
+}
+
+bool SweepTable::create(const QString &fileName, const SweepSpec &spec, qint64 shardSize, QString &error)
+{
+    SweepTableHeader initial;
+    std::memset(&initial, 0, sizeof(initial));
+    std::memcpy(initial.magic, SWEEP_MAGIC, sizeof(initial.magic));
+    initial.version = SWEEP_VERSION;
+    initial.model = static_cast<quint32>(spec.model);
+    for (int axis = 0; axis < 2; ++axis) {
+        initial.axisMinimum[axis] = spec.axes[axis].minimum;
+        initial.axisMaximum[axis] = spec.axes[axis].maximum;
+        initial.axisCount[axis] = spec.axes[axis].count;
+    }
+    initial.mass = spec.mass;
+    initial.airFrictionCoeff = spec.airFrictionCoeff;
+    initial.duration = spec.duration;
+    initial.dt = spec.dt;
+    initial.shardSize = shardSize;
+    initial.shardCount = (spec.pointCount() + shardSize - 1) / shardSize;
+    qint64 statesEnd = sizeof(SweepTableHeader) + initial.shardCount;
+    initial.resultsOffset = (statesEnd + RESULTS_ALIGNMENT - 1) / RESULTS_ALIGNMENT * RESULTS_ALIGNMENT;
+
+    file.setFileName(fileName);
+    if (!file.open(QIODevice::ReadWrite | QIODevice::Truncate)) {
+        error = file.errorString();
+        return false;
+    }
+    // Файл разреженный: место занимают только посчитанные шарды
+    qint64 size = initial.resultsOffset + spec.pointCount() * static_cast<qint64>(sizeof(SweepResult));
+    if (!file.resize(size) ||
+        file.write(reinterpret_cast<const char *>(&initial), sizeof(initial)) != sizeof(initial) ||
+        !file.flush()) {
+        error = file.errorString();
+        return false;
+    }
+    return mapHeader(error);
+}
+
+bool SweepTable::open(const QString &fileName, QString &error)
+{
+    file.setFileName(fileName);
+    if (!file.open(QIODevice::ReadWrite)) {
+        error = file.errorString();
+        return false;
+    }
+
+    SweepTableHeader stored;
+    if (file.read(reinterpret_cast<char *>(&stored), sizeof(stored)) != sizeof(stored) ||
+        std::memcmp(stored.magic, SWEEP_MAGIC, sizeof(stored.magic)) != 0) {
+        error = "not a sweep table";
+        return false;
+    }
+    if (stored.version != SWEEP_VERSION) {
+        error = QString("unsupported sweep table version %1").arg(stored.version);
+        return false;
+    }
+    qint64 points = stored.axisCount[0] * stored.axisCount[1];
+    if (file.size() < stored.resultsOffset + points * static_cast<qint64>(sizeof(SweepResult))) {
+        error = "sweep table is truncated";
+        return false;
+    }
+    return mapHeader(error);
+}
+
+// Заголовок и состояние шардов отображаются целиком и меняются на месте
+bool SweepTable::mapHeader(QString &error)
+{
+    SweepTableHeader stored;
+    file.seek(0);
+    file.read(reinterpret_cast<char *>(&stored), sizeof(stored));
+    headerMemory = file.map(0, stored.resultsOffset);
+    if (!headerMemory) {
+        error = file.errorString();
+        return false;
+    }
+    header = reinterpret_cast<SweepTableHeader *>(headerMemory);
+    shardStates = headerMemory + sizeof(SweepTableHeader);
+    return true;
+}
+
+SweepSpec SweepTable::spec() const
+{
+    SweepSpec spec;
+    spec.model = static_cast<SweepModel>(header->model);
+    for (int axis = 0; axis < 2; ++axis) {
+        spec.axes[axis].minimum = header->axisMinimum[axis];
+        spec.axes[axis].maximum = header->axisMaximum[axis];
+        spec.axes[axis].count = header->axisCount[axis];
+    }
+    spec.mass = header->mass;
+    spec.airFrictionCoeff = header->airFrictionCoeff;
+    spec.duration = header->duration;
+    spec.dt = header->dt;
+    return spec;
+}
+
+qint64 SweepTable::shardCount() const
+{
+    return header->shardCount;
+}
+
+qint64 SweepTable::completedShards() const
+{
+    return std::count(shardStates, shardStates + header->shardCount, ShardDone);
+}
+
+qint64 SweepTable::shardBegin(qint64 shard) const
+{
+    return shard * header->shardSize;
+}
+
+qint64 SweepTable::shardLength(qint64 shard) const
+{
+    qint64 points = header->axisCount[0] * header->axisCount[1];
+    return std::min(header->shardSize, points - shardBegin(shard));
+}
+
+SweepTable::ShardState SweepTable::shardState(qint64 shard) const
+{
+    return static_cast<ShardState>(shardStates[shard]);
+}
+
+void SweepTable::setShardState(qint64 shard, ShardState state)
+{
+    shardStates[shard] = state;
+}
+
+SweepResult *SweepTable::mapShard(qint64 shard)
+{
+    qint64 offset = header->resultsOffset + shardBegin(shard) * static_cast<qint64>(sizeof(SweepResult));
+    uchar *memory = file.map(offset, shardLength(shard) * static_cast<qint64>(sizeof(SweepResult)));
+    return reinterpret_cast<SweepResult *>(memory);
+}
+
+void SweepTable::unmapShard(SweepResult *results)
+{
+    file.unmap(reinterpret_cast<uchar *>(results));
+}
@@ -0,0 +1,74 @@
+#ifndef SWEEPTABLE_H
+#define SWEEPTABLE_H
+
+#include <QFile>
+#include <QString>
+#include "ParameterSweep.h"
+
+// Файл результатов перебора, общий для координатора и рабочих процессов.
+//
+//   [заголовок][состояние шардов: по байту на шард][выравнивание]
+//   [SweepResult × число точек]
+//
+// Заголовок хранит сетку целиком, поэтому прерванный перебор
+// продолжается по одному имени файла. Шард — непрерывный диапазон точек;
+// рабочий процесс отображает в память только свой диапазон и пишет
+// результаты прямо в файл, координатор отмечает шард готовым после того,
+// как рабочий сообщил о завершении.
+struct SweepTableHeader {
+    char magic[8];
+    quint32 version;
+    quint32 model;
+    double axisMinimum[2];
+    double axisMaximum[2];
+    qint64 axisCount[2];
+    double mass;
+    double airFrictionCoeff;
+    double duration;
+    double dt;
+    qint64 shardSize;
+    qint64 shardCount;
+    qint64 resultsOffset;
+};
+
+class SweepTable
+{
+public:
+    enum ShardState : uchar {
+        ShardPending = 0,
+        ShardDone = 1
+    };
+
+    SweepTable() = default;
+    ~SweepTable();
+    SweepTable(const SweepTable &) = delete;
+    SweepTable &operator=(const SweepTable &) = delete;
+
+    // Новый файл (существующий перезаписывается) и открытие готового
+    bool create(const QString &fileName, const SweepSpec &spec, qint64 shardSize, QString &error);
+    bool open(const QString &fileName, QString &error);
+
+    SweepSpec spec() const;
+    qint64 shardCount() const;
+    qint64 completedShards() const;
+    // Первая точка шарда и число точек в нем (последний шард короче)
+    qint64 shardBegin(qint64 shard) const;
+    qint64 shardLength(qint64 shard) const;
+
+    ShardState shardState(qint64 shard) const;
+    void setShardState(qint64 shard, ShardState state);
+
+    // Результаты шарда, отображенные в память для записи или чтения
+    SweepResult *mapShard(qint64 shard);
+    void unmapShard(SweepResult *results);
+
+private:
+    bool mapHeader(QString &error);
+
+    QFile file;
+    uchar *headerMemory = nullptr;
+    SweepTableHeader *header = nullptr;
+    uchar *shardStates = nullptr;
+};
+
+#endif
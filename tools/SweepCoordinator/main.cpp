@@ -0,0 +1,240 @@
+// Перебор параметров маятника по большой сетке несколькими процессами.
+// Результаты пишутся в общий файл, отображенный в память; прерванный
+// перебор продолжается с --resume. Тот же исполняемый файл с --worker —
+// рабочий процесс, который считает шарды, присланные координатором.
+
+#include "SweepCoordinator.h"
+#include "SweepTable.h"
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QStandardPaths>
+#include <QThread>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+// Рабочий: номера шардов по одному в строке из stdin, ответ «done N»
+static int runWorker(const QString &fileName)
+{
+    SweepTable table;
+    QString error;
+    if (!table.open(fileName, error)) {
+        std::fprintf(stderr, "worker: cannot open %s: %s\n", qPrintable(fileName), qPrintable(error));
+        return 1;
+    }
+    const SweepSpec spec = table.spec();
+
+    char line[64];
+    while (std::fgets(line, sizeof(line), stdin)) {
+        qint64 shard = std::strtoll(line, nullptr, 10);
+        if (shard < 0 || shard >= table.shardCount()) {
+            std::fprintf(stderr, "worker: invalid shard %s", line);
+            return 1;
+        }
+        SweepResult *results = table.mapShard(shard);
+        if (!results) {
+            std::fprintf(stderr, "worker: cannot map shard %lld\n", shard);
+            return 1;
+        }
+        const qint64 begin = table.shardBegin(shard);
+        const qint64 length = table.shardLength(shard);
+        for (qint64 i = 0; i < length; ++i) {
+            results[i] = evaluateSweepPoint(spec, begin + i);
+        }
+        table.unmapShard(results);
+        std::printf("done %lld\n", shard);
+        std::fflush(stdout);
+    }
+    return 0;
+}
+
+// Готовые шарды в CSV
+static int dumpTable(const QString &fileName)
+{
+    SweepTable table;
+    QString error;
+    if (!table.open(fileName, error)) {
+        std::fprintf(stderr, "Cannot open %s: %s\n", qPrintable(fileName), qPrintable(error));
+        return 1;
+    }
+    const SweepSpec spec = table.spec();
+    std::printf("%s,%s,final_coordinate,final_velocity,period,energy_drift\n",
+                sweepAxisName(spec.model, 0), sweepAxisName(spec.model, 1));
+    for (qint64 shard = 0; shard < table.shardCount(); ++shard) {
+        if (table.shardState(shard) != SweepTable::ShardDone) {
+            continue;
+        }
+        SweepResult *results = table.mapShard(shard);
+        const qint64 begin = table.shardBegin(shard);
+        for (qint64 i = 0; i < table.shardLength(shard); ++i) {
+            double first, second;
+            spec.point(begin + i, first, second);
+            const SweepResult &result = results[i];
+            std::printf("%.10g,%.10g,%.10g,%.10g,%.10g,%.6e\n", first, second, result.finalCoordinate,
+                        result.finalVelocity, result.period, result.energyDrift);
+        }
+        table.unmapShard(results);
+    }
+    return 0;
+}
+
+// Ось в виде MIN:MAX:COUNT
+static bool parseAxis(const QString &text, SweepAxis &axis)
+{
+    const QStringList fields = text.split(':');
+    if (fields.size() != 3) {
+        return false;
+    }
+    bool okMin, okMax, okCount;
+    axis.minimum = fields[0].toDouble(&okMin);
+    axis.maximum = fields[1].toDouble(&okMax);
+    axis.count = fields[2].toLongLong(&okCount);
+    return okMin && okMax && okCount && axis.count > 0 &&
+           std::isfinite(axis.minimum) && std::isfinite(axis.maximum);
+}
+
+// Диапазоны осей, в которых модель определена: длина и жесткость пружины
+// положительны, угол не больше 90° по модулю. Точка вне них дала бы NaN
+// или бесконечность, которые молча попали бы в таблицу и в кэш.
+static bool checkAxes(const SweepSpec &spec)
+{
+    const SweepAxis &first = spec.axes[0];
+    const SweepAxis &second = spec.axes[1];
+    const double firstLow = std::min(first.minimum, first.maximum);
+    if (firstLow <= 0.0) {
+        std::fprintf(stderr, "%s must be positive\n", sweepAxisName(spec.model, 0));
+        return false;
+    }
+    if (spec.model == SweepModel::Math &&
+        std::max(std::fabs(second.minimum), std::fabs(second.maximum)) > 90.0) {
+        std::fprintf(stderr, "%s must lie within [-90, 90] degrees\n", sweepAxisName(spec.model, 1));
+        return false;
+    }
+    return true;
+}
+
+// Число узлов NUMA по /sys; 0, если узел один или сведений нет
+static int detectNumaNodes()
+{
+    QDir nodes("/sys/devices/system/node");
+    int count = nodes.entryList(QStringList{"node[0-9]*"}, QDir::Dirs).size();
+    return count > 1 ? count : 0;
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(
+        "Sharded multi-process parameter sweep of the math or spring pendulum.\n"
+        "New sweep: --model math|spring --first MIN:MAX:COUNT --second MIN:MAX:COUNT FILE\n"
+        "  math axes: length [m], angle [deg]; spring axes: spring constant [N/m], position [m]\n"
+        "Continue:  --resume FILE    Export: --dump FILE");
+    parser.addHelpOption();
+    parser.addPositionalArgument("file", "Sweep table file.");
+    QCommandLineOption modelOption("model", "Pendulum model: math or spring.", "model", "math");
+    QCommandLineOption firstOption("first", "First axis as MIN:MAX:COUNT.", "axis");
+    QCommandLineOption secondOption("second", "Second axis as MIN:MAX:COUNT.", "axis");
+    QCommandLineOption massOption("mass", "Mass [kg].", "kg", "1");
+    QCommandLineOption frictionOption("friction", "Linear air friction coefficient.", "coeff", "0");
+    QCommandLineOption durationOption("duration", "Simulated time per point [s].", "s", "60");
+    QCommandLineOption dtOption("dt", "Integration step [s].", "s", QString::number(SIMULATION_STEP));
+    QCommandLineOption shardOption("shard-size", "Points per shard.", "points", "65536");
+    QCommandLineOption jobsOption("jobs", "Worker processes.", "n", QString::number(QThread::idealThreadCount()));
+    QCommandLineOption numaOption("numa", "Pin workers to NUMA nodes round-robin with numactl.");
+    QCommandLineOption noCacheOption("no-cache", "Do not use the on-disk result cache.");
+    QCommandLineOption resumeOption("resume", "Continue an interrupted sweep.");
+    QCommandLineOption dumpOption("dump", "Print completed results as CSV.");
+    QCommandLineOption workerOption("worker", "Internal: run as a worker process.");
+    parser.addOptions({modelOption, firstOption, secondOption, massOption, frictionOption, durationOption,
+                       dtOption, shardOption, jobsOption, numaOption, noCacheOption, resumeOption, dumpOption, workerOption});
+    parser.process(app);
+
+    if (parser.positionalArguments().size() != 1) {
+        parser.showHelp(1);
+    }
+    const QString fileName = parser.positionalArguments().first();
+    if (parser.isSet(workerOption)) {
+        return runWorker(fileName);
+    }
+    if (parser.isSet(dumpOption)) {
+        return dumpTable(fileName);
+    }
+
+    SweepTable table;
+    QString error;
+    if (parser.isSet(resumeOption)) {
+        if (!table.open(fileName, error)) {
+            std::fprintf(stderr, "Cannot open %s: %s\n", qPrintable(fileName), qPrintable(error));
+            return 1;
+        }
+    } else {
+        if (QFile::exists(fileName)) {
+            std::fprintf(stderr, "%s already exists; use --resume to continue it\n", qPrintable(fileName));
+            return 1;
+        }
+        SweepSpec spec;
+        const QString model = parser.value(modelOption);
+        if (model == "math") spec.model = SweepModel::Math;
+        else if (model == "spring") spec.model = SweepModel::Spring;
+        else parser.showHelp(1);
+        if (!parseAxis(parser.value(firstOption), spec.axes[0]) ||
+            !parseAxis(parser.value(secondOption), spec.axes[1])) {
+            parser.showHelp(1);
+        }
+        spec.mass = parser.value(massOption).toDouble();
+        spec.airFrictionCoeff = parser.value(frictionOption).toDouble();
+        spec.duration = parser.value(durationOption).toDouble();
+        spec.dt = parser.value(dtOption).toDouble();
+        qint64 shardSize = parser.value(shardOption).toLongLong();
+        if (spec.mass <= 0 || spec.airFrictionCoeff < 0 || spec.duration <= 0 || spec.dt <= 0 || shardSize <= 0) {
+            parser.showHelp(1);
+        }
+        if (!checkAxes(spec)) {
+            return 1;
+        }
+        if (!table.create(fileName, spec, shardSize, error)) {
+            std::fprintf(stderr, "Cannot create %s: %s\n", qPrintable(fileName), qPrintable(error));
+            return 1;
+        }
+    }
+
+    const SweepSpec spec = table.spec();
+    std::printf("%s pendulum, %lld x %lld points, %lld shards\n", sweepModelName(spec.model),
+                spec.axes[0].count, spec.axes[1].count, table.shardCount());
+
+    SweepCoordinator coordinator(table, QFileInfo(fileName).absoluteFilePath());
+    coordinator.setJobs(parser.value(jobsOption).toInt());
+    coordinator.setCacheEnabled(!parser.isSet(noCacheOption));
+    if (parser.isSet(numaOption)) {
+        int nodes = detectNumaNodes();
+        if (QStandardPaths::findExecutable("numactl").isEmpty()) {
+            std::fprintf(stderr, "numactl not found, workers are not pinned\n");
+        } else if (nodes == 0) {
+            std::fprintf(stderr, "single NUMA node, workers are not pinned\n");
+        } else {
+            coordinator.setNumaNodes(nodes);
+        }
+    }
+
+    int status = 1;
+    QObject::connect(&coordinator, &SweepCoordinator::finished, &app, [&](bool success) {
+        status = success ? 0 : 1;
+        app.quit();
+    });
+    coordinator.start();
+    // Перебор, готовый до запуска, завершается сразу внутри start()
+    if (table.completedShards() < table.shardCount()) {
+        app.exec();
+    } else {
+        status = 0;
+    }
+    return status;
+}
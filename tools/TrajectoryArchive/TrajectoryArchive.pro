@@ -0,0 +1,16 @@
+TEMPLATE = app
+TARGET = TrajectoryArchive
+
+CONFIG += console c++17
+CONFIG -= app_bundle qt
+
+INCLUDEPATH += ../..
+
+SOURCES += \
+    ../../TrajectoryCodec.cpp \
+    main.cpp
+
+HEADERS += \
+    ../../DampingModels.h \
+    ../../PendulumPhysics.h \
+    ../../TrajectoryCodec.h
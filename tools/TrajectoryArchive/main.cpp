@@ -0,0 +1,416 @@
+// Архив траекторий: запись длинного прогона маятника в сжатый файл
+// (TrajectoryCodec.h), сведения о файле и выгрузка участка в CSV.
+// Выгрузка распаковывает только блоки, попадающие в заданный интервал.
+// --self-test проверяет кодек на значениях, во много раз больших допуска.
+
+#include "PendulumPhysics.h"
+#include "TrajectoryCodec.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <vector>
+
+enum class Mode { Record, Info, Decode, SelfTest };
+
+struct Options {
+    Mode mode = Mode::Record;
+    std::string file;
+    bool spring = false;
+    double duration = 600.0;
+    double rate = 1000.0;
+    double tolerance = 0.0;
+    long chunk = static_cast<long>(TrajectoryWriter::DEFAULT_CHUNK_SAMPLES);
+    double angle = 30.0;
+    double length = 10.0;
+    double position = 1.0;
+    double mass = 1.0;
+    double springConstant = 10.0;
+    bool friction = false;
+    double from = 0.0;
+    double to = -1.0;
+};
+
+// Коэффициенты линейного сопротивления, как в приложении
+const double MATH_FRICTION_COEFF = 0.02;
+const double SPRING_FRICTION_COEFF = 0.1;
+const int CHANNEL_COUNT = 4;
+
+// Каналы записи: координата, скорость, кинетическая и потенциальная энергия
+static std::vector<TrajectoryChannel> recordChannels(const Options &options)
+{
+    const char *coordinate = options.spring ? "position" : "angle";
+    const char *velocity = options.spring ? "velocity" : "angularVelocity";
+    return {
+        {coordinate, options.tolerance},
+        {velocity, options.tolerance},
+        {"kineticEnergy", options.tolerance},
+        {"potentialEnergy", options.tolerance},
+    };
+}
+
+// Прогон выбранного маятника; строки идут подряд по CHANNEL_COUNT значений
+template <typename Damping>
+static void simulateMath(const Options &options, const MathPendulumKernel<DoublePrecision, Damping> &kernel,
+                         long samples, std::vector<double> &rows)
+{
+    const double dt = 1.0 / options.rate;
+    const double degToRad = PhysicsConstants<double>::degToRad();
+    MathPendulumState<DoublePrecision> state;
+    state.angle = options.angle;
+    for (long i = 0; i < samples; ++i) {
+        double angle = state.angle;
+        double linearVelocity = state.angularVelocity * degToRad * kernel.length;
+        double row[CHANNEL_COUNT] = {
+            angle,
+            state.angularVelocity,
+            0.5 * kernel.mass * linearVelocity * linearVelocity,
+            kernel.mass * kernel.gravity * kernel.length * (1.0 - std::cos(angle * degToRad)),
+        };
+        rows.insert(rows.end(), row, row + CHANNEL_COUNT);
+        kernel.step(state, dt);
+    }
+}
+
+template <typename Damping>
+static void simulateSpring(const Options &options, const SpringPendulumKernel<DoublePrecision, Damping> &kernel,
+                           long samples, std::vector<double> &rows)
+{
+    const double dt = 1.0 / options.rate;
+    SpringPendulumState<DoublePrecision> state;
+    state.position = options.position;
+    for (long i = 0; i < samples; ++i) {
+        double position = state.position;
+        double row[CHANNEL_COUNT] = {
+            position,
+            state.velocity,
+            0.5 * kernel.mass * state.velocity * state.velocity,
+            0.5 * kernel.springConstant * position * position,
+        };
+        rows.insert(rows.end(), row, row + CHANNEL_COUNT);
+        kernel.step(state, dt);
+    }
+}
+
+static void simulate(const Options &options, long samples, std::vector<double> &rows)
+{
+    rows.reserve(static_cast<size_t>(samples) * CHANNEL_COUNT);
+    if (options.spring) {
+        using Friction = DampingModel<double, LinearDrag>;
+        SpringPendulumKernel<DoublePrecision, Friction> kernel;
+        kernel.mass = options.mass;
+        kernel.springConstant = options.springConstant;
+        kernel.damping.term<LinearDrag>().coeff = options.friction ? SPRING_FRICTION_COEFF : 0.0;
+        simulateSpring(options, kernel, samples, rows);
+    } else {
+        using Friction = DampingModel<double, LinearDrag>;
+        MathPendulumKernel<DoublePrecision, Friction> kernel;
+        kernel.length = options.length;
+        kernel.mass = options.mass;
+        kernel.damping.term<LinearDrag>().coeff = options.friction ? MATH_FRICTION_COEFF : 0.0;
+        simulateMath(options, kernel, samples, rows);
+    }
+}
+
+static double secondsSince(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Запись прогона, затем чтение файла и сверка с исходными значениями
+static int record(const Options &options)
+{
+    const long samples = std::lround(options.duration * options.rate) + 1;
+    const std::vector<TrajectoryChannel> channels = recordChannels(options);
+
+    std::vector<double> rows;
+    auto start = std::chrono::steady_clock::now();
+    simulate(options, samples, rows);
+    const double simulateSeconds = secondsSince(start);
+
+    TrajectoryWriter writer;
+    start = std::chrono::steady_clock::now();
+    if (!writer.open(options.file, channels, 1.0 / options.rate, 0.0, options.chunk)) {
+        std::printf("Cannot create %s\n", options.file.c_str());
+        return 1;
+    }
+    for (long i = 0; i < samples; ++i) {
+        writer.append(&rows[static_cast<size_t>(i) * CHANNEL_COUNT]);
+    }
+    if (!writer.close()) {
+        std::printf("Cannot write %s\n", options.file.c_str());
+        return 1;
+    }
+    const double encodeSeconds = secondsSince(start);
+
+    const double rawBytes = static_cast<double>(samples) * CHANNEL_COUNT * sizeof(double);
+    std::printf("Model: %s, samples: %ld (%g s at %g Hz), tolerance: %g\n",
+                options.spring ? "spring" : "math", samples, options.duration, options.rate,
+                options.tolerance);
+    std::printf("Size: %llu bytes, raw %.0f bytes, ratio %.2f, %.2f bits/value\n",
+                static_cast<unsigned long long>(writer.bytesWritten()), rawBytes,
+                rawBytes / writer.bytesWritten(), 8.0 * writer.bytesWritten() / (samples * CHANNEL_COUNT));
+    // В приложении отсчеты поступают со скоростью --rate в секунду реального
+    // времени; кодер должен с запасом успевать за ними
+    std::printf("Simulate: %.3e samples/s, encode: %.3e samples/s (%.0fx real time)\n",
+                samples / simulateSeconds, samples / encodeSeconds, samples / encodeSeconds / options.rate);
+
+    TrajectoryReader reader;
+    if (!reader.open(options.file) || reader.sampleCount() != static_cast<std::uint64_t>(samples)) {
+        std::printf("Verification failed: cannot read %s back\n", options.file.c_str());
+        return 1;
+    }
+    double maxError[CHANNEL_COUNT] = {};
+    std::vector<double> values;
+    start = std::chrono::steady_clock::now();
+    for (size_t chunk = 0; chunk < reader.chunkCount(); ++chunk) {
+        if (!reader.readChunk(chunk, values)) {
+            std::printf("Verification failed: chunk %zu is damaged\n", chunk);
+            return 1;
+        }
+        const double *expected = &rows[reader.chunkFirstSample(chunk) * CHANNEL_COUNT];
+        for (size_t i = 0; i < values.size(); ++i) {
+            double error = std::abs(values[i] - expected[i]);
+            maxError[i % CHANNEL_COUNT] = std::max(maxError[i % CHANNEL_COUNT], error);
+        }
+    }
+    const double decodeSeconds = secondsSince(start);
+    std::printf("Decode: %.3e samples/s, max error:", samples / decodeSeconds);
+    for (int c = 0; c < CHANNEL_COUNT; ++c) {
+        std::printf(" %s %.3e", channels[c].name.c_str(), maxError[c]);
+    }
+    std::printf("\n");
+
+    for (double error : maxError) {
+        if (error > options.tolerance) {
+            std::printf("Verification failed: error exceeds tolerance\n");
+            return 1;
+        }
+    }
+    return 0;
+}
+
+// Кодирование и чтение одного блока; false — блок не читается
+static bool roundTrip(const std::vector<double> &values, const std::vector<TrajectoryChannel> &channels,
+                      std::vector<double> &decoded, std::size_t &bytes)
+{
+    const std::size_t samples = values.size() / channels.size();
+    std::vector<std::uint8_t> encoded;
+    encodeTrajectoryChunk(values.data(), samples, channels, encoded);
+    bytes = encoded.size();
+    return decodeTrajectoryChunk(encoded.data(), encoded.size(), samples, channels, decoded);
+}
+
+// Проверка границы ошибки. Каналы: синусоида с амплитудой 2^k допусков,
+// малая синусоида поверх смещения 2^k допусков и значения точно в
+// серединах шагов квантования. При больших k кодек обязан перейти на
+// запись без потерь, а не потерять точность. Отдельный блок с NaN,
+// бесконечностями и крайними значениями должен читаться без изменений.
+static int selfTest()
+{
+    const std::size_t samples = 1000;
+    const double tolerance = 1e-3;
+    const double step = 2.0 * tolerance;
+    const std::vector<TrajectoryChannel> channels = {
+        {"sine", tolerance}, {"offset", tolerance}, {"midpoints", tolerance}};
+    const int exponents[] = {0, 16, 32, 40, 46, 48, 49, 50, 51, 52, 53, 54, 56, 60, 62, 63, 64, 70, 100, 1000};
+
+    bool passed = true;
+    std::vector<double> values, decoded;
+    for (int exponent : exponents) {
+        const double scale = std::ldexp(tolerance, exponent);
+        values.clear();
+        for (std::size_t i = 0; i < samples; ++i) {
+            values.push_back(scale * std::sin(0.01 * i));
+            values.push_back(scale + 100.0 * tolerance * std::sin(0.01 * i));
+            values.push_back((std::floor(scale / step) + i + 0.5) * step);
+        }
+        std::size_t bytes = 0;
+        if (!roundTrip(values, channels, decoded, bytes)) {
+            std::printf("Ratio 2^%d: chunk cannot be read back\n", exponent);
+            passed = false;
+            continue;
+        }
+        double maxError = 0.0;
+        for (std::size_t i = 0; i < values.size(); ++i) {
+            maxError = std::max(maxError, std::abs(decoded[i] - values[i]));
+        }
+        std::printf("Ratio 2^%d: %.2f bits/value, max error %.3f of tolerance\n",
+                    exponent, 8.0 * bytes / values.size(), maxError / tolerance);
+        if (!(maxError <= tolerance)) {
+            passed = false;
+        }
+    }
+
+    const double special[] = {
+        std::numeric_limits<double>::quiet_NaN(), std::numeric_limits<double>::infinity(),
+        -std::numeric_limits<double>::infinity(), std::numeric_limits<double>::max(),
+        std::numeric_limits<double>::denorm_min(), -0.0, 1.0, 0.0,
+    };
+    const std::vector<TrajectoryChannel> specialChannel = {{"special", tolerance}};
+    values.assign(std::begin(special), std::end(special));
+    std::size_t bytes = 0;
+    bool specialPassed = roundTrip(values, specialChannel, decoded, bytes);
+    for (std::size_t i = 0; specialPassed && i < values.size(); ++i) {
+        specialPassed = std::memcmp(&values[i], &decoded[i], sizeof(double)) == 0;
+    }
+    std::printf("Non-finite and extreme values: %s\n", specialPassed ? "exact" : "changed");
+
+    passed = passed && specialPassed;
+    std::printf("Self-test %s\n", passed ? "passed" : "FAILED");
+    return passed ? 0 : 1;
+}
+
+static int info(const Options &options)
+{
+    TrajectoryReader reader;
+    if (!reader.open(options.file)) {
+        std::printf("Cannot read %s\n", options.file.c_str());
+        return 1;
+    }
+    std::printf("Samples: %llu, interval: %g s, start: %g s, chunks: %zu\n",
+                static_cast<unsigned long long>(reader.sampleCount()), reader.sampleInterval(),
+                reader.startTime(), reader.chunkCount());
+    for (const TrajectoryChannel &channel : reader.channels()) {
+        std::printf("  %-16s tolerance %g\n", channel.name.c_str(), channel.tolerance);
+    }
+    return 0;
+}
+
+// Выгрузка интервала [from, to] в CSV
+static int decode(const Options &options)
+{
+    TrajectoryReader reader;
+    if (!reader.open(options.file)) {
+        std::printf("Cannot read %s\n", options.file.c_str());
+        return 1;
+    }
+    const std::uint64_t total = reader.sampleCount();
+    if (total == 0) {
+        return 0;
+    }
+    // Номера первого и последнего отсчета внутри интервала
+    const double interval = reader.sampleInterval();
+    const double lastIndex = static_cast<double>(total - 1);
+    const double fromIndex = std::ceil((options.from - reader.startTime()) / interval - 1e-9);
+    const double toIndex = options.to < 0 ? lastIndex
+                                          : std::floor((options.to - reader.startTime()) / interval + 1e-9);
+    if (fromIndex > lastIndex || toIndex < 0 || toIndex < fromIndex) {
+        return 0;
+    }
+    const std::uint64_t first = static_cast<std::uint64_t>(std::max(fromIndex, 0.0));
+    const std::uint64_t last = static_cast<std::uint64_t>(std::min(toIndex, lastIndex));
+
+    const std::vector<TrajectoryChannel> &channels = reader.channels();
+    std::printf("t");
+    for (const TrajectoryChannel &channel : channels) {
+        std::printf(",%s", channel.name.c_str());
+    }
+    std::printf("\n");
+
+    std::vector<double> values;
+    for (size_t chunk = reader.chunkForSample(first); chunk < reader.chunkCount(); ++chunk) {
+        const std::uint64_t chunkFirst = reader.chunkFirstSample(chunk);
+        if (chunkFirst > last) {
+            break;
+        }
+        if (!reader.readChunk(chunk, values)) {
+            std::printf("Chunk %zu is damaged\n", chunk);
+            return 1;
+        }
+        for (size_t i = 0; i < reader.chunkSamples(chunk); ++i) {
+            const std::uint64_t sample = chunkFirst + i;
+            if (sample < first || sample > last) {
+                continue;
+            }
+            std::printf("%.6f", reader.startTime() + sample * interval);
+            for (size_t c = 0; c < channels.size(); ++c) {
+                std::printf(",%.17g", values[i * channels.size() + c]);
+            }
+            std::printf("\n");
+        }
+    }
+    return 0;
+}
+
+static void printUsage(const char *program)
+{
+    std::printf("Usage: %s --record FILE [--model math|spring] [--duration S] [--rate HZ]\n"
+                "          [--tolerance T] [--chunk N] [--angle DEG] [--length M] [--position M]\n"
+                "          [--mass KG] [--spring N/M] [--friction]\n"
+                "       %s --info FILE\n"
+                "       %s --decode FILE [--from S] [--to S]\n"
+                "       %s --self-test\n",
+                program, program, program, program);
+}
+
+static bool parseOptions(int argc, char *argv[], Options &options)
+{
+    for (int i = 1; i < argc; ++i) {
+        const char *arg = argv[i];
+        const char *value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+
+        if (std::strcmp(arg, "--friction") == 0) {
+            options.friction = true;
+            continue;
+        }
+        if (std::strcmp(arg, "--self-test") == 0) {
+            options.mode = Mode::SelfTest;
+            continue;
+        }
+        if (!value) {
+            return false;
+        }
+
+        if (std::strcmp(arg, "--record") == 0) { options.mode = Mode::Record; options.file = value; }
+        else if (std::strcmp(arg, "--info") == 0) { options.mode = Mode::Info; options.file = value; }
+        else if (std::strcmp(arg, "--decode") == 0) { options.mode = Mode::Decode; options.file = value; }
+        else if (std::strcmp(arg, "--model") == 0) {
+            if (std::strcmp(value, "spring") == 0) options.spring = true;
+            else if (std::strcmp(value, "math") == 0) options.spring = false;
+            else return false;
+        }
+        else if (std::strcmp(arg, "--duration") == 0) options.duration = std::atof(value);
+        else if (std::strcmp(arg, "--rate") == 0) options.rate = std::atof(value);
+        else if (std::strcmp(arg, "--tolerance") == 0) options.tolerance = std::atof(value);
+        else if (std::strcmp(arg, "--chunk") == 0) options.chunk = std::atol(value);
+        else if (std::strcmp(arg, "--angle") == 0) options.angle = std::atof(value);
+        else if (std::strcmp(arg, "--length") == 0) options.length = std::atof(value);
+        else if (std::strcmp(arg, "--position") == 0) options.position = std::atof(value);
+        else if (std::strcmp(arg, "--mass") == 0) options.mass = std::atof(value);
+        else if (std::strcmp(arg, "--spring") == 0) options.springConstant = std::atof(value);
+        else if (std::strcmp(arg, "--from") == 0) options.from = std::atof(value);
+        else if (std::strcmp(arg, "--to") == 0) options.to = std::atof(value);
+        else return false;
+        ++i;
+    }
+    return (options.mode == Mode::SelfTest || !options.file.empty()) && options.duration >= 0 && options.rate > 0 &&
+           options.tolerance >= 0 && options.chunk > 0 && options.length > 0 &&
+           options.mass > 0 && options.springConstant > 0;
+}
+
+int main(int argc, char *argv[])
+{
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    switch (options.mode) {
+    case Mode::Info:
+        return info(options);
+    case Mode::Decode:
+        return decode(options);
+    case Mode::SelfTest:
+        return selfTest();
+    case Mode::Record:
+        break;
+    }
+    return record(options);
+}